@@ -0,0 +1,70 @@
+/**
+ * \file chainfksolverpos_batch_benchmark.cpp
+ * Compares the batch forward position kinematics solver against calling
+ * ChainFkSolverPos_recursive once per configuration, for a 7 dof arm.
+ *
+ * Usage: chainfksolverpos_batch_benchmark [nr_of_configurations] [repetitions]
+ */
+
+#include <chain.hpp>
+#include <chainfksolverpos_recursive.hpp>
+#include <chainfksolverpos_batch.hpp>
+#include <frames_io.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int nr_of_configs = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const unsigned int repetitions = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    // Kuka LWR like arm
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.31))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.2))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.2))));
+    chain.addSegment(Segment(Joint(Joint::RotY, -1.0), Frame(Vector(0.0, 0.0, 0.2))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.19))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.078))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.0))));
+    chain.addSegment(Segment(Joint(Joint::None), Frame(Rotation::RotZ(PI_2), Vector(0.0, 0.0, 0.1))));
+    const unsigned int nj = chain.getNrOfJoints();
+
+    Eigen::MatrixXd q_soa = Eigen::MatrixXd::Random(nr_of_configs, nj) * PI;
+    std::vector<JntArray> q_aos(nr_of_configs, JntArray(nj));
+    for (unsigned int k = 0; k < nr_of_configs; ++k)
+        q_aos[k].data = q_soa.row(k).transpose();
+
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainFkSolverPos_batch fksolver_batch(chain);
+    std::vector<Frame> f_scalar(nr_of_configs), f_batch;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+        for (unsigned int k = 0; k < nr_of_configs; ++k)
+            fksolver.JntToCart(q_aos[k], f_scalar[k]);
+    const double t_scalar = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+        fksolver_batch.JntToCart(q_soa, f_batch);
+    const double t_batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double max_err = 0.0;
+    for (unsigned int k = 0; k < nr_of_configs; ++k) {
+        const Twist d = diff(f_scalar[k], f_batch[k]);
+        max_err = std::max(max_err, std::max(d.vel.Norm(), d.rot.Norm()));
+    }
+
+    const double evaluations = double(nr_of_configs) * repetitions;
+    std::cout << "configurations       : " << nr_of_configs << " x " << repetitions << std::endl;
+    std::cout << "recursive (ns/config): " << 1e9 * t_scalar / evaluations << std::endl;
+    std::cout << "batch     (ns/config): " << 1e9 * t_batch / evaluations << std::endl;
+    std::cout << "speedup              : " << t_scalar / t_batch << std::endl;
+    std::cout << "max difference       : " << max_err << std::endl;
+    return 0;
+}
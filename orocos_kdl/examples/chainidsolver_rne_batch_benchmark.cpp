@@ -0,0 +1,83 @@
+/**
+ * \file chainidsolver_rne_batch_benchmark.cpp
+ * Inverse dynamics along a trajectory with the batch RNE solver for an
+ * increasing number of threads, against calling ChainIdSolver_RNE once
+ * per sample, for a 7 dof arm.
+ *
+ * Usage: chainidsolver_rne_batch_benchmark [nr_of_samples] [repetitions] [max_nr_of_threads]
+ */
+
+#include <chain.hpp>
+#include <chainidsolver_recursive_newton_euler.hpp>
+#include <chainidsolver_recursive_newton_euler_batch.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int nr_of_samples = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const unsigned int repetitions = argc > 2 ? std::atoi(argv[2]) : 20;
+    const unsigned int max_threads = argc > 3 ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    // Kuka LWR like arm
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.31)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.03, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.03, 0.08), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.03, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY, -1.0), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.03, 0.08), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.19)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.02, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.078)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.0, 0.0), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.0)),
+                             RigidBodyInertia(0.5, Vector(0.0, 0.0, 0.02), RotationalInertia(0.001, 0.001, 0.001))));
+    const unsigned int nj = chain.getNrOfJoints();
+    const Vector gravity(0.0, 0.0, -9.81);
+
+    Eigen::MatrixXd q = Eigen::MatrixXd::Random(nr_of_samples, nj) * PI;
+    Eigen::MatrixXd qd = Eigen::MatrixXd::Random(nr_of_samples, nj);
+    Eigen::MatrixXd qdd = Eigen::MatrixXd::Random(nr_of_samples, nj);
+
+    ChainIdSolver_RNE idsolver(chain, gravity);
+    JntArray q_k(nj), qd_k(nj), qdd_k(nj), tau_k(nj);
+    Wrenches f_ext(chain.getNrOfSegments(), Wrench::Zero());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+        for (unsigned int k = 0; k < nr_of_samples; ++k) {
+            q_k.data = q.row(k).transpose();
+            qd_k.data = qd.row(k).transpose();
+            qdd_k.data = qdd.row(k).transpose();
+            idsolver.CartToJnt(q_k, qd_k, qdd_k, f_ext, tau_k);
+        }
+    const double t_serial = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double evaluations = double(nr_of_samples) * repetitions;
+    std::cout << "samples              : " << nr_of_samples << " x " << repetitions << std::endl;
+    std::cout << "serial   (ns/sample) : " << 1e9 * t_serial / evaluations << std::endl;
+
+    Eigen::MatrixXd tau;
+    Eigen::VectorXd peak, rms;
+    for (unsigned int n = 1; n <= max_threads; n *= 2) {
+        ChainIdSolver_RNE_batch batchsolver(chain, gravity, n);
+        start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            batchsolver.CartToJnt(q, qd, qdd, tau);
+        const double t_batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << n << " thread(s) (ns/sample): " << 1e9 * t_batch / evaluations
+                  << ", speedup " << t_serial / t_batch << std::endl;
+        peak = batchsolver.getPeakTorques();
+        rms = batchsolver.getRmsTorques();
+    }
+    std::cout << "peak torques         : " << peak.transpose() << std::endl;
+    std::cout << "rms torques          : " << rms.transpose() << std::endl;
+    return 0;
+}
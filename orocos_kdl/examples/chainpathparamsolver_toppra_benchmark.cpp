@@ -0,0 +1,77 @@
+/**
+ * \file chainpathparamsolver_toppra_benchmark.cpp
+ * Time-optimal parameterization of a straight line path with TOPP-RA
+ * for a 7 dof arm with joint velocity, acceleration and torque limits,
+ * for an increasing number of grid points.
+ *
+ * Usage: chainpathparamsolver_toppra_benchmark [repetitions]
+ */
+
+#include <chain.hpp>
+#include <chainfksolverpos_recursive.hpp>
+#include <chainpathparamsolver_toppra.hpp>
+#include <path_line.hpp>
+#include <rotational_interpolation_sa.hpp>
+#include <velocityprofile_grid.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int repetitions = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    // Kuka LWR like arm
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.31)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.03, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.03, 0.08), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.03, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY, -1.0), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.03, 0.08), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.19)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.02, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.078)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.0, 0.0), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.0)),
+                             RigidBodyInertia(0.5, Vector(0.0, 0.0, 0.02), RotationalInertia(0.001, 0.001, 0.001))));
+    const unsigned int nj = chain.getNrOfJoints();
+    const Vector gravity(0.0, 0.0, -9.81);
+
+    JntArray q_init(nj), q_dot_max(nj), q_dotdot_max(nj), torque_max(nj);
+    for (unsigned int j = 0; j < nj; ++j) {
+        q_init(j) = 0.3 + 0.1 * j;
+        q_dot_max(j) = 1.5;
+        q_dotdot_max(j) = 5.0;
+        torque_max(j) = j < 4 ? 80.0 : 20.0;
+    }
+    q_init(3) = -1.2;
+
+    Frame start_frame;
+    ChainFkSolverPos_recursive fksolver(chain);
+    fksolver.JntToCart(q_init, start_frame);
+    const Frame end_frame(start_frame.M * Rotation::RPY(0.3, -0.2, 0.4), start_frame.p + Vector(0.1, -0.2, -0.15));
+    Path_Line path(start_frame, end_frame, new RotationalInterpolation_SingleAxis(), 0.1);
+
+    VelocityProfile_Grid profile;
+    for (unsigned int n = 125; n <= 4000; n *= 2) {
+        ChainPathParamSolver_TOPPRA solver(chain, q_dot_max, q_dotdot_max, torque_max, gravity, n);
+        int ret = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            ret = solver.Solve(path, q_init, profile);
+        const double t_solve = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (ret < 0) {
+            std::cout << n << " grid points: " << solver.strError(ret) << std::endl;
+            return 1;
+        }
+        std::cout << n << " grid points (ms/solve): " << 1e3 * t_solve / repetitions
+                  << ", duration " << profile.Duration() << " s" << std::endl;
+    }
+    return 0;
+}
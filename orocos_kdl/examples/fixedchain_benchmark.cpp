@@ -0,0 +1,134 @@
+/**
+ * \file fixedchain_benchmark.cpp
+ * Forward kinematics, jacobian, inverse dynamics and joint space inertia
+ * matrix of a 7 dof arm with the FixedChain<7> solvers, against the
+ * ChainFkSolverPos_recursive, ChainJntToJacSolver, ChainIdSolver_RNE and
+ * ChainDynParam solvers on the same chain.
+ *
+ * Usage: fixedchain_benchmark [nr_of_samples] [repetitions]
+ */
+
+#include <chain.hpp>
+#include <chaindynparam.hpp>
+#include <chainfksolverpos_recursive.hpp>
+#include <chainidsolver_recursive_newton_euler.hpp>
+#include <chainjnttojacsolver.hpp>
+#include <fixedchaindynparam.hpp>
+#include <fixedchainfksolverpos.hpp>
+#include <fixedchainjnttojacsolver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int nr_of_samples = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const unsigned int repetitions = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    // Kuka LWR like arm, with a fixed flange at the tip
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.31)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.03, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.03, 0.08), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.03, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY, -1.0), Frame(Vector(0.0, 0.0, 0.2)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.03, 0.08), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.19)),
+                             RigidBodyInertia(2.0, Vector(0.0, -0.02, 0.12), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.078)),
+                             RigidBodyInertia(2.0, Vector(0.0, 0.0, 0.0), RotationalInertia(0.01, 0.01, 0.01))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.0)),
+                             RigidBodyInertia(0.5, Vector(0.0, 0.0, 0.02), RotationalInertia(0.001, 0.001, 0.001))));
+    chain.addSegment(Segment(Joint(Joint::Fixed), Frame(Vector(0.0, 0.0, 0.05)),
+                             RigidBodyInertia(0.2, Vector(0.0, 0.0, 0.02), RotationalInertia(0.001, 0.001, 0.001))));
+    const unsigned int N = 7;
+    const Vector gravity(0.0, 0.0, -9.81);
+    FixedChain<N> fixedchain(chain);
+
+    Eigen::MatrixXd q = Eigen::MatrixXd::Random(N, nr_of_samples) * PI;
+    Eigen::MatrixXd qd = Eigen::MatrixXd::Random(N, nr_of_samples);
+    Eigen::MatrixXd qdd = Eigen::MatrixXd::Random(N, nr_of_samples);
+    const double evaluations = double(nr_of_samples) * repetitions;
+    // accumulated results, so that no call can be optimized away
+    double checksum = 0.0;
+
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainJntToJacSolver jacsolver(chain);
+    ChainIdSolver_RNE idsolver(chain, gravity);
+    ChainDynParam dynparam(chain, gravity);
+    JntArray q_k(N), qd_k(N), qdd_k(N), tau_k(N);
+    Wrenches f_ext(chain.getNrOfSegments(), Wrench::Zero());
+    Frame F;
+    Jacobian jac(N);
+    JntSpaceInertiaMatrix H(N);
+    double t_dynamic[4];
+
+    FixedChainFkSolverPos<N> fixedfksolver(fixedchain);
+    FixedChainJntToJacSolver<N> fixedjacsolver(fixedchain);
+    FixedChainIdSolver_RNE<N> fixedidsolver(fixedchain, gravity);
+    FixedChainDynParam<N> fixeddynparam(fixedchain, gravity);
+    FixedChain<N>::JntVector q_f, qd_f, qdd_f, tau_f;
+    FixedChain<N>::JacobianMatrix jac_f;
+    FixedChain<N>::InertiaMatrix H_f;
+    double t_fixed[4];
+
+    for (unsigned int s = 0; s < 4; ++s) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            for (unsigned int k = 0; k < nr_of_samples; ++k) {
+                q_k.data = q.col(k);
+                if (s == 0) {
+                    fksolver.JntToCart(q_k, F);
+                    checksum += F.p.x();
+                } else if (s == 1) {
+                    jacsolver.JntToJac(q_k, jac);
+                    checksum += jac(0, 0);
+                } else if (s == 2) {
+                    qd_k.data = qd.col(k);
+                    qdd_k.data = qdd.col(k);
+                    idsolver.CartToJnt(q_k, qd_k, qdd_k, f_ext, tau_k);
+                    checksum += tau_k(0);
+                } else {
+                    dynparam.JntToMass(q_k, H);
+                    checksum += H(0, 0);
+                }
+            }
+        t_dynamic[s] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            for (unsigned int k = 0; k < nr_of_samples; ++k) {
+                q_f = q.col(k);
+                if (s == 0) {
+                    fixedfksolver.JntToCart(q_f, F);
+                    checksum += F.p.x();
+                } else if (s == 1) {
+                    fixedjacsolver.JntToJac(q_f, jac_f);
+                    checksum += jac_f(0, 0);
+                } else if (s == 2) {
+                    qd_f = qd.col(k);
+                    qdd_f = qdd.col(k);
+                    fixedidsolver.CartToJnt(q_f, qd_f, qdd_f, tau_f);
+                    checksum += tau_f(0);
+                } else {
+                    fixeddynparam.JntToMass(q_f, H_f);
+                    checksum += H_f(0, 0);
+                }
+            }
+        t_fixed[s] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const char* names[4] = {"JntToCart", "JntToJac ", "RNE      ", "JntToMass"};
+    std::cout << "samples                : " << nr_of_samples << " x " << repetitions << std::endl;
+    std::cout << "          (ns/call)      Chain   FixedChain<7>" << std::endl;
+    for (unsigned int s = 0; s < 4; ++s)
+        std::cout << names[s] << "              : " << 1e9 * t_dynamic[s] / evaluations << "   "
+                  << 1e9 * t_fixed[s] / evaluations << ", speedup " << t_dynamic[s] / t_fixed[s] << std::endl;
+    std::cout << "checksum               : " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * \file svd_jacobi_6xN_benchmark.cpp
+ * Compares the three SVD backends of the velocity IK solvers on the
+ * jacobians of a 7 dof arm: the legacy SVD_HH, svd_eigen_HH and the
+ * SVD_Jacobi_6xN kernel, and the pseudo inverse solvers using them.
+ * The warm started kernel is compared on a smooth 1 kHz trajectory.
+ *
+ * Usage: svd_jacobi_6xN_benchmark [nr_of_configurations] [repetitions]
+ */
+
+#include <chain.hpp>
+#include <chainjnttojacsolver.hpp>
+#include <chainiksolvervel_pinv.hpp>
+#include <chainiksolvervel_wdls.hpp>
+#include <utilities/svd_HH.hpp>
+#include <utilities/svd_eigen_HH.hpp>
+#include <utilities/svd_jacobi_6xN.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int nr_of_configs = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const unsigned int repetitions = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    // Kuka LWR like arm
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.31))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.2))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.2))));
+    chain.addSegment(Segment(Joint(Joint::RotY, -1.0), Frame(Vector(0.0, 0.0, 0.2))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.19))));
+    chain.addSegment(Segment(Joint(Joint::RotY), Frame(Vector(0.0, 0.0, 0.078))));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.0))));
+    chain.addSegment(Segment(Joint(Joint::None), Frame(Rotation::RotZ(PI_2), Vector(0.0, 0.0, 0.1))));
+    const unsigned int nj = chain.getNrOfJoints();
+
+    ChainJntToJacSolver jacsolver(chain);
+    std::vector<JntArray> q(nr_of_configs, JntArray(nj));
+    std::vector<Jacobian> jac(nr_of_configs, Jacobian(nj));
+    for (unsigned int k = 0; k < nr_of_configs; ++k) {
+        q[k].data = Eigen::VectorXd::Random(nj) * PI;
+        jacsolver.JntToJac(q[k], jac[k]);
+    }
+    const double evaluations = double(nr_of_configs) * repetitions;
+    std::chrono::steady_clock::time_point start;
+
+    // decompositions only
+    SVD_HH svd_hh(jac[0]);
+    std::vector<JntArray> U_hh(6, JntArray(nj)), V_hh(nj, JntArray(nj));
+    JntArray S_hh(nj);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+        for (unsigned int k = 0; k < nr_of_configs; ++k)
+            svd_hh.calculate(jac[k], U_hh, S_hh, V_hh, 150);
+    const double t_hh = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Eigen::MatrixXd U(6, nj), V(nj, nj);
+    Eigen::VectorXd S(nj), tmp(nj);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+        for (unsigned int k = 0; k < nr_of_configs; ++k)
+            svd_eigen_HH(jac[k].data, U, S, V, tmp, 150);
+    const double t_eigen_hh = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SVD_Jacobi_6xN svd_jacobi(nj);
+    Eigen::MatrixXd U_j(6, nj), V_j(nj, nj);
+    Eigen::VectorXd S_j(nj);
+    double max_err = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; ++r)
+        for (unsigned int k = 0; k < nr_of_configs; ++k)
+            svd_jacobi.calculate(jac[k].data, U_j, S_j, V_j, 150);
+    const double t_jacobi = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (unsigned int k = 0; k < nr_of_configs; ++k) {
+        svd_eigen_HH(jac[k].data, U, S, V, tmp, 150);
+        svd_jacobi.calculate(jac[k].data, U_j, S_j, V_j, 150);
+        max_err = std::max(max_err, (S - S_j).cwiseAbs().maxCoeff());
+    }
+
+    // complete velocity IK solvers
+    Twist v(Vector(0.1, -0.2, 0.05), Vector(0.3, 0.1, -0.2));
+    JntArray qdot(nj);
+    double t_solvers[4];
+    for (unsigned int s = 0; s < 4; ++s) {
+        ChainIkSolverVel_pinv pinv(chain);
+        ChainIkSolverVel_wdls wdls(chain);
+        pinv.setSVDMethod(s % 2 ? SVD_JACOBI_6XN : SVD_HOUSEHOLDER);
+        wdls.setSVDMethod(s % 2 ? SVD_JACOBI_6XN : SVD_HOUSEHOLDER);
+        ChainIkSolverVel& solver = s < 2 ? static_cast<ChainIkSolverVel&>(pinv) : wdls;
+        start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            for (unsigned int k = 0; k < nr_of_configs; ++k)
+                solver.CartToJnt(q[k], v, qdot);
+        t_solvers[s] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // warm start along a trajectory sampled at 1 kHz
+    std::vector<Jacobian> jac_traj(nr_of_configs, Jacobian(nj));
+    std::vector<JntArray> q_traj(nr_of_configs, JntArray(nj));
+    for (unsigned int k = 0; k < nr_of_configs; ++k) {
+        for (unsigned int j = 0; j < nj; ++j)
+            q_traj[k](j) = 0.3 * j - 0.8 + 0.5 * sin(1e-3 * k * (j + 1));
+        jacsolver.JntToJac(q_traj[k], jac_traj[k]);
+    }
+    double t_traj[2];
+    int sweeps[2] = {0, 0};
+    for (unsigned int w = 0; w < 2; ++w) {
+        SVD_Jacobi_6xN svd_traj(nj);
+        svd_traj.setWarmStart(w == 1);
+        start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            for (unsigned int k = 0; k < nr_of_configs; ++k) {
+                svd_traj.calculate(jac_traj[k].data, U_j, S_j, V_j, 150);
+                sweeps[w] += svd_traj.getNrOfSweeps();
+            }
+        t_traj[w] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    double t_traj_wdls[2];
+    for (unsigned int w = 0; w < 2; ++w) {
+        ChainIkSolverVel_wdls wdls(chain);
+        wdls.setSVDMethod(w == 1 ? SVD_JACOBI_6XN_WARM : SVD_JACOBI_6XN);
+        start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r)
+            for (unsigned int k = 0; k < nr_of_configs; ++k)
+                wdls.CartToJnt(q_traj[k], v, qdot);
+        t_traj_wdls[w] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::cout << "configurations              : " << nr_of_configs << " x " << repetitions << std::endl;
+    std::cout << "SVD_HH            (ns/svd)  : " << 1e9 * t_hh / evaluations << std::endl;
+    std::cout << "svd_eigen_HH      (ns/svd)  : " << 1e9 * t_eigen_hh / evaluations << std::endl;
+    std::cout << "SVD_Jacobi_6xN    (ns/svd)  : " << 1e9 * t_jacobi / evaluations << std::endl;
+    std::cout << "max singular value diff     : " << max_err << std::endl;
+    std::cout << "pinv householder  (ns/call) : " << 1e9 * t_solvers[0] / evaluations << std::endl;
+    std::cout << "pinv jacobi 6xN   (ns/call) : " << 1e9 * t_solvers[1] / evaluations << std::endl;
+    std::cout << "wdls householder  (ns/call) : " << 1e9 * t_solvers[2] / evaluations << std::endl;
+    std::cout << "wdls jacobi 6xN   (ns/call) : " << 1e9 * t_solvers[3] / evaluations << std::endl;
+    std::cout << "trajectory, cold  (ns/svd)  : " << 1e9 * t_traj[0] / evaluations
+              << " (" << sweeps[0] / evaluations << " sweeps)" << std::endl;
+    std::cout << "trajectory, warm  (ns/svd)  : " << 1e9 * t_traj[1] / evaluations
+              << " (" << sweeps[1] / evaluations << " sweeps)" << std::endl;
+    std::cout << "trajectory, wdls cold (ns)  : " << 1e9 * t_traj_wdls[0] / evaluations << std::endl;
+    std::cout << "trajectory, wdls warm (ns)  : " << 1e9 * t_traj_wdls[1] / evaluations << std::endl;
+    return 0;
+}
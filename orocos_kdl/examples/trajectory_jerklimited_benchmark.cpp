@@ -0,0 +1,48 @@
+/**
+ * \file trajectory_jerklimited_benchmark.cpp
+ * Replanning cost of the online jerk-limited generators: a single axis
+ * VelocityProfile_JerkLimited from a moving state, and a
+ * Trajectory_JerkLimited following a target that moves every cycle.
+ *
+ * Usage: trajectory_jerklimited_benchmark [nr_of_cycles]
+ */
+
+#include <trajectory_jerklimited.hpp>
+#include <velocityprofile_jerklimited.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int nr_of_cycles = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const double period = 0.001;
+
+    VelocityProfile_JerkLimited profile(1.0, 2.0, 10.0);
+    double checksum = 0.0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int k = 0; k < nr_of_cycles; ++k) {
+        const double pos = profile.Pos(period), vel = profile.Vel(period), acc = profile.Acc(period);
+        profile.SetProfile(pos, vel, acc, std::sin(k * period));
+        checksum += profile.Duration();
+    }
+    const double t_profile = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "profile    (us/replan): " << 1e6 * t_profile / nr_of_cycles << std::endl;
+
+    Trajectory_JerkLimited traj(Frame::Identity(), 0.5, 1.0, 10.0, 1.0, 2.0, 20.0);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int k = 0; k < nr_of_cycles; ++k) {
+        const double t = k * period;
+        traj.Replan(period, Frame(Rotation::RPY(0.3 * std::sin(t), 0.2, 0.5 * std::cos(t)),
+                                  Vector(0.5 + 0.1 * std::sin(t), 0.1 * std::cos(t), 0.4)));
+        checksum += traj.Duration();
+    }
+    const double t_traj = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "trajectory (us/replan): " << 1e6 * t_traj / nr_of_cycles << std::endl;
+    std::cout << "checksum              : " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file velocityprofile_batch_benchmark.cpp
+ * Sampling velocity profiles at many times with one Evaluate() call,
+ * against one virtual Pos(), Vel() and Acc() call per sample.
+ *
+ * Usage: velocityprofile_batch_benchmark [nr_of_samples] [repetitions]
+ */
+
+#include <velocityprofile_spline.hpp>
+#include <velocityprofile_trap.hpp>
+#include <velocityprofile_traphalf.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace KDL;
+
+int main(int argc, char** argv)
+{
+    const unsigned int nr_of_samples = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const unsigned int repetitions = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    VelocityProfile_Trap trap(2.0, 1.0);
+    trap.SetProfile(0.0, 10.0);
+    VelocityProfile_TrapHalf traphalf(2.0, 1.0, true);
+    traphalf.SetProfile(0.0, 10.0);
+    VelocityProfile_Spline spline;
+    spline.SetProfileDuration(0.0, 0.0, 0.0, 10.0, 0.0, 0.0, trap.Duration());
+    const VelocityProfile* profiles[] = {&trap, &traphalf, &spline};
+    const char* names[] = {"trap    ", "traphalf", "spline  "};
+
+    std::vector<double> time(nr_of_samples), pos(nr_of_samples), vel(nr_of_samples), acc(nr_of_samples);
+    for (unsigned int i = 0; i < nr_of_samples; ++i)
+        time[i] = trap.Duration() * i / (nr_of_samples - 1);
+
+    double checksum = 0.0;
+    for (unsigned int k = 0; k < 3; ++k) {
+        const VelocityProfile& profile = *profiles[k];
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r) {
+            for (unsigned int i = 0; i < nr_of_samples; ++i) {
+                pos[i] = profile.Pos(time[i]);
+                vel[i] = profile.Vel(time[i]);
+                acc[i] = profile.Acc(time[i]);
+            }
+            checksum += pos[r % nr_of_samples];
+        }
+        const double t_scalar = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (unsigned int r = 0; r < repetitions; ++r) {
+            profile.Evaluate(&time[0], nr_of_samples, &pos[0], &vel[0], &acc[0]);
+            checksum += pos[r % nr_of_samples];
+        }
+        const double t_batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double evaluations = double(nr_of_samples) * repetitions;
+        std::cout << names[k] << " (ns/sample): per sample " << 1e9 * t_scalar / evaluations
+                  << ", batch " << 1e9 * t_batch / evaluations
+                  << ", speedup " << t_scalar / t_batch << std::endl;
+    }
+    std::cout << "checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -22,10 +22,78 @@
 
 #include "chaindynparam.hpp"
 #include "frames_io.hpp"
+#include "utilities/ltl_solver_eigen.hpp"
+#include <Eigen/Cholesky>
 #include <iostream>
 
 namespace KDL {
 
+    namespace {
+        typedef Eigen::Matrix<double,6,6> Matrix6d;
+        typedef Eigen::Matrix<double,6,1> Vector6d;
+
+        Eigen::Matrix3d skew(const Vector& v)
+        {
+            Eigen::Matrix3d m;
+            m << 0.0, -v(2), v(1),
+                 v(2), 0.0, -v(0),
+                 -v(1), v(0), 0.0;
+            return m;
+        }
+
+        Vector6d toVector6d(const Twist& t)
+        {
+            Vector6d e;
+            e << t.vel(0), t.vel(1), t.vel(2), t.rot(0), t.rot(1), t.rot(2);
+            return e;
+        }
+
+        Wrench toWrench(const Vector6d& e)
+        {
+            return Wrench(Vector(e(0), e(1), e(2)), Vector(e(3), e(4), e(5)));
+        }
+
+        //matrix of the twist cross product v x, as in v*t
+        Matrix6d motionCross(const Twist& v)
+        {
+            Matrix6d m;
+            m << skew(v.rot), skew(v.vel),
+                 Eigen::Matrix3d::Zero(), skew(v.rot);
+            return m;
+        }
+
+        //matrix of f xbar*, such that (f xbar*)*v = v x* f, as in v*f
+        Matrix6d forceCrossBar(const Wrench& f)
+        {
+            Matrix6d m;
+            m << Eigen::Matrix3d::Zero(), -skew(f.force),
+                 -skew(f.force), -skew(f.torque);
+            return m;
+        }
+
+        //matrix of the inertia, as in I*v
+        Matrix6d inertia(const ArticulatedBodyInertia& I)
+        {
+            Matrix6d m;
+            m << I.M, I.H.transpose(),
+                 I.H, I.I;
+            return m;
+        }
+
+        //matrix of the twist transformation, as in X*t
+        Matrix6d motionTransform(const Frame& X)
+        {
+            Eigen::Matrix3d R;
+            R << X.M(0,0), X.M(0,1), X.M(0,2),
+                 X.M(1,0), X.M(1,1), X.M(1,2),
+                 X.M(2,0), X.M(2,1), X.M(2,2);
+            Matrix6d m;
+            m << R, skew(X.p)*R,
+                 Eigen::Matrix3d::Zero(), R;
+            return m;
+        }
+    }
+
     ChainDynParam::ChainDynParam(const Chain& _chain, Vector _grav):
             chain(_chain),
             nr(0),
@@ -38,9 +106,25 @@ namespace KDL {
             wrenchnull(ns,Wrench::Zero()),
             X(ns),
             S(ns),
-            Ic(ns)
+            v(ns),
+            a_cor(ns),
+            a_grav(ns),
+            f_cor(ns),
+            f_grav(ns),
+            Ic(ns),
+            Sdot(ns),
+            Bc(ns),
+            jacsolver(chain),
+            H_os(nj),
+            jac(nj),
+            L_os(nj,nj),
+            Y_os(nj,6),
+            lambda(nj)
     {
         ag=-Twist(grav,Vector::Zero());
+        //In a chain the parent of every joint is the previous one
+        for(unsigned int i=0;i<nj;i++)
+            lambda[i]=int(i)-1;
     }
 
     void ChainDynParam::updateInternalDataStructures() {
@@ -52,7 +136,22 @@ namespace KDL {
         wrenchnull.resize(ns,Wrench::Zero());
         X.resize(ns);
         S.resize(ns);
+        v.resize(ns);
+        a_cor.resize(ns);
+        a_grav.resize(ns);
+        f_cor.resize(ns);
+        f_grav.resize(ns);
         Ic.resize(ns);
+        Sdot.resize(ns);
+        Bc.resize(ns);
+        jacsolver.updateInternalDataStructures();
+        H_os.resize(nj);
+        jac.resize(nj);
+        L_os.resize(nj,nj);
+        Y_os.resize(nj,6);
+        lambda.resize(nj);
+        for(unsigned int i=0;i<nj;i++)
+            lambda[i]=int(i)-1;
     }
 
 
@@ -146,6 +245,210 @@ namespace KDL {
 	return chainidsolver_gravity.CartToJnt(q, jntarraynull, jntarraynull, wrenchnull, gravity);
     }
 
+    //calculate H, C*qdot and G in one sweep
+    int ChainDynParam::JntToDynamics(const JntArray &q, const JntArray &q_dot, JntSpaceInertiaMatrix& H, JntArray &coriolis, JntArray &gravity)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        //Check sizes when in debug mode
+        if(q.rows()!=nj || q_dot.rows()!=nj || H.rows()!=nj || H.columns()!=nj || coriolis.rows()!=nj || gravity.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        unsigned int k=0;
+        double q_,qdot_;
+
+        //Sweep from root to leaf
+        for(unsigned int i=0;i<ns;i++)
+        {
+            const Segment& segment=chain.getSegment(i);
+            if(segment.getJoint().getType()!=Joint::Fixed)
+            {
+                q_=q(k);
+                qdot_=q_dot(k);
+                k++;
+            }
+            else
+            {
+                q_=qdot_=0.0;
+            }
+            X[i]=segment.pose(q_);//Remark this is the inverse of the frame for transformations from the parent to the current coord frame
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            Twist vj=S[i]*qdot_;
+            //Velocity terms only (coriolis) and gravity terms only, as the
+            //RNE passes of JntToCoriolis and JntToGravity would compute them
+            if(i==0)
+            {
+                v[i]=vj;
+                a_cor[i]=v[i]*vj;
+                a_grav[i]=X[i].Inverse(ag);
+            }
+            else
+            {
+                v[i]=X[i].Inverse(v[i-1])+vj;
+                a_cor[i]=X[i].Inverse(a_cor[i-1])+v[i]*vj;
+                a_grav[i]=X[i].Inverse(a_grav[i-1]);
+            }
+            const RigidBodyInertia& Ii=segment.getInertia();
+            f_cor[i]=Ii*a_cor[i]+v[i]*(Ii*v[i]);
+            f_grav[i]=Ii*a_grav[i];
+            //Collect RigidBodyInertia
+            Ic[i]=Ii;
+        }
+        //Sweep from leaf to root
+        int j,l;
+        k=nj-1; //reset k
+        for(int i=ns-1;i>=0;i--)
+        {
+            if(i!=0)
+            {
+                //assumption that previous segment is parent
+                Ic[i-1]=Ic[i-1]+X[i]*Ic[i];
+                f_cor[i-1]=f_cor[i-1]+X[i]*f_cor[i];
+                f_grav[i-1]=f_grav[i-1]+X[i]*f_grav[i];
+            }
+
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed)
+            {
+                coriolis(k)=dot(S[i],f_cor[i]);
+                gravity(k)=dot(S[i],f_grav[i]);
+
+                F=Ic[i]*S[i];
+                H(k,k)=dot(S[i],F);
+                H(k,k)+=chain.getSegment(i).getJoint().getInertia();  // add joint inertia
+                j=k; //countervariable for the joints
+                l=i; //countervariable for the segments
+                while(l!=0) //go from leaf to root starting at i
+                {
+                    //assumption that previous segment is parent
+                    F=X[l]*F; //calculate the unit force (cfr S) for every segment: F[l-1]=X[l]*F[l]
+                    l--; //go down a segment
+
+                    if(chain.getSegment(l).getJoint().getType()!=Joint::Fixed) //if the joint connected to segment is not a fixed joint
+                    {
+                        j--;
+                        H(k,j)=dot(F,S[l]); //here you actually match a certain not fixed joint with a segment
+                        H(j,k)=H(k,j);
+                    }
+                }
+                k--; //this if-loop should be repeated nj times (k=nj-1 to k=0)
+            }
+        }
+        return (error = E_NOERROR);
+    }
+
+    //calculate the coriolis matrix C, Echeandia and Wensing, Algorithm 1
+    int ChainDynParam::JntToCoriolisMatrix(const JntArray &q, const JntArray &q_dot, Eigen::MatrixXd& C)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        //Check sizes when in debug mode
+        if(q.rows()!=nj || q_dot.rows()!=nj || C.rows()!=nj || C.cols()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        unsigned int k=0;
+        double q_,qdot_;
+
+        //Sweep from root to leaf
+        for(unsigned int i=0;i<ns;i++)
+        {
+            const Segment& segment=chain.getSegment(i);
+            if(segment.getJoint().getType()!=Joint::Fixed)
+            {
+                q_=q(k);
+                qdot_=q_dot(k);
+                k++;
+            }
+            else
+            {
+                q_=qdot_=0.0;
+            }
+            X[i]=segment.pose(q_);
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            if(i==0)
+                v[i]=S[i]*qdot_;
+            else
+                v[i]=X[i].Inverse(v[i-1])+S[i]*qdot_;
+            //S is constant in the segment frame
+            Sdot[i]=v[i]*S[i];
+            //B(I,v) = 1/2*((v x*)*I + (I*v) xbar* - I*(v x)), so that dI/dt = B + B'
+            Ic[i]=segment.getInertia();
+            const Matrix6d I6=inertia(Ic[i]);
+            const Matrix6d vx=motionCross(v[i]);
+            Bc[i]=0.5*(-vx.transpose()*I6+forceCrossBar(Ic[i]*v[i])-I6*vx);
+        }
+        //Sweep from leaf to root
+        int j,l;
+        Wrench F1,F2,F3;
+        k=nj-1; //reset k
+        for(int i=ns-1;i>=0;i--)
+        {
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed)
+            {
+                const Vector6d S6=toVector6d(S[i]);
+                F1=Ic[i]*Sdot[i]+toWrench(Bc[i]*S6);
+                F2=Ic[i]*S[i];
+                F3=toWrench(Bc[i].transpose()*S6);
+                C(k,k)=dot(S[i],F1);
+                j=k; //countervariable for the joints
+                l=i; //countervariable for the segments
+                while(l!=0) //go from leaf to root starting at i
+                {
+                    //assumption that previous segment is parent
+                    F1=X[l]*F1;
+                    F2=X[l]*F2;
+                    F3=X[l]*F3;
+                    l--;
+
+                    if(chain.getSegment(l).getJoint().getType()!=Joint::Fixed)
+                    {
+                        j--;
+                        C(j,k)=dot(S[l],F1);
+                        C(k,j)=dot(Sdot[l],F2)+dot(S[l],F3);
+                    }
+                }
+                k--;
+            }
+
+            if(i!=0)
+            {
+                //assumption that previous segment is parent
+                Ic[i-1]=Ic[i-1]+X[i]*Ic[i];
+                const Matrix6d T=motionTransform(X[i].Inverse());
+                Bc[i-1].noalias()+=T.transpose()*Bc[i]*T;
+            }
+        }
+        return (error = E_NOERROR);
+    }
+
+    //calculate the operational space inertia matrix of the tip
+    int ChainDynParam::JntToOperationalSpaceInertia(const JntArray &q, Eigen::Matrix<double,6,6>& Lambda)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if(q.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        if(JntToMass(q,H_os) < 0)
+            return error;
+        int ret=jacsolver.JntToJac(q,jac);
+        if(ret < 0)
+            return (error = ret);
+
+        //J*H^-1*J^T = Y^T*Y with H = L^T*L and Y = L^-T*J^T
+        L_os=H_os.data;
+        ret=ltl_factorize(L_os,lambda);
+        if(ret < 0)
+            return (error = ret);
+        Y_os=jac.data.transpose();
+        ltl_solve_Lt(L_os,lambda,Y_os);
+        const Matrix6d Lambda_inv=Y_os.transpose()*Y_os;
+
+        Eigen::LDLT<Matrix6d> ldlt(Lambda_inv);
+        const Vector6d d=ldlt.vectorD().cwiseAbs();
+        //the pivots are sorted, a tiny last one means rank deficiency
+        if(ldlt.info()!=Eigen::Success || !(d.minCoeff() > 1e-12*d.maxCoeff()))
+            return (error = E_UNDEFINED);
+        Lambda=ldlt.solve(Matrix6d::Identity());
+        return (error = E_NOERROR);
+    }
+
     ChainDynParam::~ChainDynParam()
     {
     }
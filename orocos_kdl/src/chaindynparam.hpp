@@ -25,6 +25,7 @@
 #include "chainidsolver_recursive_newton_euler.hpp"
 #include "articulatedbodyinertia.hpp"
 #include "jntspaceinertiamatrix.hpp"
+#include "chainjnttojacsolver.hpp"
 #include <Eigen/StdVector>
 
 namespace KDL {
@@ -43,6 +44,21 @@ namespace KDL {
      * the joints (q,qdot,qdotdot), external forces on the segments
      * (expressed in the segments reference frame) and the dynamical
      * parameters of the segments.
+     *
+     * JntToDynamics() evaluates H, C(q,qdot)*qdot and G in a single
+     * forward sweep over the chain, sharing the segment poses, motion
+     * subspaces and composite-inertia pass between the three terms.
+     *
+     * JntToCoriolisMatrix() evaluates the full matrix C(q,qdot) with
+     * the recursive algorithm of S. Echeandia and P. M. Wensing,
+     * "Numerical Methods to Compute the Coriolis Matrix and Christoffel
+     * Symbols for Rigid-Body Systems", 2021, in O(n*d) with d the depth
+     * of the chain, instead of the n RNE passes of a column-wise
+     * evaluation.
+     *
+     * JntToOperationalSpaceInertia() factorizes H as L^T*L with
+     * ltl_factorize() and forms J*H^-1*J^T as Y^T*Y, with Y = L^-T*J^T,
+     * without inverting H.
      */
     class ChainDynParam : public SolverI
     {
@@ -54,9 +70,54 @@ namespace KDL {
 	virtual int JntToMass(const JntArray &q, JntSpaceInertiaMatrix& H);
 	virtual int JntToGravity(const JntArray &q,JntArray &gravity);
 
+        /**
+         * Calculate the joint-space inertia matrix, the coriolis and
+         * centrifugal torques and the gravity torques in one pass.
+         * Gives the same results as JntToMass(), JntToCoriolis() and
+         * JntToGravity(), but evaluates every segment pose only once.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * Output parameters:
+         * \param H The joint-space inertia matrix
+         * \param coriolis The coriolis and centrifugal torques C(q,q_dot)*q_dot
+         * \param gravity The gravity torques G(q)
+         */
+        virtual int JntToDynamics(const JntArray &q, const JntArray &q_dot, JntSpaceInertiaMatrix& H, JntArray &coriolis, JntArray &gravity);
+
+        /**
+         * Calculate the coriolis matrix C(q,q_dot), the one of the
+         * Christoffel symbols of the first kind, so that
+         * C(q,q_dot)*q_dot equals JntToCoriolis() and dH/dt-2*C is
+         * skew-symmetric.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * Output parameters:
+         * \param C The nj x nj coriolis matrix
+         */
+        virtual int JntToCoriolisMatrix(const JntArray &q, const JntArray &q_dot, Eigen::MatrixXd& C);
+
+        /**
+         * Calculate the operational space inertia matrix
+         * Lambda = (J*H^-1*J^T)^-1 of the tip of the chain, with J the
+         * jacobian of ChainJntToJacSolver (reference point at the tip,
+         * expressed in the base frame).
+         * Input parameters;
+         * \param q The current joint positions
+         * Output parameters:
+         * \param Lambda The 6x6 operational space inertia matrix
+         * \return E_UNDEFINED if J*H^-1*J^T is singular, e.g. with less
+         * than six joints or in a singular configuration
+         */
+        virtual int JntToOperationalSpaceInertia(const JntArray &q, Eigen::Matrix<double,6,6>& Lambda);
+
     /// @copydoc KDL::SolverI::updateInternalDataStructures()
     virtual void updateInternalDataStructures();
 
+    /// @copydoc KDL::SolverI::clone
+    virtual ChainDynParam* clone() const { return new ChainDynParam(*this); }
+
     private:
         const Chain& chain;
 	int nr;  // unused, remove in a future version
@@ -70,10 +131,23 @@ namespace KDL {
 	std::vector<Wrench> wrenchnull;
         std::vector<Frame> X;
         std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> a_cor;
+        std::vector<Twist> a_grav;
+        std::vector<Wrench> f_cor;
+        std::vector<Wrench> f_grav;
         //std::vector<RigidBodyInertia> I;
         std::vector<ArticulatedBodyInertia, Eigen::aligned_allocator<ArticulatedBodyInertia> > Ic;
+        std::vector<Twist> Sdot;
+        std::vector<Eigen::Matrix<double,6,6>, Eigen::aligned_allocator<Eigen::Matrix<double,6,6> > > Bc;
         Wrench F;
         Twist ag;
+        ChainJntToJacSolver jacsolver;
+        JntSpaceInertiaMatrix H_os;
+        Jacobian jac;
+        Eigen::MatrixXd L_os;
+        Eigen::MatrixXd Y_os;
+        std::vector<int> lambda;
 	
     };
 
@@ -104,6 +104,9 @@ namespace KDL {
         /// @copydoc KDL::SolverI::updateInternalDataStructures()
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainExternalWrenchEstimator* clone() const { return new ChainExternalWrenchEstimator(*this); }
+
         /// @copydoc KDL::SolverI::strError()
         virtual const char* strError(const int error) const;
 
@@ -0,0 +1,123 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainfdsolver_aba.hpp"
+
+namespace KDL{
+
+    ChainFdSolver_ABA::ChainFdSolver_ABA(const Chain& _chain, Vector grav):
+        chain(_chain),
+        nj(chain.getNrOfJoints()),
+        ns(chain.getNrOfSegments()),
+        X(ns),S(ns),v(ns),c(ns),a(ns),pA(ns),U(ns),D(ns),u(ns),IA(ns)
+    {
+        ag=-Twist(grav,Vector::Zero());
+    }
+
+    void ChainFdSolver_ABA::updateInternalDataStructures() {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        S.resize(ns);
+        v.resize(ns);
+        c.resize(ns);
+        a.resize(ns);
+        pA.resize(ns);
+        U.resize(ns);
+        D.resize(ns);
+        u.resize(ns);
+        IA.resize(ns);
+    }
+
+    int ChainFdSolver_ABA::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+
+        //Check sizes of function parameters
+        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=ns)
+            return (error = E_SIZE_MISMATCH);
+
+        unsigned int j=0;
+        //Sweep from root to leaf: velocities, velocity-product accelerations and bias forces
+        for(unsigned int i=0;i<ns;i++){
+            double q_,qdot_;
+            const Segment& segment=chain.getSegment(i);
+            if(segment.getJoint().getType()!=Joint::Fixed) {
+                q_=q(j);
+                qdot_=q_dot(j);
+                j++;
+            }else
+                q_=qdot_=0.0;
+
+            X[i]=segment.pose(q_);//Remark this is the inverse of the
+                                  //frame for transformations from
+                                  //the parent to the current coord frame
+            S[i]=X[i].M.Inverse(segment.twist(q_,1.0));
+            Twist vj=S[i]*qdot_;
+            if(i==0)
+                v[i]=vj;
+            else
+                v[i]=X[i].Inverse(v[i-1])+vj;
+            c[i]=v[i]*vj;
+
+            const RigidBodyInertia& Ii=segment.getInertia();
+            IA[i]=Ii;
+            pA[i]=v[i]*(Ii*v[i])-f_ext[i];
+        }
+
+        //Sweep from leaf to root: articulated body inertias and bias forces
+        j=nj-1;
+        for(int i=ns-1;i>=0;i--){
+            ArticulatedBodyInertia Ia=IA[i];
+            Wrench pa;
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
+                U[i]=IA[i]*S[i];
+                D[i]=dot(S[i],U[i])+chain.getSegment(i).getJoint().getInertia();
+                u[i]=torques(j)-dot(S[i],pA[i]);
+                //Ia = IA - U*U^T/D, with U=(force,torque) and IA acting on (vel,rot)
+                Eigen::Map<const Eigen::Vector3d> f(U[i].force.data);
+                Eigen::Map<const Eigen::Vector3d> n(U[i].torque.data);
+                Ia=Ia-ArticulatedBodyInertia(f*f.transpose()/D[i],n*f.transpose()/D[i],n*n.transpose()/D[i]);
+                pa=pA[i]+Ia*c[i]+U[i]*(u[i]/D[i]);
+                --j;
+            }else
+                pa=pA[i]+Ia*c[i];
+
+            if(i!=0){
+                //assumption that previous segment is parent
+                IA[i-1]=IA[i-1]+X[i]*Ia;
+                pA[i-1]=pA[i-1]+X[i]*pa;
+            }
+        }
+
+        //Sweep from root to leaf: joint and segment accelerations
+        j=0;
+        for(unsigned int i=0;i<ns;i++){
+            if(i==0)
+                a[i]=X[i].Inverse(ag)+c[i];
+            else
+                a[i]=X[i].Inverse(a[i-1])+c[i];
+            if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
+                q_dotdot(j)=(u[i]-dot(a[i],U[i]))/D[i];
+                a[i]=a[i]+S[i]*q_dotdot(j);
+                j++;
+            }
+        }
+        return (error = E_NOERROR);
+    }
+}//namespace
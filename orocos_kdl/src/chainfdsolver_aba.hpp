@@ -0,0 +1,86 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_FDSOLVER_ABA_HPP
+#define KDL_CHAIN_FDSOLVER_ABA_HPP
+
+#include "chainfdsolver.hpp"
+#include "articulatedbodyinertia.hpp"
+#include <Eigen/StdVector>
+
+namespace KDL{
+    /**
+     * \brief Articulated body algorithm forward dynamics solver
+     *
+     * The algorithm implementation is based on the book "Rigid Body
+     * Dynamics Algorithms" of Roy Featherstone, 2008
+     * (ISBN:978-0-387-74314-1) See page 132 for the pseudo-code.
+     *
+     * It calculates the accelerations for the joints (qdotdot), given the
+     * position and velocity of the joints (q,qdot), the joint torques,
+     * external forces on the segments (expressed in the segments reference
+     * frame) and the dynamical parameters of the segments. Unlike
+     * ChainFdSolver_RNE it never builds the joint-space inertia matrix and
+     * runs in O(n) in the number of segments.
+     */
+    class ChainFdSolver_ABA : public ChainFdSolver{
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param chain The kinematic chain to calculate the forward dynamics for, an internal reference will be stored.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        ChainFdSolver_ABA(const Chain& chain, Vector grav);
+        ~ChainFdSolver_ABA(){};
+
+        /**
+         * Function to calculate from joint torques to joint accelerations.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param torques The current joint torques (applied by controller)
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param q_dotdot The resulting joint accelerations
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainFdSolver_ABA* clone() const { return new ChainFdSolver_ABA(*this); }
+
+    private:
+        const Chain& chain;
+        unsigned int nj;
+        unsigned int ns;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> c;
+        std::vector<Twist> a;
+        std::vector<Wrench> pA;
+        std::vector<Wrench> U;
+        std::vector<double> D;
+        std::vector<double> u;
+        std::vector<ArticulatedBodyInertia, Eigen::aligned_allocator<ArticulatedBodyInertia> > IA;
+        Twist ag;
+    };
+}
+
+#endif
@@ -20,7 +20,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "chainfdsolver_recursive_newton_euler.hpp"
-#include "utilities/ldl_solver_eigen.hpp"
+#include "utilities/ltl_solver_eigen.hpp"
 #include "frames_io.hpp"
 #include "kinfam_io.hpp"
 
@@ -36,16 +36,25 @@ namespace KDL{
         Tzeroacc(nj),
         H_eig(nj,nj),
         Tzeroacc_eig(nj),
-        L_eig(nj,nj),
-        D_eig(nj),
-        r_eig(nj),
-        acc_eig(nj)
+        lambda(nj)
     {
+        //In a chain the parent of every joint is the previous one
+        for(unsigned int i=0;i<nj;i++)
+            lambda[i] = int(i)-1;
     }
 
     void ChainFdSolver_RNE::updateInternalDataStructures() {
         nj = chain.getNrOfJoints();
         ns = chain.getNrOfSegments();
+        DynSolver.updateInternalDataStructures();
+        IdSolver.updateInternalDataStructures();
+        H.resize(nj);
+        Tzeroacc.resize(nj);
+        H_eig.resize(nj,nj);
+        Tzeroacc_eig.resize(nj);
+        lambda.resize(nj);
+        for(unsigned int i=0;i<nj;i++)
+            lambda[i] = int(i)-1;
     }
 
     int ChainFdSolver_RNE::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const Wrenches& f_ext, JntArray &q_dotdot)
@@ -78,16 +87,13 @@ namespace KDL{
             return (error);
 
         // Calculate acceleration using inverse symmetric matrix times vector
-        for(unsigned int i=0;i<nj;i++){
-            Tzeroacc_eig(i) =  (torques(i)-Tzeroacc(i));
-            for(unsigned int j=0;j<nj;j++){
-                H_eig(i,j) =  H(i,j);
-            }
-        }
-        ldl_solver_eigen(H_eig, Tzeroacc_eig, L_eig, D_eig, r_eig, acc_eig);
-        for(unsigned int i=0;i<nj;i++){
-            q_dotdot(i) = acc_eig(i);
-        }
+        Tzeroacc_eig = torques.data - Tzeroacc.data;
+        H_eig = H.data;
+        error = ltl_factorize(H_eig, lambda);
+        if (error < 0)
+            return (error);
+        ltl_solve(H_eig, lambda, Tzeroacc_eig);
+        q_dotdot.data = Tzeroacc_eig;
 
         return (error = E_NOERROR);
     }
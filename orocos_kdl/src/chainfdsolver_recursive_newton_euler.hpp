@@ -38,6 +38,9 @@ namespace KDL{
      * position and velocity of the joints (q,qdot,qdotdot), external forces
      * on the segments (expressed in the segments reference frame),
      * and the dynamical parameters of the segments.
+     *
+     * The joint space inertia matrix is factorized as L^T*L with
+     * ltl_factorize(), see Chapter 6.5.
      */
     class ChainFdSolver_RNE : public ChainFdSolver{
     public:
@@ -64,6 +67,9 @@ namespace KDL{
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainFdSolver_RNE* clone() const { return new ChainFdSolver_RNE(*this); }
+
         /**
          * Function to integrate the joint accelerations resulting from the forward dynamics solver.
          * Input parameters;
@@ -101,10 +107,7 @@ namespace KDL{
         JntArray Tzeroacc;
         Eigen::MatrixXd H_eig;
         Eigen::VectorXd Tzeroacc_eig;
-        Eigen::MatrixXd L_eig;
-        Eigen::VectorXd D_eig;
-        Eigen::VectorXd r_eig;
-        Eigen::VectorXd acc_eig;
+        std::vector<int> lambda;
     };
 }
 
@@ -0,0 +1,285 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainfksolverpos_batch.hpp"
+#include <cmath>
+
+// Compile the kernel for several instruction sets and dispatch at load
+// time where the toolchain supports it (needs ifunc, so ELF/x86-64).
+// The x86-64-v3/v4 levels also enable FMA, older compilers only know the
+// individual features.
+#if defined(__has_attribute)
+#if __has_attribute(target_clones) && defined(__x86_64__) && defined(__linux__)
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#define KDL_BATCH_KERNEL __attribute__((target_clones("arch=x86-64-v4","arch=x86-64-v3","default")))
+#else
+#define KDL_BATCH_KERNEL __attribute__((target_clones("avx512f","avx2","default")))
+#endif
+// helpers must be inlined to be compiled for the instruction set of each clone
+#define KDL_BATCH_INLINE inline __attribute__((always_inline))
+#endif
+#endif
+#ifndef KDL_BATCH_KERNEL
+#define KDL_BATCH_KERNEL
+#define KDL_BATCH_INLINE inline
+#endif
+
+namespace KDL {
+
+    namespace {
+        const unsigned int L = ChainFkSolverPos_batch::LANES;
+
+        // Cephes sin/cos, with the octant selection done without branches
+        // so that every step maps onto packed instructions
+        KDL_BATCH_INLINE void sinCosLanes(const double* x, double* s, double* c)
+        {
+            static const double FOPI = 1.27323954473516268615; // 4/pi
+            static const double DP1 = 7.85398125648498535156E-1;
+            static const double DP2 = 3.77489470793079817668E-8;
+            static const double DP3 = 2.69515142907905952645E-15;
+            static const double LOSSTH = 1.0e8;
+            for (unsigned int l = 0; l < L; ++l) {
+                if (!(std::fabs(x[l]) <= LOSSTH)) {
+                    for (unsigned int m = 0; m < L; ++m) {
+                        s[m] = std::sin(x[m]);
+                        c[m] = std::cos(x[m]);
+                    }
+                    return;
+                }
+            }
+            for (unsigned int l = 0; l < L; ++l) {
+                const double xa = std::fabs(x[l]);
+                // octant, with odd octants mapped onto the next even one;
+                // int instead of floor and integer ops instead of
+                // comparisons keep the loop vectorizable
+                int iy = (int)(xa * FOPI);
+                iy += iy & 1;
+                const double y = iy;
+                const int j = iy & 7;
+                const double flip = 1 - 2 * (j >> 2);
+                const double swap = (j >> 1) & 1;
+                const double sign_s = std::copysign(1.0, x[l]) * flip;
+                const double sign_c = flip * (1.0 - 2.0 * swap);
+                const double z = ((xa - y * DP1) - y * DP2) - y * DP3;
+                const double zz = z * z;
+                const double ps = z + z * zz * ((((((1.58962301576546568060E-10 * zz
+                        - 2.50507477628578072866E-8) * zz
+                        + 2.75573136213857245213E-6) * zz
+                        - 1.98412698295895385996E-4) * zz
+                        + 8.33333333332211858878E-3) * zz
+                        - 1.66666666666666307295E-1));
+                const double pc = 1.0 - 0.5 * zz + zz * zz * ((((((-1.13585365213876817300E-11 * zz
+                        + 2.08757008419747316778E-9) * zz
+                        - 2.75573141792967388112E-7) * zz
+                        + 2.48015872888517045348E-5) * zz
+                        - 1.38888888888730564116E-3) * zz
+                        + 4.16666666666665929218E-2));
+                s[l] = sign_s * (ps + swap * (pc - ps));
+                c[l] = sign_c * (pc + swap * (ps - pc));
+            }
+        }
+
+        // Forward kinematics of configurations [0,nr_of_configs) through
+        // nr_of_segments segments. q holds one column of ld values per joint.
+        KDL_BATCH_KERNEL
+        void fkKernel(const ChainFkSolverPos_batch::SegmentTerms* terms, unsigned int nr_of_segments,
+                      const double* q, unsigned int ld, unsigned int nr_of_configs, Frame* p_out)
+        {
+            // rotation (row major) and position of the accumulated frame,
+            // and of the current segment, one lane per configuration
+            double T[12][L];
+            double S[12][L];
+            double th[L], u[L], v[L];
+            double R[9][L];
+            for (unsigned int k0 = 0; k0 < nr_of_configs; k0 += L) {
+                const unsigned int n = nr_of_configs - k0 < L ? nr_of_configs - k0 : L;
+                for (unsigned int e = 0; e < 12; ++e)
+                    for (unsigned int l = 0; l < L; ++l)
+                        T[e][l] = (e == 0 || e == 4 || e == 8) ? 1.0 : 0.0;
+
+                unsigned int j = 0;
+                for (unsigned int i = 0; i < nr_of_segments; ++i) {
+                    const ChainFkSolverPos_batch::SegmentTerms& st = terms[i];
+                    if (st.kind == ChainFkSolverPos_batch::SegmentTerms::Fixed) {
+                        for (unsigned int l = 0; l < L; ++l) {
+                            u[l] = 0.0;
+                            v[l] = 0.0;
+                        }
+                    } else {
+                        // pad the last block with the last configuration
+                        const double* qj = q + (std::size_t)j * ld + k0;
+                        for (unsigned int l = 0; l < L; ++l)
+                            th[l] = st.scale * qj[l < n ? l : n - 1] + st.offset;
+                        if (st.kind == ChainFkSolverPos_batch::SegmentTerms::Rotational)
+                            sinCosLanes(th, v, u);
+                        else
+                            for (unsigned int l = 0; l < L; ++l) {
+                                u[l] = th[l];
+                                v[l] = 0.0;
+                            }
+                        ++j;
+                    }
+                    for (unsigned int e = 0; e < 12; ++e)
+                        for (unsigned int l = 0; l < L; ++l)
+                            S[e][l] = st.P0[e] + u[l] * st.Pu[e] + v[l] * st.Pv[e];
+
+                    // T = T*S
+                    for (unsigned int r = 0; r < 3; ++r)
+                        for (unsigned int cl = 0; cl < 3; ++cl)
+                            for (unsigned int l = 0; l < L; ++l)
+                                R[3 * r + cl][l] = T[3 * r][l] * S[cl][l]
+                                        + T[3 * r + 1][l] * S[3 + cl][l]
+                                        + T[3 * r + 2][l] * S[6 + cl][l];
+                    for (unsigned int r = 0; r < 3; ++r)
+                        for (unsigned int l = 0; l < L; ++l)
+                            T[9 + r][l] += T[3 * r][l] * S[9][l]
+                                    + T[3 * r + 1][l] * S[10][l]
+                                    + T[3 * r + 2][l] * S[11][l];
+                    for (unsigned int e = 0; e < 9; ++e)
+                        for (unsigned int l = 0; l < L; ++l)
+                            T[e][l] = R[e][l];
+                }
+
+                for (unsigned int l = 0; l < n; ++l) {
+                    Frame& F = p_out[k0 + l];
+                    for (unsigned int e = 0; e < 9; ++e)
+                        F.M.data[e] = T[e][l];
+                    F.p = Vector(T[9][l], T[10][l], T[11][l]);
+                }
+            }
+        }
+
+        void toTerm(const Frame& F, double* P)
+        {
+            for (unsigned int e = 0; e < 9; ++e)
+                P[e] = F.M.data[e];
+            P[9] = F.p.x();
+            P[10] = F.p.y();
+            P[11] = F.p.z();
+        }
+    }
+
+    ChainFkSolverPos_batch::ChainFkSolverPos_batch(const Chain& _chain):
+        chain(_chain)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainFkSolverPos_batch::~ChainFkSolverPos_batch()
+    {
+    }
+
+    void ChainFkSolverPos_batch::updateInternalDataStructures()
+    {
+        terms.resize(chain.getNrOfSegments());
+        for (unsigned int i = 0; i < chain.getNrOfSegments(); ++i) {
+            const Segment& segment = chain.getSegment(i);
+            const Joint& joint = segment.getJoint();
+            // Segment::pose(q) is joint.pose(q)*f_tip with the stored f_tip
+            // relative to the joint at q=0
+            const Frame f_tip = joint.pose(0.0).Inverse() * segment.getFrameToTip();
+            SegmentTerms& st = terms[i];
+            st.scale = joint.getScale();
+            st.offset = joint.getOffset();
+            switch (joint.getType()) {
+            case Joint::RotAxis:
+            case Joint::RotX:
+            case Joint::RotY:
+            case Joint::RotZ: {
+                // the pose is affine in (cos,sin) of the joint angle,
+                // recover the terms from the angles 0, pi/2 and pi
+                st.kind = SegmentTerms::Rotational;
+                double P1[12], P2[12];
+                const Vector axis = joint.JointAxis();
+                const Vector origin = joint.getType() == Joint::RotAxis ? joint.JointOrigin() : Vector::Zero();
+                toTerm(Frame(Rotation::Rot2(axis, 0.0), origin) * f_tip, P1);
+                toTerm(Frame(Rotation::Rot2(axis, PI_2), origin) * f_tip, st.Pv);
+                toTerm(Frame(Rotation::Rot2(axis, PI), origin) * f_tip, P2);
+                for (unsigned int e = 0; e < 12; ++e) {
+                    st.P0[e] = 0.5 * (P1[e] + P2[e]);
+                    st.Pu[e] = 0.5 * (P1[e] - P2[e]);
+                    st.Pv[e] -= st.P0[e];
+                }
+                break;
+            }
+            case Joint::TransAxis:
+            case Joint::TransX:
+            case Joint::TransY:
+            case Joint::TransZ: {
+                st.kind = SegmentTerms::Translational;
+                const Vector origin = joint.getType() == Joint::TransAxis ? joint.JointOrigin() : Vector::Zero();
+                const Vector axis = joint.JointAxis();
+                toTerm(Frame(origin) * f_tip, st.P0);
+                for (unsigned int e = 0; e < 12; ++e) {
+                    st.Pu[e] = e < 9 ? 0.0 : axis(e - 9);
+                    st.Pv[e] = 0.0;
+                }
+                break;
+            }
+            default:
+                st.kind = SegmentTerms::Fixed;
+                toTerm(f_tip, st.P0);
+                for (unsigned int e = 0; e < 12; ++e) {
+                    st.Pu[e] = 0.0;
+                    st.Pv[e] = 0.0;
+                }
+                break;
+            }
+        }
+    }
+
+    void ChainFkSolverPos_batch::sinCos(const double* x, double* s, double* c)
+    {
+        sinCosLanes(x, s, c);
+    }
+
+    int ChainFkSolverPos_batch::JntToCart(const Eigen::MatrixXd& q_in, std::vector<Frame>& p_out, int seg_nr)
+    {
+        unsigned int segmentNr;
+        if (seg_nr < 0)
+            segmentNr = chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        if (terms.size() != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        else if (q_in.cols() != chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if (segmentNr > chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+
+        p_out.resize(q_in.rows());
+        if (q_in.rows() == 0)
+            return (error = E_NOERROR);
+        fkKernel(&terms[0], segmentNr, q_in.data(), q_in.rows(), q_in.rows(), &p_out[0]);
+        return (error = E_NOERROR);
+    }
+
+    int ChainFkSolverPos_batch::JntToCart(const std::vector<JntArray>& q_in, std::vector<Frame>& p_out, int seg_nr)
+    {
+        const unsigned int nj = chain.getNrOfJoints();
+        q_soa.resize(q_in.size(), nj);
+        for (unsigned int k = 0; k < q_in.size(); ++k) {
+            if (q_in[k].rows() != nj)
+                return (error = E_SIZE_MISMATCH);
+            q_soa.row(k) = q_in[k].data.transpose();
+        }
+        return JntToCart(q_soa, p_out, seg_nr);
+    }
+
+}
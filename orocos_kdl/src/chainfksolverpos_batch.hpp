@@ -0,0 +1,124 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDLCHAINFKSOLVERPOS_BATCH_HPP
+#define KDLCHAINFKSOLVERPOS_BATCH_HPP
+
+#include "chain.hpp"
+#include "frames.hpp"
+#include "jntarray.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * \brief Position forward kinematics for many joint configurations
+     * at once.
+     *
+     * The joint positions are given as a structure of arrays: an
+     * Eigen::MatrixXd with one row per configuration and one column per
+     * joint, so that the values of one joint over all configurations are
+     * contiguous in memory. The configurations are processed in blocks of
+     * KDL::ChainFkSolverPos_batch::LANES, with the sine/cosine of the joint
+     * angles and the frame compositions written as loops over the lanes
+     * of a block, which the compiler turns into AVX2/AVX-512 code. On
+     * x86-64 Linux with GCC or Clang the kernel is compiled for AVX-512,
+     * AVX2 and the baseline instruction set and the best one is picked at
+     * load time, elsewhere the same loops run as plain scalar code.
+     *
+     * The results match KDL::ChainFkSolverPos_recursive up to rounding.
+     */
+    class ChainFkSolverPos_batch : public KDL::SolverI
+    {
+    public:
+        /// Number of configurations evaluated together by the kernel
+        static const unsigned int LANES = 8;
+
+        /**
+         * Constructor of the solver, the joint and tip frame data of the
+         * chain is copied into a table, call
+         * updateInternalDataStructures() after changing the chain.
+         *
+         * @param chain The kinematic chain, an internal reference is stored.
+         */
+        explicit ChainFkSolverPos_batch(const Chain& chain);
+        ~ChainFkSolverPos_batch();
+
+        /**
+         * Calculate the frame of segment segmentNr (the tip if -1) for
+         * every configuration.
+         *
+         * @param q_in nr_of_configurations x nr_of_joints joint positions
+         * @param p_out the resulting frames, resized to the number of rows of q_in
+         * @param segmentNr the number of segments to walk through, -1 for all
+         *
+         * @return E_NOERROR, E_SIZE_MISMATCH, E_OUT_OF_RANGE or E_NOT_UP_TO_DATE
+         */
+        int JntToCart(const Eigen::MatrixXd& q_in, std::vector<Frame>& p_out, int segmentNr=-1);
+
+        /**
+         * Convenience overload taking one KDL::JntArray per configuration,
+         * the joint positions are first copied into the internal
+         * structure of arrays.
+         */
+        int JntToCart(const std::vector<JntArray>& q_in, std::vector<Frame>& p_out, int segmentNr=-1);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainFkSolverPos_batch* clone() const { return new ChainFkSolverPos_batch(*this); }
+
+        /**
+         * Sine and cosine of LANES angles at once, with the same loop
+         * structure as used in the kernel. Accurate to a few ulp, a block
+         * holding an angle with |x| > 1e8 falls back to std::sin and
+         * std::cos.
+         */
+        static void sinCos(const double* x, double* s, double* c);
+
+        /**
+         * Per segment decomposition of Segment::pose(q) as
+         * P0 + u*Pu + v*Pv, with (u,v) = (cos,sin) of the joint angle
+         * for rotational joints, (u,v) = (translation,0) for prismatic
+         * joints and (0,0) for fixed ones.
+         * Each term holds the row major rotation followed by the position.
+         */
+        struct SegmentTerms
+        {
+            enum Kind {Fixed, Rotational, Translational};
+            int kind;
+            double scale;
+            double offset;
+            double P0[12];
+            double Pu[12];
+            double Pv[12];
+        };
+
+    private:
+        const Chain& chain;
+        std::vector<SegmentTerms> terms;
+        Eigen::MatrixXd q_soa;
+    };
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainfksolverpos_incremental.hpp"
+
+namespace KDL {
+
+    ChainFkSolverPos_incremental::ChainFkSolverPos_incremental(const Chain& _chain):
+        chain(_chain),
+        nr_valid(0),
+        first_changed(0),
+        nr_recomputed(0)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainFkSolverPos_incremental::~ChainFkSolverPos_incremental()
+    {
+    }
+
+    void ChainFkSolverPos_incremental::updateInternalDataStructures()
+    {
+        frames.resize(chain.getNrOfSegments());
+        joint_segment.resize(chain.getNrOfJoints());
+        segment_joint.resize(chain.getNrOfSegments());
+        q_cached.resize(chain.getNrOfJoints());
+        unsigned int j = 0;
+        for (unsigned int i = 0; i < chain.getNrOfSegments(); i++) {
+            segment_joint[i] = j;
+            if (chain.getSegment(i).getJoint().getType() != Joint::Fixed)
+                joint_segment[j++] = i;
+        }
+        invalidate();
+    }
+
+    void ChainFkSolverPos_incremental::invalidate()
+    {
+        nr_valid = 0;
+    }
+
+    int ChainFkSolverPos_incremental::updateFrames(const JntArray& q_in, unsigned int segmentNr)
+    {
+        if (frames.size() != chain.getNrOfSegments() || q_cached.rows() != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        else if (q_in.rows() != chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if (segmentNr > chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+
+        // The frames up to the segment of the first changed joint stay valid
+        first_changed = nr_valid == 0 ? 0 : chain.getNrOfSegments();
+        for (unsigned int j = 0; j < q_in.rows(); j++) {
+            if (q_in(j) != q_cached(j)) {
+                if (joint_segment[j] < first_changed)
+                    first_changed = joint_segment[j];
+                break;
+            }
+        }
+        q_cached = q_in;
+        if (first_changed < nr_valid)
+            nr_valid = first_changed;
+
+        nr_recomputed = 0;
+        if (nr_valid >= segmentNr)
+            return (error = E_NOERROR);
+
+        unsigned int j = segment_joint[nr_valid];
+        for (unsigned int i = nr_valid; i < segmentNr; i++) {
+            const Segment& segment = chain.getSegment(i);
+            double q = 0.0;
+            if (segment.getJoint().getType() != Joint::Fixed)
+                q = q_in(j++);
+            if (i == 0)
+                frames[i] = segment.pose(q);
+            else
+                frames[i] = frames[i-1] * segment.pose(q);
+            nr_recomputed++;
+        }
+        nr_valid = segmentNr;
+        return (error = E_NOERROR);
+    }
+
+    int ChainFkSolverPos_incremental::JntToCart(const JntArray& q_in, Frame& p_out, int seg_nr)
+    {
+        unsigned int segmentNr;
+        if (seg_nr < 0)
+            segmentNr = chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        p_out = Frame::Identity();
+        if (updateFrames(q_in, segmentNr) != E_NOERROR)
+            return error;
+        if (segmentNr > 0)
+            p_out = frames[segmentNr-1];
+        return (error = E_NOERROR);
+    }
+
+    int ChainFkSolverPos_incremental::JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int seg_nr)
+    {
+        unsigned int segmentNr;
+        if (seg_nr < 0)
+            segmentNr = chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        if (p_out.size() != segmentNr || segmentNr == 0)
+            return (error = E_SIZE_MISMATCH);
+        if (updateFrames(q_in, segmentNr) != E_NOERROR)
+            return error;
+        for (unsigned int i = 0; i < segmentNr; i++)
+            p_out[i] = frames[i];
+        return (error = E_NOERROR);
+    }
+
+}
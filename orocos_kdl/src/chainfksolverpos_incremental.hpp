@@ -0,0 +1,99 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDLCHAINFKSOLVERPOS_INCREMENTAL_HPP
+#define KDLCHAINFKSOLVERPOS_INCREMENTAL_HPP
+
+#include "chainfksolver.hpp"
+
+namespace KDL {
+
+    /**
+     * Implementation of a recursive forward position kinematics
+     * algorithm that keeps the frames of all segments (expressed in the
+     * base frame) and the joint values of the previous call. A call only
+     * recomputes the segments from the first joint whose value changed
+     * onward, so that moving distal joints only costs the distal part
+     * of the chain. This is typically used as the forward kinematics
+     * solver of KDL::ChainIkSolverPos_NR_JL.
+     *
+     * The cache is keyed on the joint values only: call invalidate()
+     * (or updateInternalDataStructures()) after changing the segments
+     * of the chain.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainFkSolverPos_incremental : public ChainFkSolverPos
+    {
+    public:
+        explicit ChainFkSolverPos_incremental(const Chain& chain);
+        ~ChainFkSolverPos_incremental();
+
+        virtual int JntToCart(const JntArray& q_in, Frame& p_out, int segmentNr=-1);
+        virtual int JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int segmentNr=-1);
+
+        /**
+         * Bring the cached frames of the first segmentNr segments up to
+         * date with q_in.
+         *
+         * @return E_NOERROR, E_NOT_UP_TO_DATE, E_SIZE_MISMATCH or E_OUT_OF_RANGE
+         */
+        int updateFrames(const JntArray& q_in, unsigned int segmentNr);
+
+        /**
+         * Forget all cached frames, the next call recomputes the chain
+         * from the base.
+         */
+        void invalidate();
+
+        /**
+         * Cached frame of the tip of segment segmentNr w.r.t. the base,
+         * only valid for segments up to the segmentNr of the last call.
+         */
+        const Frame& getSegmentFrame(unsigned int segmentNr) const { return frames[segmentNr]; }
+
+        /**
+         * Index of the first segment whose frame was affected by a joint
+         * value change or invalidation in the last call, the number of
+         * segments if none was.
+         */
+        unsigned int getFirstChangedSegment() const { return first_changed; }
+
+        /// Number of Segment::pose evaluations done by the last call
+        unsigned int getNrOfRecomputedSegments() const { return nr_recomputed; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainFkSolverPos_incremental* clone() const { return new ChainFkSolverPos_incremental(*this); }
+
+    private:
+        const Chain& chain;
+        std::vector<Frame> frames;
+        std::vector<unsigned int> joint_segment;
+        std::vector<unsigned int> segment_joint;
+        JntArray q_cached;
+        unsigned int nr_valid;
+        unsigned int first_changed;
+        unsigned int nr_recomputed;
+    };
+
+}
+
+#endif
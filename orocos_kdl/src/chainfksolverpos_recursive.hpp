@@ -44,6 +44,9 @@ namespace KDL {
 
         virtual void updateInternalDataStructures() {};
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainFkSolverPos_recursive* clone() const { return new ChainFkSolverPos_recursive(*this); }
+
     private:
         const Chain& chain;
     };
@@ -43,6 +43,9 @@ namespace KDL
         virtual int JntToCart(const JntArrayVel& q_in,FrameVel& out,int segmentNr=-1);
         virtual int JntToCart(const JntArrayVel& q_in,std::vector<FrameVel>& out,int segmentNr=-1);
         virtual void updateInternalDataStructures() {};
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainFkSolverVel_recursive* clone() const { return new ChainFkSolverVel_recursive(*this); }
     private:
         const Chain& chain;
     };
@@ -407,6 +407,9 @@ public:
     /// @copydoc KDL::SolverI::updateInternalDataStructures
     virtual void updateInternalDataStructures();
 
+    /// @copydoc KDL::SolverI::clone
+    virtual ChainHdSolver_Vereshchagin* clone() const { return new ChainHdSolver_Vereshchagin(*this); }
+
     //Returns cartesian acceleration of links in base coordinates
     void getTransformedLinkAcceleration(Twists& x_dotdot);
 
@@ -62,6 +62,9 @@ namespace KDL{
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIdSolver_RNE* clone() const { return new ChainIdSolver_RNE(*this); }
+
     private:
         const Chain& chain;
         unsigned int nj;
@@ -0,0 +1,182 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainidsolver_recursive_newton_euler_batch.hpp"
+
+#include <algorithm>
+
+namespace KDL {
+
+    ChainIdSolver_RNE_batch::Worker::Worker(const Chain& chain, const Vector& grav):
+        idsolver(chain, grav),
+        q(chain.getNrOfJoints()),
+        q_dot(chain.getNrOfJoints()),
+        q_dotdot(chain.getNrOfJoints()),
+        torques(chain.getNrOfJoints()),
+        f_ext(chain.getNrOfSegments(), Wrench::Zero())
+    {
+    }
+
+    ChainIdSolver_RNE_batch::ChainIdSolver_RNE_batch(const Chain& _chain, Vector grav, unsigned int nr_of_threads):
+        chain(_chain), nj(chain.getNrOfJoints()), ns(chain.getNrOfSegments()),
+        peak(Eigen::VectorXd::Zero(nj)), rms(Eigen::VectorXd::Zero(nj)),
+        q_in(NULL), q_dot_in(NULL), q_dotdot_in(NULL), f_ext_in(NULL), torques_out(NULL),
+        next_chunk(0), worker_error(E_NOERROR),
+        generation(0), nr_busy(0), shutdown(false)
+    {
+        if (nr_of_threads == 0)
+            nr_of_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int i = 0; i < nr_of_threads; i++)
+            workers.push_back(new Worker(chain, grav));
+        //The calling thread acts as the first worker
+        for (unsigned int i = 1; i < nr_of_threads; i++)
+            workers[i]->thread = std::thread(&ChainIdSolver_RNE_batch::workerLoop, this, std::ref(*workers[i]), generation);
+    }
+
+    ChainIdSolver_RNE_batch::~ChainIdSolver_RNE_batch()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shutdown = true;
+        }
+        work_cv.notify_all();
+        for (unsigned int i = 0; i < workers.size(); i++) {
+            if (workers[i]->thread.joinable())
+                workers[i]->thread.join();
+            delete workers[i];
+        }
+    }
+
+    void ChainIdSolver_RNE_batch::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        peak.setZero(nj);
+        rms.setZero(nj);
+        for (unsigned int i = 0; i < workers.size(); i++) {
+            Worker& worker = *workers[i];
+            worker.idsolver.updateInternalDataStructures();
+            worker.q.resize(nj);
+            worker.q_dot.resize(nj);
+            worker.q_dotdot.resize(nj);
+            worker.torques.resize(nj);
+            worker.f_ext.assign(ns, Wrench::Zero());
+        }
+    }
+
+    int ChainIdSolver_RNE_batch::CartToJnt(const Eigen::MatrixXd& q, const Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& q_dotdot,
+                                           Eigen::MatrixXd& torques)
+    {
+        return CartToJnt(q, q_dot, q_dotdot, no_f_ext, torques);
+    }
+
+    int ChainIdSolver_RNE_batch::CartToJnt(const Eigen::MatrixXd& q, const Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& q_dotdot,
+                                           const std::vector<Wrenches>& f_ext, Eigen::MatrixXd& torques)
+    {
+        if (nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+
+        const Eigen::Index nr_of_samples = q.rows();
+        if (q.cols() != nj || q_dot.rows() != nr_of_samples || q_dot.cols() != nj ||
+            q_dotdot.rows() != nr_of_samples || q_dotdot.cols() != nj)
+            return (error = E_SIZE_MISMATCH);
+        if (!f_ext.empty()) {
+            if (f_ext.size() != (size_t)nr_of_samples)
+                return (error = E_SIZE_MISMATCH);
+            for (size_t k = 0; k < f_ext.size(); k++)
+                if (f_ext[k].size() != ns)
+                    return (error = E_SIZE_MISMATCH);
+        }
+        torques.resize(nr_of_samples, nj);
+
+        q_in = &q;
+        q_dot_in = &q_dot;
+        q_dotdot_in = &q_dotdot;
+        f_ext_in = &f_ext;
+        torques_out = &torques;
+        next_chunk = 0;
+        worker_error = E_NOERROR;
+
+        //Wake up the pool and work along with it
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++generation;
+            nr_busy = workers.size() - 1;
+        }
+        work_cv.notify_all();
+        solveChunks(*workers[0]);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done_cv.wait(lock, [this] { return nr_busy == 0; });
+        }
+        if (worker_error != E_NOERROR)
+            return (error = worker_error);
+
+        //Column wise over all samples, independent of the thread that computed them
+        if (nr_of_samples > 0) {
+            peak = torques.cwiseAbs().colwise().maxCoeff().transpose();
+            rms = (torques.colwise().squaredNorm().transpose() / double(nr_of_samples)).cwiseSqrt();
+        }
+        else {
+            peak.setZero(nj);
+            rms.setZero(nj);
+        }
+        return (error = E_NOERROR);
+    }
+
+    void ChainIdSolver_RNE_batch::workerLoop(Worker& worker, unsigned int seen)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work_cv.wait(lock, [&] { return shutdown || generation != seen; });
+            if (shutdown)
+                return;
+            seen = generation;
+            lock.unlock();
+            solveChunks(worker);
+            lock.lock();
+            if (--nr_busy == 0)
+                done_cv.notify_one();
+        }
+    }
+
+    void ChainIdSolver_RNE_batch::solveChunks(Worker& worker)
+    {
+        const unsigned int nr_of_samples = q_in->rows();
+        while (worker_error == E_NOERROR) {
+            const unsigned int begin = CHUNK * next_chunk++;
+            if (begin >= nr_of_samples)
+                return;
+            const unsigned int end = std::min(begin + CHUNK, nr_of_samples);
+            for (unsigned int k = begin; k < end; k++) {
+                worker.q.data = q_in->row(k).transpose();
+                worker.q_dot.data = q_dot_in->row(k).transpose();
+                worker.q_dotdot.data = q_dotdot_in->row(k).transpose();
+                const int ret = worker.idsolver.CartToJnt(worker.q, worker.q_dot, worker.q_dotdot,
+                                                          f_ext_in->empty() ? worker.f_ext : (*f_ext_in)[k], worker.torques);
+                if (ret != E_NOERROR) {
+                    worker_error = ret;
+                    return;
+                }
+                torques_out->row(k) = worker.torques.data.transpose();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,142 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#ifndef KDL_CHAIN_IDSOLVER_RECURSIVE_NEWTON_EULER_BATCH_HPP
+#define KDL_CHAIN_IDSOLVER_RECURSIVE_NEWTON_EULER_BATCH_HPP
+
+#include "chainidsolver_recursive_newton_euler.hpp"
+
+#include <Eigen/Core>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * \brief Inverse dynamics for all samples of a trajectory at once.
+     *
+     * The joint positions, velocities and accelerations are given as
+     * matrices with one row per sample and one column per joint, as
+     * for KDL::ChainFkSolverPos_batch. The samples are cut into chunks
+     * of CHUNK rows that a pool of threads evaluates with
+     * KDL::ChainIdSolver_RNE: every thread owns its own solver and
+     * pulls the next chunk from a shared counter, so a thread that
+     * finishes early keeps taking work from the others. The calling
+     * thread takes part in the work, a pool of one thread starts no
+     * extra threads.
+     *
+     * Next to the torques the peak (maximum absolute value) and RMS
+     * torque of every joint over all samples are computed, e.g. to
+     * check a planned trajectory against the actuator limits. The
+     * results do not depend on the number of threads.
+     *
+     * A single solver object must not be used from several threads at
+     * once.
+     */
+    class ChainIdSolver_RNE_batch : public SolverI
+    {
+    public:
+        /// Number of samples handed to a thread at once
+        static const unsigned int CHUNK = 64;
+
+        /**
+         * Constructor of the solver
+         *
+         * @param chain The kinematic chain, an internal reference is stored.
+         * @param grav The gravity vector to use during the calculation.
+         * @param nr_of_threads the number of threads working on the
+         * samples, including the calling one; 0 uses one per hardware thread
+         */
+        ChainIdSolver_RNE_batch(const Chain& chain, Vector grav, unsigned int nr_of_threads=0);
+        ~ChainIdSolver_RNE_batch();
+
+        /**
+         * Calculate the joint torques of every sample.
+         *
+         * @param q nr_of_samples x nr_of_joints joint positions
+         * @param q_dot nr_of_samples x nr_of_joints joint velocities
+         * @param q_dotdot nr_of_samples x nr_of_joints joint accelerations
+         * @param f_ext the external forces on the segments of every
+         * sample (see KDL::ChainIdSolver_RNE), empty for none
+         * @param torques the resulting nr_of_samples x nr_of_joints
+         * torques, resized if needed
+         *
+         * @return E_NOERROR, E_NOT_UP_TO_DATE or E_SIZE_MISMATCH
+         */
+        int CartToJnt(const Eigen::MatrixXd& q, const Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& q_dotdot,
+                      const std::vector<Wrenches>& f_ext, Eigen::MatrixXd& torques);
+
+        /// Same without external forces
+        int CartToJnt(const Eigen::MatrixXd& q, const Eigen::MatrixXd& q_dot, const Eigen::MatrixXd& q_dotdot,
+                      Eigen::MatrixXd& torques);
+
+        /// Maximum absolute torque of every joint in the last call
+        const Eigen::VectorXd& getPeakTorques() const { return peak; }
+        /// Root mean square torque of every joint in the last call
+        const Eigen::VectorXd& getRmsTorques() const { return rms; }
+
+        unsigned int getNrOfThreads() const { return workers.size(); }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        struct Worker {
+            Worker(const Chain& chain, const Vector& grav);
+            ChainIdSolver_RNE idsolver;
+            JntArray q, q_dot, q_dotdot, torques;
+            Wrenches f_ext;
+            std::thread thread;
+        };
+
+        void workerLoop(Worker& worker, unsigned int seen);
+        void solveChunks(Worker& worker);
+
+        const Chain& chain;
+        unsigned int nj;
+        unsigned int ns;
+        Eigen::VectorXd peak;
+        Eigen::VectorXd rms;
+        const std::vector<Wrenches> no_f_ext;
+
+        // state of the current call, shared with the workers
+        std::vector<Worker*> workers;
+        const Eigen::MatrixXd* q_in;
+        const Eigen::MatrixXd* q_dot_in;
+        const Eigen::MatrixXd* q_dotdot_in;
+        const std::vector<Wrenches>* f_ext_in;
+        Eigen::MatrixXd* torques_out;
+        std::atomic<unsigned int> next_chunk;
+        std::atomic<int> worker_error;
+
+        // thread pool synchronisation
+        std::mutex mutex;
+        std::condition_variable work_cv;
+        std::condition_variable done_cv;
+        unsigned int generation;
+        unsigned int nr_busy;
+        bool shutdown;
+    };
+
+}
+
+#endif
@@ -0,0 +1,165 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainidsolver_recursive_newton_euler_derivatives.hpp"
+
+namespace KDL{
+
+    ChainIdSolver_RNE_Derivatives::ChainIdSolver_RNE_Derivatives(const Chain& chain_,Vector grav):
+        chain(chain_),nj(chain.getNrOfJoints()),ns(chain.getNrOfSegments()),
+        X(ns),S(ns),v(ns),a(ns),f(ns),
+        dv_dq(nj),da_dq(nj),dv_dqdot(nj),da_dqdot(nj),da_dqdotdot(nj),
+        df_dq(ns*nj),df_dqdot(ns*nj),df_dqdotdot(ns*nj),
+        dtau_dq(nj,nj),dtau_dqdot(nj,nj),dtau_dqdotdot(nj,nj)
+    {
+        ag=-Twist(grav,Vector::Zero());
+    }
+
+    void ChainIdSolver_RNE_Derivatives::updateInternalDataStructures() {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        X.resize(ns);
+        S.resize(ns);
+        v.resize(ns);
+        a.resize(ns);
+        f.resize(ns);
+        dv_dq.resize(nj);
+        da_dq.resize(nj);
+        dv_dqdot.resize(nj);
+        da_dqdot.resize(nj);
+        da_dqdotdot.resize(nj);
+        df_dq.resize(ns*nj);
+        df_dqdot.resize(ns*nj);
+        df_dqdotdot.resize(ns*nj);
+        dtau_dq.resize(nj,nj);
+        dtau_dqdot.resize(nj,nj);
+        dtau_dqdotdot.resize(nj,nj);
+    }
+
+    int ChainIdSolver_RNE_Derivatives::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques)
+    {
+        return CartToJnt(q, q_dot, q_dotdot, f_ext, torques, dtau_dq, dtau_dqdot, dtau_dqdotdot);
+    }
+
+    int ChainIdSolver_RNE_Derivatives::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques,
+                                                 Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot, Eigen::MatrixXd& dtorques_dqdotdot)
+    {
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+
+        //Check sizes when in debug mode
+        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=ns)
+            return (error = E_SIZE_MISMATCH);
+        if(dtorques_dq.rows()!=nj || dtorques_dq.cols()!=nj || dtorques_dqdot.rows()!=nj || dtorques_dqdot.cols()!=nj ||
+           dtorques_dqdotdot.rows()!=nj || dtorques_dqdotdot.cols()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        unsigned int j=0;
+
+        //Sweep from root to leaf
+        for(unsigned int i=0;i<ns;i++){
+            double q_,qdot_,qdotdot_;
+            const bool moving=chain.getSegment(i).getJoint().getType()!=Joint::Fixed;
+            if(moving) {
+                q_=q(j);
+                qdot_=q_dot(j);
+                qdotdot_=q_dotdot(j);
+            }else
+                q_=qdot_=qdotdot_=0.0;
+
+            //Same as ChainIdSolver_RNE
+            X[i]=chain.getSegment(i).pose(q_);
+            S[i]=X[i].M.Inverse(chain.getSegment(i).twist(q_,1.0));
+            const Twist vj=S[i]*qdot_;
+            const Twist v_parent=(i==0) ? Twist::Zero() : X[i].Inverse(v[i-1]);
+            const Twist a_parent=X[i].Inverse((i==0) ? ag : a[i-1]);
+            v[i]=v_parent+vj;
+            a[i]=a_parent+S[i]*qdotdot_+v[i]*vj;
+            const RigidBodyInertia& Ii=chain.getSegment(i).getInertia();
+            const Wrench Iv=Ii*v[i];
+            f[i]=Ii*a[i]+v[i]*Iv-f_ext[i];
+
+            //Derivatives with respect to the joints before this segment,
+            //the motion subspace S is constant in the segment frame
+            for(unsigned int k=0;k<j;k++){
+                dv_dq[k]=X[i].Inverse(dv_dq[k]);
+                da_dq[k]=X[i].Inverse(da_dq[k])+dv_dq[k]*vj;
+                dv_dqdot[k]=X[i].Inverse(dv_dqdot[k]);
+                da_dqdot[k]=X[i].Inverse(da_dqdot[k])+dv_dqdot[k]*vj;
+                da_dqdotdot[k]=X[i].Inverse(da_dqdotdot[k]);
+            }
+            //and with respect to the joint of this segment, d(X^-1*t)/dq = (X^-1*t) x S
+            if(moving){
+                dv_dq[j]=v_parent*S[i];
+                da_dq[j]=a_parent*S[i]+dv_dq[j]*vj;
+                dv_dqdot[j]=S[i];
+                da_dqdot[j]=v[i]*S[i];
+                da_dqdotdot[j]=S[i];
+                j++;
+            }
+            Wrench* df_dq_i=&df_dq[i*nj];
+            Wrench* df_dqdot_i=&df_dqdot[i*nj];
+            Wrench* df_dqdotdot_i=&df_dqdotdot[i*nj];
+            for(unsigned int k=0;k<j;k++){
+                df_dq_i[k]=Ii*da_dq[k]+dv_dq[k]*Iv+v[i]*(Ii*dv_dq[k]);
+                df_dqdot_i[k]=Ii*da_dqdot[k]+dv_dqdot[k]*Iv+v[i]*(Ii*dv_dqdot[k]);
+                df_dqdotdot_i[k]=Ii*da_dqdotdot[k];
+            }
+            //the joints after this segment come in during the backward sweep
+            for(unsigned int k=j;k<nj;k++){
+                df_dq_i[k]=Wrench::Zero();
+                df_dqdot_i[k]=Wrench::Zero();
+                df_dqdotdot_i[k]=Wrench::Zero();
+            }
+        }
+        //Sweep from leaf to root
+        j=nj-1;
+        for(int i=ns-1;i>=0;i--){
+            const Wrench* df_dq_i=&df_dq[i*nj];
+            const Wrench* df_dqdot_i=&df_dqdot[i*nj];
+            const Wrench* df_dqdotdot_i=&df_dqdotdot[i*nj];
+            const bool moving=chain.getSegment(i).getJoint().getType()!=Joint::Fixed;
+            if(moving) {
+                torques(j)=dot(S[i],f[i]);
+                torques(j)+=chain.getSegment(i).getJoint().getInertia()*q_dotdot(j);  // add torque from joint inertia
+                for(unsigned int k=0;k<nj;k++){
+                    dtorques_dq(j,k)=dot(S[i],df_dq_i[k]);
+                    dtorques_dqdot(j,k)=dot(S[i],df_dqdot_i[k]);
+                    dtorques_dqdotdot(j,k)=dot(S[i],df_dqdotdot_i[k]);
+                }
+                dtorques_dqdotdot(j,j)+=chain.getSegment(i).getJoint().getInertia();
+            }
+            if(i!=0){
+                Wrench* df_dq_p=&df_dq[(i-1)*nj];
+                Wrench* df_dqdot_p=&df_dqdot[(i-1)*nj];
+                Wrench* df_dqdotdot_p=&df_dqdotdot[(i-1)*nj];
+                for(unsigned int k=0;k<nj;k++){
+                    df_dq_p[k]=df_dq_p[k]+X[i]*df_dq_i[k];
+                    df_dqdot_p[k]=df_dqdot_p[k]+X[i]*df_dqdot_i[k];
+                    df_dqdotdot_p[k]=df_dqdotdot_p[k]+X[i]*df_dqdotdot_i[k];
+                }
+                //d(X*f)/dq = X*(S x* f)
+                if(moving)
+                    df_dq_p[j]=df_dq_p[j]+X[i]*(S[i]*f[i]);
+                f[i-1]=f[i-1]+X[i]*f[i];
+            }
+            if(moving)
+                --j;
+        }
+        return (error = E_NOERROR);
+    }
+}//namespace
@@ -0,0 +1,98 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_CHAIN_IDSOLVER_RECURSIVE_NEWTON_EULER_DERIVATIVES_HPP
+#define KDL_CHAIN_IDSOLVER_RECURSIVE_NEWTON_EULER_DERIVATIVES_HPP
+
+#include "chainidsolver.hpp"
+#include <Eigen/Core>
+
+namespace KDL{
+    /**
+     * \brief Recursive newton euler inverse dynamics solver with the
+     * analytical partial derivatives of the torques.
+     *
+     * Next to the torques of ChainIdSolver_RNE it returns d(tau)/dq,
+     * d(tau)/dq_dot and d(tau)/dq_dotdot, the latter being the
+     * joint-space inertia matrix. The derivatives are propagated in
+     * forward mode along with the RNE sweeps: every segment carries the
+     * derivatives of its velocity, acceleration and force with respect
+     * to the joints up to it, using d(X)/dq = X*(S x) for the segment
+     * transformation. This is O(nj*ns), without the noise of finite
+     * differences and without 2*nj extra RNE calls.
+     *
+     * External forces are taken constant in the segment frames.
+     */
+    class ChainIdSolver_RNE_Derivatives : public ChainIdSolver{
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param chain The kinematic chain to calculate the inverse dynamics for, an internal copy will be made.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        ChainIdSolver_RNE_Derivatives(const Chain& chain,Vector grav);
+        ~ChainIdSolver_RNE_Derivatives(){};
+
+        /**
+         * Function to calculate from Cartesian forces to joint torques,
+         * the same as ChainIdSolver_RNE::CartToJnt().
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques);
+
+        /**
+         * Function to calculate the joint torques and their partial
+         * derivatives.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param q_dotdot The current joint accelerations
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param torques the resulting torques for the joints
+         * \param dtorques_dq nj x nj matrix, element (i,j) is d(torques(i))/d(q(j))
+         * \param dtorques_dqdot nj x nj matrix, element (i,j) is d(torques(i))/d(q_dot(j))
+         * \param dtorques_dqdotdot nj x nj matrix, element (i,j) is d(torques(i))/d(q_dotdot(j))
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques,
+                      Eigen::MatrixXd& dtorques_dq, Eigen::MatrixXd& dtorques_dqdot, Eigen::MatrixXd& dtorques_dqdotdot);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIdSolver_RNE_Derivatives* clone() const { return new ChainIdSolver_RNE_Derivatives(*this); }
+
+    private:
+        const Chain& chain;
+        unsigned int nj;
+        unsigned int ns;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> a;
+        std::vector<Wrench> f;
+        //derivatives of v and a of the current segment, one per joint
+        std::vector<Twist> dv_dq, da_dq, dv_dqdot, da_dqdot, da_dqdotdot;
+        //derivatives of f, ns x nj, segment major
+        std::vector<Wrench> df_dq, df_dqdot, df_dqdotdot;
+        Eigen::MatrixXd dtau_dq, dtau_dqdot, dtau_dqdotdot;
+        Twist ag;
+    };
+}
+
+#endif
@@ -33,6 +33,9 @@ class ChainIdSolver_Vereshchagin : public ChainHdSolver_Vereshchagin
 {
 public:
     ChainIdSolver_Vereshchagin(const Chain& chain, const Twist &root_acc, const unsigned int nc);
+
+    /// @copydoc KDL::SolverI::clone
+    virtual ChainIdSolver_Vereshchagin* clone() const { return new ChainIdSolver_Vereshchagin(*this); }
 };
 
 }
@@ -0,0 +1,216 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainikseedcache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace KDL {
+
+    static const char CACHE_FILE_MAGIC[8] = {'K', 'D', 'L', 'I', 'K', 'S', 'C', '1'};
+
+    ChainIkSeedCache::ChainIkSeedCache(unsigned int _nj, double _voxel_size, double _rot_weight,
+                                       double _max_distance, unsigned int _max_entries):
+        nj(_nj),
+        //a voxel_size that is not positive would divide by zero in voxelIndex()
+        voxel_size(_voxel_size > 0 ? _voxel_size : 0.05),
+        rot_weight(_rot_weight),
+        max_distance(_max_distance > 0 ? _max_distance : 0),
+        max_entries(std::max(1u, _max_entries)),
+        oldest(0),
+        nr_queries(0),
+        nr_hits(0)
+    {
+        assert(_voxel_size > 0 && _max_distance >= 0);
+    }
+
+    void ChainIkSeedCache::voxelIndex(const Vector& v, long long& i, long long& j, long long& k) const
+    {
+        i = (long long)std::floor(v.x() / voxel_size);
+        j = (long long)std::floor(v.y() / voxel_size);
+        k = (long long)std::floor(v.z() / voxel_size);
+    }
+
+    long long ChainIkSeedCache::voxelKey(long long i, long long j, long long k) const
+    {
+        //21 bits per axis, far away voxels may share a key which only
+        //costs some extra distance evaluations
+        const long long mask = (1LL << 21) - 1;
+        return ((i & mask) << 42) | ((j & mask) << 21) | (k & mask);
+    }
+
+    double ChainIkSeedCache::distance(const Frame& p1, const Frame& p2) const
+    {
+        Vector axis;
+        const double angle = (p1.M.Inverse() * p2.M).GetRotAngle(axis);
+        return (p2.p - p1.p).Norm() + rot_weight * angle;
+    }
+
+    void ChainIkSeedCache::removeFromVoxel(unsigned int index)
+    {
+        std::vector<unsigned int>& voxel = voxels[entries[index].key];
+        voxel.erase(std::find(voxel.begin(), voxel.end(), index));
+        if (voxel.empty())
+            voxels.erase(entries[index].key);
+    }
+
+    bool ChainIkSeedCache::insert(const Frame& p, const JntArray& q)
+    {
+        if (q.rows() != nj)
+            return false;
+
+        long long i, j, k;
+        voxelIndex(p.p, i, j, k);
+        Entry entry = {p, q, voxelKey(i, j, k)};
+
+        unsigned int index;
+        if (entries.size() < max_entries) {
+            index = entries.size();
+            entries.push_back(entry);
+        } else {
+            //Replace the oldest entry
+            index = oldest;
+            oldest = (oldest + 1) % max_entries;
+            removeFromVoxel(index);
+            entries[index] = entry;
+        }
+        voxels[entry.key].push_back(index);
+        return true;
+    }
+
+    bool ChainIkSeedCache::nearest(const Frame& p, JntArray& q_seed)
+    {
+        double d;
+        return nearest(p, q_seed, d);
+    }
+
+    bool ChainIkSeedCache::nearest(const Frame& p, JntArray& q_seed, double& d_out)
+    {
+        nr_queries++;
+
+        //Poses within max_distance lie within max_distance in position
+        const long long r = (long long)std::ceil(max_distance / voxel_size);
+        long long i0, j0, k0;
+        voxelIndex(p.p, i0, j0, k0);
+
+        int best = -1;
+        double d_best = max_distance;
+        for (long long i = i0 - r; i <= i0 + r; i++)
+            for (long long j = j0 - r; j <= j0 + r; j++)
+                for (long long k = k0 - r; k <= k0 + r; k++) {
+                    std::unordered_map<long long, std::vector<unsigned int> >::const_iterator voxel = voxels.find(voxelKey(i, j, k));
+                    if (voxel == voxels.end())
+                        continue;
+                    for (unsigned int n = 0; n < voxel->second.size(); n++) {
+                        const unsigned int index = voxel->second[n];
+                        const double d = distance(p, entries[index].p);
+                        if (d <= d_best) {
+                            best = index;
+                            d_best = d;
+                        }
+                    }
+                }
+
+        if (best < 0)
+            return false;
+        nr_hits++;
+        q_seed = entries[best].q;
+        d_out = d_best;
+        return true;
+    }
+
+    void ChainIkSeedCache::clear()
+    {
+        entries.clear();
+        voxels.clear();
+        oldest = 0;
+    }
+
+    void ChainIkSeedCache::resetStatistics()
+    {
+        nr_queries = 0;
+        nr_hits = 0;
+    }
+
+    bool ChainIkSeedCache::save(const std::string& filename) const
+    {
+        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        const unsigned int count = entries.size();
+        file.write(CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+        file.write(reinterpret_cast<const char*>(&nj), sizeof(nj));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        //From the oldest to the newest entry
+        for (unsigned int n = 0; n < count; n++) {
+            const Entry& entry = entries[(oldest + n) % count];
+            file.write(reinterpret_cast<const char*>(entry.p.p.data), 3 * sizeof(double));
+            file.write(reinterpret_cast<const char*>(entry.p.M.data), 9 * sizeof(double));
+            file.write(reinterpret_cast<const char*>(entry.q.data.data()), nj * sizeof(double));
+        }
+        return file.good();
+    }
+
+    bool ChainIkSeedCache::load(const std::string& filename)
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        if (!file)
+            return false;
+
+        char magic[sizeof(CACHE_FILE_MAGIC)];
+        unsigned int file_nj, count;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&file_nj), sizeof(file_nj));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file || std::memcmp(magic, CACHE_FILE_MAGIC, sizeof(magic)) != 0 || file_nj != nj)
+            return false;
+
+        //The entries have to fill the rest of the file, so that a corrupt
+        //count cannot make us allocate more than the file holds
+        const std::streampos begin = file.tellg();
+        file.seekg(0, std::ios::end);
+        const unsigned long long entry_size = (12 + (unsigned long long)nj) * sizeof(double);
+        if (!file || (unsigned long long)(file.tellg() - begin) != count * entry_size)
+            return false;
+
+        //Only the newest max_entries entries are kept
+        const unsigned int skip = count > max_entries ? count - max_entries : 0;
+        count -= skip;
+        file.seekg(begin + std::streamoff(skip * entry_size));
+        std::vector<Frame> poses(count);
+        std::vector<JntArray> solutions(count, JntArray(nj));
+        for (unsigned int n = 0; n < count; n++) {
+            file.read(reinterpret_cast<char*>(poses[n].p.data), 3 * sizeof(double));
+            file.read(reinterpret_cast<char*>(poses[n].M.data), 9 * sizeof(double));
+            file.read(reinterpret_cast<char*>(solutions[n].data.data()), nj * sizeof(double));
+        }
+        if (!file)
+            return false;
+
+        clear();
+        for (unsigned int n = 0; n < count; n++)
+            insert(poses[n], solutions[n]);
+        return true;
+    }
+
+}
@@ -0,0 +1,143 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSEEDCACHE_HPP
+#define KDLCHAINIKSEEDCACHE_HPP
+
+#include "frames.hpp"
+#include "jntarray.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * Cache of solved inverse kinematics problems (pose -> joint
+     * positions), used to seed an inverse position solver with the
+     * solution of the nearest pose solved before.
+     *
+     * The distance between two poses is the distance between their
+     * origins plus rot_weight times the angle of their relative
+     * rotation, so rot_weight is the length that counts as much as one
+     * radian. The entries are hashed on a grid of cubic voxels over
+     * their position; a query only visits the voxels within
+     * max_distance of the requested position.
+     *
+     * The cache holds at most max_entries entries, when full the oldest
+     * one is replaced. It can be saved to and loaded from a binary file
+     * in the byte order of the machine.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSeedCache
+    {
+    public:
+        /**
+         * @param nj number of joints of the cached solutions
+         * @param voxel_size edge length of the voxels of the spatial hash,
+         * > 0, the default is used otherwise
+         * @param rot_weight weight of the rotation angle in the distance
+         * @param max_distance maximum distance of a returned seed, >= 0,
+         * 0 is used otherwise
+         * @param max_entries maximum number of cached solutions
+         */
+        ChainIkSeedCache(unsigned int nj, double voxel_size=0.05, double rot_weight=0.1,
+                         double max_distance=0.1, unsigned int max_entries=10000);
+
+        /**
+         * Store the solution q of pose p.
+         *
+         * @return false if the size of q does not match the cache
+         */
+        bool insert(const Frame& p, const JntArray& q);
+
+        /**
+         * Look up the solution of the cached pose nearest to p.
+         *
+         * @param p requested pose
+         * @param q_seed set to the cached solution on a hit
+         * @param distance set to the distance of the cached pose on a hit
+         *
+         * @return true on a hit, false if no pose lies within max_distance
+         */
+        bool nearest(const Frame& p, JntArray& q_seed, double& distance);
+        bool nearest(const Frame& p, JntArray& q_seed);
+
+        /// Distance between two poses as used by the cache
+        double distance(const Frame& p1, const Frame& p2) const;
+
+        /// Remove all entries, the statistics are kept
+        void clear();
+
+        unsigned int getNrOfJoints() const { return nj; }
+        unsigned int size() const { return entries.size(); }
+        unsigned int getMaxEntries() const { return max_entries; }
+        double getMaxDistance() const { return max_distance; }
+
+        /// Number of nearest() calls and hits since the last reset
+        unsigned int getNrOfQueries() const { return nr_queries; }
+        unsigned int getNrOfHits() const { return nr_hits; }
+        /// Fraction of the queries that were hits, 0 without queries
+        double getHitRate() const { return nr_queries == 0 ? 0.0 : double(nr_hits) / nr_queries; }
+        void resetStatistics();
+
+        /**
+         * Write all entries to a binary file.
+         *
+         * @return false if the file could not be written
+         */
+        bool save(const std::string& filename) const;
+
+        /**
+         * Replace the entries by the ones in a file written by save(),
+         * keeping the newest max_entries.
+         *
+         * @return false if the file could not be read or holds solutions
+         * for another number of joints; the cache is then unchanged
+         */
+        bool load(const std::string& filename);
+
+    private:
+        struct Entry {
+            Frame p;
+            JntArray q;
+            long long key;
+        };
+
+        long long voxelKey(long long i, long long j, long long k) const;
+        void voxelIndex(const Vector& v, long long& i, long long& j, long long& k) const;
+        void removeFromVoxel(unsigned int index);
+
+        unsigned int nj;
+        double voxel_size;
+        double rot_weight;
+        double max_distance;
+        unsigned int max_entries;
+
+        std::vector<Entry> entries;
+        unsigned int oldest;
+        std::unordered_map<long long, std::vector<unsigned int> > voxels;
+
+        unsigned int nr_queries;
+        unsigned int nr_hits;
+    };
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainiksolverpos_cached.hpp"
+
+namespace KDL {
+
+    ChainIkSolverPos_cached::ChainIkSolverPos_cached(ChainIkSolverPos& _iksolver, ChainIkSeedCache& _cache):
+        iksolver(_iksolver),
+        cache(_cache),
+        q_seed(_cache.getNrOfJoints()),
+        used_cached_seed(false)
+    {
+    }
+
+    ChainIkSolverPos_cached::~ChainIkSolverPos_cached()
+    {
+    }
+
+    void ChainIkSolverPos_cached::updateInternalDataStructures()
+    {
+        iksolver.updateInternalDataStructures();
+        q_seed.resize(cache.getNrOfJoints());
+    }
+
+    int ChainIkSolverPos_cached::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        used_cached_seed = false;
+        if (q_init.rows() != cache.getNrOfJoints() || q_out.rows() != cache.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+
+        if (cache.nearest(p_in, q_seed)) {
+            error = iksolver.CartToJnt(q_seed, p_in, q_out);
+            if (error == E_NOERROR) {
+                used_cached_seed = true;
+                cache.insert(p_in, q_out);
+                return error;
+            }
+        }
+
+        error = iksolver.CartToJnt(q_init, p_in, q_out);
+        if (error == E_NOERROR)
+            cache.insert(p_in, q_out);
+        return error;
+    }
+
+    const char* ChainIkSolverPos_cached::strError(const int error) const
+    {
+        return iksolver.strError(error);
+    }
+
+}
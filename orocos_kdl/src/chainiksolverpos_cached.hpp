@@ -0,0 +1,72 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_CACHED_HPP
+#define KDLCHAINIKSOLVERPOS_CACHED_HPP
+
+#include "chainiksolver.hpp"
+#include "chainikseedcache.hpp"
+
+namespace KDL {
+
+    /**
+     * Inverse position kinematics through another inverse position
+     * solver (e.g. KDL::ChainIkSolverPos_NR_JL), seeded from a
+     * KDL::ChainIkSeedCache. The solver first starts from the cached
+     * solution nearest to the requested pose, and falls back to q_init
+     * if there is none or it does not converge. Every solution found is
+     * added to the cache.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_cached : public ChainIkSolverPos
+    {
+    public:
+        /**
+         * @param iksolver the solver doing the work, its chain must
+         * have the number of joints of the cache
+         * @param cache the cache to seed from and add solutions to
+         */
+        ChainIkSolverPos_cached(ChainIkSolverPos& iksolver, ChainIkSeedCache& cache);
+        ~ChainIkSolverPos_cached();
+
+        /**
+         * @return the result of the last call to the wrapped solver,
+         *         E_SIZE_MISMATCH if the size of the input/output data
+         *         does not match the cache.
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /// True if the last call returned a solution found from a cached seed
+        bool getUsedCachedSeed() const { return used_cached_seed; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+    private:
+        ChainIkSolverPos& iksolver;
+        ChainIkSeedCache& cache;
+        JntArray q_seed;
+        bool used_cached_seed;
+    };
+
+}
+
+#endif
@@ -79,7 +79,9 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 	diffq(nj),
 	q_new(nj),
 	original_Aii(nj)
-{}
+{
+	invalidate_fwdpos();
+}
 
 ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 		const KDL::Chain& _chain,
@@ -117,6 +119,7 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 	L(3)=0.01;
 	L(4)=0.01;
 	L(5)=0.01;
+	invalidate_fwdpos();
 }
 
 void ChainIkSolverPos_LMA::updateInternalDataStructures() {
@@ -134,15 +137,42 @@ void ChainIkSolverPos_LMA::updateInternalDataStructures() {
     diffq.conservativeResize(nj);
     q_new.conservativeResize(nj);
     original_Aii.conservativeResize(nj);
+    invalidate_fwdpos();
+}
+
+void ChainIkSolverPos_LMA::invalidate_fwdpos() {
+    T_base_jointtwist.resize(nj);
+    joint_segment.resize(nj);
+    q_fwdpos.resize(nj);
+    unsigned int jointndx=0;
+    for (unsigned int i=0;i<chain.getNrOfSegments() && jointndx<nj;i++) {
+        if (chain.getSegment(i).getJoint().getType()!=Joint::Fixed)
+            joint_segment[jointndx++] = i;
+    }
+    fwdpos_valid = 0;
+    jacobian_valid = 0;
 }
 
 ChainIkSolverPos_LMA::~ChainIkSolverPos_LMA() {}
 
 void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
 	using namespace KDL;
+	// first joint that differs from the previous call, the frames before
+	// its segment are still valid
 	unsigned int jointndx=0;
+	while (jointndx<fwdpos_valid && q(jointndx)==q_fwdpos(jointndx))
+		jointndx++;
+	if (jointndx==nj && fwdpos_valid==nj)
+		return;
+	if (jacobian_valid>jointndx)
+		jacobian_valid=jointndx;
+	unsigned int start=0;
 	T_base_head = Frame::Identity(); // frame w.r.t. base of head
-	for (unsigned int i=0;i<chain.getNrOfSegments();i++) {
+	if (jointndx>0) {
+		T_base_head = T_base_jointtip[jointndx-1];
+		start = joint_segment[jointndx-1]+1;
+	}
+	for (unsigned int i=start;i<chain.getNrOfSegments();i++) {
 		const Segment& segment = chain.getSegment(i);
         if (segment.getJoint().getType()!=Joint::Fixed) {
 			T_base_jointroot[jointndx] = T_base_head;
@@ -153,24 +183,26 @@ void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
 			T_base_head = T_base_head * segment.pose(0.0);
 		}
 	}
+	q_fwdpos = q;
+	fwdpos_valid = nj;
 }
 
 void ChainIkSolverPos_LMA::compute_jacobian(const VectorXq& q) {
 	using namespace KDL;
-	unsigned int jointndx=0;
-	for (unsigned int i=0;i<chain.getNrOfSegments();i++) {
-		const Segment& segment = chain.getSegment(i);
-        if (segment.getJoint().getType()!=Joint::Fixed) {
-			// compute twist of the end effector motion caused by joint [jointndx]; expressed in base frame, with vel. ref. point equal to the end effector
-			KDL::Twist t = ( T_base_jointroot[jointndx].M * segment.twist(q(jointndx),1.0) ).RefPoint( T_base_head.p - T_base_jointtip[jointndx].p);
-			jac(0,jointndx)=t[0];
-			jac(1,jointndx)=t[1];
-			jac(2,jointndx)=t[2];
-			jac(3,jointndx)=t[3];
-			jac(4,jointndx)=t[4];
-			jac(5,jointndx)=t[5];
-			jointndx++;
-		}
+	for (unsigned int jointndx=jacobian_valid;jointndx<nj;jointndx++) {
+		const Segment& segment = chain.getSegment(joint_segment[jointndx]);
+		T_base_jointtwist[jointndx] = T_base_jointroot[jointndx].M * segment.twist(q(jointndx),1.0);
+	}
+	jacobian_valid = nj;
+	for (unsigned int jointndx=0;jointndx<nj;jointndx++) {
+		// compute twist of the end effector motion caused by joint [jointndx]; expressed in base frame, with vel. ref. point equal to the end effector
+		KDL::Twist t = T_base_jointtwist[jointndx].RefPoint( T_base_head.p - T_base_jointtip[jointndx].p);
+		jac(0,jointndx)=t[0];
+		jac(1,jointndx)=t[1];
+		jac(2,jointndx)=t[2];
+		jac(3,jointndx)=t[3];
+		jac(4,jointndx)=t[4];
+		jac(5,jointndx)=t[5];
 	}
 }
 
@@ -224,9 +256,14 @@ int ChainIkSolverPos_LMA::CartToJnt(const KDL::JntArray& q_init, const KDL::Fram
 
 	lambda = tau;
 	double dnorm = 1;
+	// a rejected step only changes lambda, the jacobian and its SVD stay the same
+	bool jac_changed = true;
 	for (unsigned int i=0;i<maxiter;++i) {
 
-		svd.compute(jac);
+		if (jac_changed) {
+			svd.compute(jac);
+			jac_changed = false;
+		}
 		original_Aii = svd.singularValues();
 		for (unsigned int j=0;j<original_Aii.rows();++j) {
 			original_Aii(j) = original_Aii(j)/( original_Aii(j)*original_Aii(j)+lambda);
@@ -296,6 +333,7 @@ int ChainIkSolverPos_LMA::CartToJnt(const KDL::JntArray& q_init, const KDL::Fram
 			}
 			compute_jacobian(q_new);
 			jac = L.asDiagonal()*jac;
+			jac_changed = true;
 			double tmp=2*rho-1;
 			lambda = lambda*max(1/3.0, 1-tmp*tmp*tmp);
 			v = 2;
@@ -134,6 +134,8 @@ public:
      * \brief for internal use only.
      *
      * Only exposed for test and diagnostic purposes.
+     * Only the segments from the first joint that differs from the
+     * previous call onward are recomputed.
      */
     void compute_fwdpos(const VectorXq& q);
 
@@ -141,9 +143,20 @@ public:
      * \brief for internal use only.
      * Only exposed for test and diagnostic purposes.
      * compute_fwdpos(q) should always have been called before.
+     * The joint twists of the joints left unchanged by compute_fwdpos
+     * are reused.
      */
     void compute_jacobian(const VectorXq& q);
 
+    /**
+     * \brief forget the frames and twists cached by compute_fwdpos and
+     * compute_jacobian, the next call recomputes the whole chain.
+     *
+     * Needed when the segments of the chain are modified without a call
+     * to updateInternalDataStructures().
+     */
+    void invalidate_fwdpos();
+
     /**
      * \brief for internal use only.
      * Only exposed for test and diagnostic purposes.
@@ -153,6 +166,9 @@ public:
     /// @copydoc KDL::SolverI::updateInternalDataStructures
     void updateInternalDataStructures();
 
+    /// @copydoc KDL::SolverI::clone
+    virtual ChainIkSolverPos_LMA* clone() const { return new ChainIkSolverPos_LMA(*this); }
+
     /// @copydoc KDL::SolverI::strError()
     virtual const char* strError(const int error) const;
 
@@ -225,6 +241,15 @@ private:
     // state of compute_fwdpos and compute_jacobian:
     std::vector<KDL::Frame> T_base_jointroot;
     std::vector<KDL::Frame> T_base_jointtip;
+    // twists of the joints in the base frame, ref. point at the joint tip
+    std::vector<KDL::Twist> T_base_jointtwist;
+    // segment index of each joint
+    std::vector<unsigned int> joint_segment;
+    // joint values of the last compute_fwdpos and the number of joints
+    // for which the frames and the twists are up to date
+    VectorXq q_fwdpos;
+    unsigned int fwdpos_valid;
+    unsigned int jacobian_valid;
 					// need 2 vectors because of the somewhat strange definition of segment.hpp
 					// you could also recompute jointtip out of jointroot,
     				// but then you'll need more expensive cos/sin functions.
@@ -0,0 +1,287 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainiksolverpos_multistart.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace KDL {
+
+    // Number of local solver iterations between two checks for cancellation
+    static const unsigned int CHUNK_ITERATIONS = 10;
+
+    static double jointDistance(const JntArray& q_sol, const JntArray& q_init)
+    {
+        return (q_sol.data - q_init.data).squaredNorm();
+    }
+
+    ChainIkSolverPos_MultiStart::Worker::Worker(const Chain& chain, const JntArray& q_min, const JntArray& q_max,
+                                                unsigned int chunk, unsigned int maxiter, double eps):
+        fksolver(chain),
+        iksolver(chain),
+        nr_jl(chain, q_min, q_max, fksolver, iksolver, chunk, eps),
+        lma(chain, eps, maxiter),
+        q(chain.getNrOfJoints()),
+        q_next(chain.getNrOfJoints())
+    {
+    }
+
+    ChainIkSolverPos_MultiStart::ChainIkSolverPos_MultiStart(const Chain& _chain, const JntArray& _q_min, const JntArray& _q_max,
+                                                             SolverType _type, unsigned int nr_of_threads,
+                                                             unsigned int _nr_of_random_seeds,
+                                                             unsigned int _maxiter, double _eps):
+        chain(_chain), nj(chain.getNrOfJoints()),
+        q_min(_q_min), q_max(_q_max),
+        type(_type),
+        nr_of_random_seeds(_nr_of_random_seeds),
+        maxiter(_maxiter),
+        chunk(std::max(1u, std::min(_maxiter, CHUNK_ITERATIONS))),
+        eps(_eps),
+        time_budget(0),
+        stop_at_first_solution(true),
+        cost(jointDistance),
+        next_seed(0), started(0), cancel(false),
+        generation(0), nr_busy(0), shutdown(false),
+        nr_started(0), nr_solutions(0), best_seed(-1), best_cost(0)
+    {
+        updatePeriods();
+        if (nr_of_threads == 0)
+            nr_of_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int i = 0; i < nr_of_threads; i++)
+            workers.push_back(new Worker(chain, q_min, q_max, chunk, maxiter, eps));
+        //The calling thread acts as the first worker. The threads may only
+        //start running after the first call, so they get the generation
+        //of work they have already seen from here.
+        for (unsigned int i = 1; i < nr_of_threads; i++)
+            workers[i]->thread = std::thread(&ChainIkSolverPos_MultiStart::workerLoop, this, std::ref(*workers[i]), generation);
+    }
+
+    ChainIkSolverPos_MultiStart::~ChainIkSolverPos_MultiStart()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shutdown = true;
+        }
+        work_cv.notify_all();
+        for (unsigned int i = 0; i < workers.size(); i++) {
+            if (workers[i]->thread.joinable())
+                workers[i]->thread.join();
+            delete workers[i];
+        }
+    }
+
+    void ChainIkSolverPos_MultiStart::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        q_min.data.conservativeResizeLike(Eigen::VectorXd::Constant(nj, -PI));
+        q_max.data.conservativeResizeLike(Eigen::VectorXd::Constant(nj, PI));
+        for (unsigned int i = 0; i < workers.size(); i++) {
+            Worker& worker = *workers[i];
+            worker.fksolver.updateInternalDataStructures();
+            worker.iksolver.updateInternalDataStructures();
+            worker.nr_jl.updateInternalDataStructures();
+            worker.nr_jl.setJointLimits(q_min, q_max);
+            worker.lma.updateInternalDataStructures();
+            worker.q.resize(nj);
+            worker.q_next.resize(nj);
+        }
+        seeds_added.clear();
+        updatePeriods();
+    }
+
+    void ChainIkSolverPos_MultiStart::updatePeriods()
+    {
+        periods.clear();
+        for (unsigned int i = 0; i < chain.getNrOfSegments(); i++) {
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if (joint.getType() == Joint::Fixed)
+                continue;
+            const bool rotational = joint.getType() == Joint::RotAxis || joint.getType() == Joint::RotX ||
+                joint.getType() == Joint::RotY || joint.getType() == Joint::RotZ;
+            periods.push_back(rotational && joint.getScale() != 0 ? 2 * PI / std::fabs(joint.getScale()) : 0.0);
+        }
+    }
+
+    int ChainIkSolverPos_MultiStart::setJointLimits(const JntArray& q_min_in, const JntArray& q_max_in)
+    {
+        if (q_min_in.rows() != nj || q_max_in.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        q_min = q_min_in;
+        q_max = q_max_in;
+        for (unsigned int i = 0; i < workers.size(); i++)
+            workers[i]->nr_jl.setJointLimits(q_min, q_max);
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_MultiStart::addSeed(const JntArray& q)
+    {
+        if (q.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        seeds_added.push_back(q);
+        return (error = E_NOERROR);
+    }
+
+    void ChainIkSolverPos_MultiStart::clearSeeds()
+    {
+        seeds_added.clear();
+    }
+
+    int ChainIkSolverPos_MultiStart::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+
+        if (q_init.rows() != nj || q_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        //Collect the seeds: q_init, the added ones and random ones within the joint limits
+        const unsigned int nr_of_seeds = 1 + seeds_added.size() + nr_of_random_seeds;
+        seeds.resize(nr_of_seeds, JntArray(nj));
+        solutions.resize(nr_of_seeds, JntArray(nj));
+        converged.assign(nr_of_seeds, 0);
+        seeds[0] = q_init;
+        for (unsigned int i = 0; i < seeds_added.size(); i++)
+            seeds[1 + i] = seeds_added[i];
+        for (unsigned int j = 0; j < nj; j++) {
+            //Unlimited joints are sampled within one turn
+            double lower = std::max(q_min(j), -PI);
+            double upper = std::min(q_max(j), PI);
+            if (lower > upper) {
+                lower = q_min(j);
+                upper = q_max(j);
+            }
+            std::uniform_real_distribution<double> distribution(lower, upper);
+            for (unsigned int i = 1 + seeds_added.size(); i < nr_of_seeds; i++)
+                seeds[i](j) = distribution(rng);
+        }
+
+        p_goal = p_in;
+        next_seed = 0;
+        started = 0;
+        cancel = false;
+        if (time_budget > 0)
+            deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time_budget));
+
+        //Wake up the pool and work along with it
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++generation;
+            nr_busy = workers.size() - 1;
+        }
+        work_cv.notify_all();
+        solveSeeds(*workers[0]);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done_cv.wait(lock, [this] { return nr_busy == 0; });
+        }
+
+        //Select the solution with the lowest cost
+        nr_started = started;
+        nr_solutions = 0;
+        best_seed = -1;
+        best_cost = std::numeric_limits<double>::infinity();
+        for (unsigned int i = 0; i < nr_of_seeds; i++) {
+            if (!converged[i])
+                continue;
+            nr_solutions++;
+            const double c = cost(solutions[i], q_init);
+            if (best_seed < 0 || c < best_cost) {
+                best_seed = i;
+                best_cost = c;
+            }
+        }
+
+        if (best_seed < 0) {
+            q_out = q_init;
+            return (error = E_NO_CONVERGE);
+        }
+        q_out = solutions[best_seed];
+        return (error = E_NOERROR);
+    }
+
+    void ChainIkSolverPos_MultiStart::workerLoop(Worker& worker, unsigned int seen)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work_cv.wait(lock, [&] { return shutdown || generation != seen; });
+            if (shutdown)
+                return;
+            seen = generation;
+            lock.unlock();
+            solveSeeds(worker);
+            lock.lock();
+            if (--nr_busy == 0)
+                done_cv.notify_one();
+        }
+    }
+
+    void ChainIkSolverPos_MultiStart::solveSeeds(Worker& worker)
+    {
+        //LMA restarts its damping on every call, so it only runs in one go
+        const unsigned int nr_of_chunks = type == NR_JL ? (maxiter + chunk - 1) / chunk : 1;
+        while (!cancel) {
+            const unsigned int i = next_seed++;
+            if (i >= seeds.size() || timeBudgetSpent())
+                return;
+            ++started;
+
+            //Run the local solver chunk by chunk, each one continuing
+            //where the previous one stopped
+            worker.q = seeds[i];
+            int ret = E_MAX_ITERATIONS_EXCEEDED;
+            for (unsigned int c = 0; c < nr_of_chunks && ret == E_MAX_ITERATIONS_EXCEEDED; c++) {
+                if (c > 0 && (cancel || timeBudgetSpent()))
+                    break;
+                if (type == NR_JL)
+                    ret = worker.nr_jl.CartToJnt(worker.q, p_goal, worker.q_next);
+                else
+                    ret = worker.lma.CartToJnt(worker.q, p_goal, worker.q_next);
+                worker.q.data.swap(worker.q_next.data);
+            }
+
+            if (ret == E_NOERROR && toLimits(worker.q)) {
+                solutions[i] = worker.q;
+                converged[i] = 1;
+                if (stop_at_first_solution)
+                    cancel = true;
+            }
+        }
+    }
+
+    bool ChainIkSolverPos_MultiStart::toLimits(JntArray& q) const
+    {
+        for (unsigned int j = 0; j < nj; j++) {
+            //Rotational joints may be a number of turns off
+            if (periods[j] > 0 && (q(j) < q_min(j) || q(j) > q_max(j)))
+                q(j) -= periods[j] * std::floor((q(j) - q_min(j)) / periods[j]);
+            if (q(j) < q_min(j) || q(j) > q_max(j))
+                return false;
+        }
+        return true;
+    }
+
+    bool ChainIkSolverPos_MultiStart::timeBudgetSpent() const
+    {
+        return time_budget > 0 && std::chrono::steady_clock::now() >= deadline;
+    }
+
+}
@@ -0,0 +1,222 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_MULTISTART_HPP
+#define KDLCHAINIKSOLVERPOS_MULTISTART_HPP
+
+#include "chainiksolver.hpp"
+#include "chainfksolverpos_recursive.hpp"
+#include "chainiksolvervel_pinv.hpp"
+#include "chainiksolverpos_nr_jl.hpp"
+#include "chainiksolverpos_lma.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * Multi-start inverse position kinematics. A single call runs a
+     * local solver (KDL::ChainIkSolverPos_NR_JL or
+     * KDL::ChainIkSolverPos_LMA) from many seeds concurrently on a pool
+     * of threads: first q_init, then the seeds added with addSeed(),
+     * then uniformly drawn random seeds within the joint limits.
+     *
+     * Every thread owns its own solvers and pulls the next unstarted
+     * seed from a shared counter, so a thread that finishes early keeps
+     * taking work from the others. The remaining work is cancelled as
+     * soon as the first solution within eps arrives (see
+     * setStopAtFirstSolution()) or the time budget is spent (see
+     * setTimeBudget()); NR_JL is run in chunks of a few iterations so
+     * that running seeds stop too, LMA only stops between seeds. Of all
+     * solutions within the joint limits, after shifting rotational
+     * joints by whole turns, the one with the lowest cost is returned;
+     * the default cost is the squared joint space distance to q_init.
+     *
+     * The calling thread takes part in the work, so a pool of one thread
+     * starts no extra threads. A single solver object must not be used
+     * from several threads at once.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_MultiStart : public ChainIkSolverPos
+    {
+    public:
+        /// Local solver run from every seed
+        enum SolverType {NR_JL, LMA};
+
+        /// Cost of solution q_sol for initial joints q_init, lower is better
+        typedef std::function<double(const JntArray& q_sol, const JntArray& q_init)> CostFunction;
+
+        /**
+         * Constructor of the solver
+         *
+         * @param chain the chain to calculate the inverse position for
+         * @param q_min the minimum joint positions
+         * @param q_max the maximum joint positions
+         * @param type the local solver run from every seed
+         * @param nr_of_threads the number of threads working on the
+         * seeds, including the calling one; 0 uses one per hardware thread
+         * @param nr_of_random_seeds the number of random seeds tried
+         * after q_init and the added seeds
+         * @param maxiter the maximum number of local solver iterations
+         * per seed
+         * @param eps the precision of the solution, see the local solver
+         */
+        ChainIkSolverPos_MultiStart(const Chain& chain, const JntArray& q_min, const JntArray& q_max,
+                                    SolverType type=NR_JL, unsigned int nr_of_threads=0,
+                                    unsigned int nr_of_random_seeds=32,
+                                    unsigned int maxiter=100, double eps=1e-6);
+        ~ChainIkSolverPos_MultiStart();
+
+        /**
+         * Find the joint positions for p_in, starting from q_init and the
+         * other seeds.
+         *
+         * @return E_NOERROR if a solution was found, q_out then holds the
+         *         one with the lowest cost,
+         *         E_NO_CONVERGE if no seed converged within the iteration
+         *         and time budget, q_out is then set to q_init,
+         *         E_NOT_UP_TO_DATE if the internal data is not up to date with the chain,
+         *         E_SIZE_MISMATCH if the size of the input/output data does not match the chain.
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /**
+         * @return E_SIZE_MISMATCH if input sizes do not match the chain
+         */
+        int setJointLimits(const JntArray& q_min, const JntArray& q_max);
+
+        /**
+         * Add a seed that is tried right after q_init, e.g. a previous
+         * solution close to the expected one.
+         *
+         * @return E_SIZE_MISMATCH if the size of q does not match the chain
+         */
+        int addSeed(const JntArray& q);
+        void clearSeeds();
+        unsigned int getNrOfSeeds() const { return seeds_added.size(); }
+
+        void setNrOfRandomSeeds(unsigned int n) { nr_of_random_seeds = n; }
+        unsigned int getNrOfRandomSeeds() const { return nr_of_random_seeds; }
+        /// Restart the random seed sequence from the given seed
+        void setRandomSeed(unsigned int seed) { rng.seed(seed); }
+
+        /**
+         * Wall clock time in seconds after which no new seeds are started
+         * and running ones are stopped; 0 (the default) disables the limit.
+         */
+        void setTimeBudget(double seconds) { time_budget = seconds; }
+        double getTimeBudget() const { return time_budget; }
+
+        /**
+         * If true (the default) the remaining work is cancelled as soon
+         * as a seed converges, otherwise all seeds are run and the
+         * solution with the lowest cost is returned.
+         */
+        void setStopAtFirstSolution(bool stop) { stop_at_first_solution = stop; }
+        bool getStopAtFirstSolution() const { return stop_at_first_solution; }
+
+        /// Replace the cost used to select the returned solution
+        void setCostFunction(const CostFunction& cost_in) { cost = cost_in; }
+
+        unsigned int getNrOfThreads() const { return workers.size(); }
+
+        /// Number of seeds started by the last call
+        unsigned int getNrOfStartedSeeds() const { return nr_started; }
+        /// Number of seeds that converged in the last call
+        unsigned int getNrOfSolutions() const { return nr_solutions; }
+        /**
+         * Index of the seed of the returned solution in the last call: 0
+         * for q_init, then the added seeds, then the random ones; -1 if
+         * no seed converged.
+         */
+        int getBestSeed() const { return best_seed; }
+        /// Cost of the returned solution in the last call
+        double getBestCost() const { return best_cost; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        struct Worker {
+            Worker(const Chain& chain, const JntArray& q_min, const JntArray& q_max,
+                   unsigned int chunk, unsigned int maxiter, double eps);
+            ChainFkSolverPos_recursive fksolver;
+            ChainIkSolverVel_pinv iksolver;
+            ChainIkSolverPos_NR_JL nr_jl;
+            ChainIkSolverPos_LMA lma;
+            JntArray q, q_next;
+            std::thread thread;
+        };
+
+        void workerLoop(Worker& worker, unsigned int seen);
+        void solveSeeds(Worker& worker);
+        void updatePeriods();
+        bool toLimits(JntArray& q) const;
+        bool timeBudgetSpent() const;
+
+        const Chain& chain;
+        unsigned int nj;
+        JntArray q_min;
+        JntArray q_max;
+        SolverType type;
+        unsigned int nr_of_random_seeds;
+        unsigned int maxiter;
+        unsigned int chunk;
+        double eps;
+        double time_budget;
+        bool stop_at_first_solution;
+        CostFunction cost;
+        std::mt19937 rng;
+        std::vector<JntArray> seeds_added;
+        std::vector<double> periods;
+
+        // state of the current call, shared with the workers
+        std::vector<Worker*> workers;
+        std::vector<JntArray> seeds;
+        std::vector<JntArray> solutions;
+        std::vector<char> converged;
+        Frame p_goal;
+        std::chrono::steady_clock::time_point deadline;
+        std::atomic<unsigned int> next_seed;
+        std::atomic<unsigned int> started;
+        std::atomic<bool> cancel;
+
+        // thread pool synchronisation
+        std::mutex mutex;
+        std::condition_variable work_cv;
+        std::condition_variable done_cv;
+        unsigned int generation;
+        unsigned int nr_busy;
+        bool shutdown;
+
+        unsigned int nr_started;
+        unsigned int nr_solutions;
+        int best_seed;
+        double best_cost;
+    };
+
+}
+
+#endif
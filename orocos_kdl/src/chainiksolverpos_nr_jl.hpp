@@ -52,7 +52,10 @@ namespace KDL {
          * @param chain the chain to calculate the inverse position for
          * @param q_min the minimum joint positions
          * @param q_max the maximum joint positions
-         * @param fksolver a forward position kinematics solver
+         * @param fksolver a forward position kinematics solver, a
+         * KDL::ChainFkSolverPos_incremental only recomputes the segments
+         * after the first joint changed by an iteration (e.g. proximal
+         * joints held at their limits)
          * @param iksolver an inverse velocity kinematics solver
          * @param maxiter the maximum Newton-Raphson iterations,
          * default: 100
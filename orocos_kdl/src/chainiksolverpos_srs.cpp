@@ -0,0 +1,377 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainiksolverpos_srs.hpp"
+#include "chainjnttojacsolver.hpp"
+
+#include <Eigen/QR>
+#include <cmath>
+#include <limits>
+
+namespace KDL {
+
+    // Rotations are about axes through a common point, all vectors are
+    // relative to that point.
+
+    // Paden-Kahan subproblem 1: angle t such that Rot(w,t)*u equals v
+    static double subproblem1(const Vector& w, const Vector& u, const Vector& v)
+    {
+        const Vector u_p = u - w * dot(w, u);
+        const Vector v_p = v - w * dot(w, v);
+        return atan2(dot(w, u_p * v_p), dot(u_p, v_p));
+    }
+
+    // Paden-Kahan subproblem 2: angles t1, t2 such that
+    // Rot(w1,t1)*Rot(w2,t2)*u equals v, for non parallel w1 and w2. If v
+    // is out of reach the closest solution is returned.
+    static void subproblem2(const Vector& w1, const Vector& w2, const Vector& u, const Vector& v,
+                            bool branch, double& t1, double& t2)
+    {
+        const double w12 = dot(w1, w2);
+        const double den = w12 * w12 - 1;
+        const double alpha = (w12 * dot(w2, u) - dot(w1, v)) / den;
+        const double beta = (w12 * dot(w1, v) - dot(w2, u)) / den;
+        const Vector n = w1 * w2;
+        const double gamma2 = (dot(u, u) - alpha * alpha - beta * beta - 2 * alpha * beta * w12) / dot(n, n);
+        const double gamma = gamma2 > 0 ? (branch ? -1 : 1) * std::sqrt(gamma2) : 0;
+        const Vector c = w1 * alpha + w2 * beta + n * gamma;
+        t2 = subproblem1(w2, u, c);
+        t1 = subproblem1(w1, c, v);
+    }
+
+    // Unit vector perpendicular to w
+    static Vector perpendicular(const Vector& w)
+    {
+        Vector x = std::fabs(w.x()) < 0.6 ? w * Vector(1, 0, 0) : w * Vector(0, 1, 0);
+        x.Normalize();
+        return x;
+    }
+
+    // Point closest to the lines through points p[i] along unit axes a[i]
+    static Vector intersection(const Vector* p, const Vector* a)
+    {
+        Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+        Eigen::Vector3d b = Eigen::Vector3d::Zero();
+        for (unsigned int i = 0; i < 3; i++) {
+            const Eigen::Vector3d ai(a[i].data), pi(p[i].data);
+            const Eigen::Matrix3d P = Eigen::Matrix3d::Identity() - ai * ai.transpose();
+            A += P;
+            b += P * pi;
+        }
+        const Eigen::Vector3d x = A.colPivHouseholderQr().solve(b);
+        return Vector(x(0), x(1), x(2));
+    }
+
+    static double distanceToLine(const Vector& x, const Vector& p, const Vector& a)
+    {
+        return ((x - p) * a).Norm();
+    }
+
+    ChainIkSolverPos_SRS::ChainIkSolverPos_SRS(const Chain& _chain, const JntArray& _q_min, const JntArray& _q_max,
+                                               unsigned int _nr_of_arm_angles, double _eps):
+        chain(_chain), nj(chain.getNrOfJoints()),
+        q_min(_q_min), q_max(_q_max),
+        nr_of_arm_angles(std::max(1u, _nr_of_arm_angles)), eps(_eps),
+        fksolver(_chain),
+        srs(false)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainIkSolverPos_SRS::~ChainIkSolverPos_SRS()
+    {
+    }
+
+    void ChainIkSolverPos_SRS::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        q_min.data.conservativeResizeLike(Eigen::VectorXd::Constant(nj, -PI));
+        q_max.data.conservativeResizeLike(Eigen::VectorXd::Constant(nj, PI));
+        fksolver.updateInternalDataStructures();
+        solutions.assign(8, JntArray(nj));
+        solution_configs.assign(8, 0);
+        nr_of_solutions = 0;
+
+        srs = false;
+        if (nj != 7)
+            return;
+
+        //The unit twists of the joints at zero joint positions give the
+        //axes of the product of exponentials
+        JntArray q_zero(nj);
+        Jacobian jac(nj);
+        ChainJntToJacSolver jacsolver(chain);
+        jacsolver.JntToJac(q_zero, jac);
+        fksolver.JntToCart(q_zero, T_zero);
+        Vector point[7];
+        for (unsigned int i = 0; i < 7; i++) {
+            const Twist t = jac.getColumn(i);
+            rate[i] = t.rot.Norm();
+            //Prismatic joint
+            if (rate[i] < eps)
+                return;
+            axis[i] = t.rot / rate[i];
+            //the reference point of the jacobian is the tip
+            point[i] = T_zero.p + axis[i] * (t.vel / rate[i]);
+        }
+
+        //Shoulder and wrist axes have to intersect, consecutive ones may
+        //not be parallel
+        S = intersection(point, axis);
+        W = intersection(point + 4, axis + 4);
+        for (unsigned int i = 0; i < 3; i++) {
+            if (distanceToLine(S, point[i], axis[i]) > eps || distanceToLine(W, point[4 + i], axis[4 + i]) > eps)
+                return;
+        }
+        if ((axis[0] * axis[1]).Norm() < eps || (axis[1] * axis[2]).Norm() < eps ||
+            (axis[4] * axis[5]).Norm() < eps || (axis[5] * axis[6]).Norm() < eps)
+            return;
+
+        //The elbow has to change the distance between S and W
+        elbow_point = point[3];
+        const Vector u = W - elbow_point;
+        const Vector v = S - elbow_point;
+        const Vector u_p = u - axis[3] * dot(axis[3], u);
+        const Vector v_p = v - axis[3] * dot(axis[3], v);
+        elbow_u = u_p.Norm();
+        elbow_v = v_p.Norm();
+        elbow_h = dot(axis[3], W - S);
+        if (elbow_u < eps || elbow_v < eps)
+            return;
+        elbow_zero = atan2(dot(axis[3], u_p * v_p), dot(u_p, v_p));
+        srs = true;
+    }
+
+    int ChainIkSolverPos_SRS::setJointLimits(const JntArray& q_min_in, const JntArray& q_max_in)
+    {
+        if (q_min_in.rows() != nj || q_max_in.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        q_min = q_min_in;
+        q_max = q_max_in;
+        return (error = E_NOERROR);
+    }
+
+    double ChainIkSolverPos_SRS::elbowAngle(bool branch, double cos_angle) const
+    {
+        //Paden-Kahan subproblem 3: the elbow rotates W about its axis
+        //until the angle between W and S seen from the axis is acos(cos_angle)
+        const double phi = std::acos(std::max(-1.0, std::min(1.0, cos_angle)));
+        return std::remainder(elbow_zero + (branch ? -phi : phi), 2 * PI);
+    }
+
+    Rotation ChainIkSolverPos_SRS::referenceRotation(const Vector& u, const Vector& v) const
+    {
+        //Shoulder rotation with joint 3 at zero that turns u into v
+        double t1, t2;
+        subproblem2(axis[0], axis[1], u, v, false, t1, t2);
+        Rotation R_ref = Rotation::Rot2(axis[0], t1) * Rotation::Rot2(axis[1], t2);
+
+        //If joint 3 is needed to reach v, add the smallest rotation that does
+        Vector r = R_ref * u;
+        Vector n = r * v;
+        const double angle = atan2(n.Normalize(), dot(r, v));
+        if (std::fabs(angle) > std::numeric_limits<double>::epsilon())
+            R_ref = Rotation::Rot2(n, angle) * R_ref;
+        return R_ref;
+    }
+
+    void ChainIkSolverPos_SRS::computeShoulder(const Rotation& R_s, bool branch, double theta[3]) const
+    {
+        subproblem2(axis[0], axis[1], axis[2], R_s * axis[2], branch, theta[0], theta[1]);
+        const Rotation R_12 = Rotation::Rot2(axis[0], theta[0]) * Rotation::Rot2(axis[1], theta[1]);
+        const Vector x = perpendicular(axis[2]);
+        theta[2] = subproblem1(axis[2], x, R_12.Inverse() * (R_s * x));
+    }
+
+    void ChainIkSolverPos_SRS::computeWrist(const Rotation& R_w, bool branch, double theta[3]) const
+    {
+        subproblem2(axis[4], axis[5], axis[6], R_w * axis[6], branch, theta[0], theta[1]);
+        const Rotation R_56 = Rotation::Rot2(axis[4], theta[0]) * Rotation::Rot2(axis[5], theta[1]);
+        const Vector x = perpendicular(axis[6]);
+        theta[2] = subproblem1(axis[6], x, R_56.Inverse() * (R_w * x));
+    }
+
+    int ChainIkSolverPos_SRS::CartToJnt(double arm_angle, const Frame& p_in, std::vector<JntArray>& q_out,
+                                        std::vector<unsigned int>* configs)
+    {
+        if (solveArmAngle(arm_angle, p_in) != E_NOERROR)
+            nr_of_solutions = 0;
+
+        //JntArray assignment keeps the memory of elements of the right size
+        q_out.resize(nr_of_solutions);
+        for (unsigned int n = 0; n < nr_of_solutions; n++)
+            q_out[n] = solutions[n];
+        if (configs)
+            configs->assign(solution_configs.begin(), solution_configs.begin() + nr_of_solutions);
+        return error;
+    }
+
+    int ChainIkSolverPos_SRS::solveArmAngle(double arm_angle, const Frame& p_in)
+    {
+        nr_of_solutions = 0;
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!srs)
+            return (error = E_NOT_SRS);
+
+        //The shoulder and wrist rotations do not move S and W, so the
+        //target of W and its distance to S fix the elbow
+        const Frame g = p_in * T_zero.Inverse();
+        const Vector v = g * W - S;
+        const double d = v.Norm();
+        const double d_p2 = d * d - elbow_h * elbow_h;
+        const double cos_angle = (elbow_u * elbow_u + elbow_v * elbow_v - d_p2) / (2 * elbow_u * elbow_v);
+        if (d < eps || d_p2 < 0 || std::fabs(cos_angle) > 1 + eps)
+            return (error = E_NO_SOLUTION);
+        const Vector n = v / d;
+
+        double theta[7];
+        for (unsigned int elbow = 0; elbow < 2; elbow++) {
+            theta[3] = elbowAngle(elbow, cos_angle);
+            const Rotation R_4 = Rotation::Rot2(axis[3], theta[3]);
+            const Vector u = elbow_point + R_4 * (W - elbow_point) - S;
+            const Rotation R_s = Rotation::Rot2(n, arm_angle) * referenceRotation(u, v);
+
+            for (unsigned int shoulder = 0; shoulder < 2; shoulder++) {
+                computeShoulder(R_s, shoulder, theta);
+                const Rotation R_123 = Rotation::Rot2(axis[0], theta[0]) * Rotation::Rot2(axis[1], theta[1]) *
+                    Rotation::Rot2(axis[2], theta[2]);
+                const Rotation R_w = (R_123 * R_4).Inverse() * g.M;
+
+                for (unsigned int wrist = 0; wrist < 2; wrist++) {
+                    computeWrist(R_w, wrist, theta + 4);
+                    JntArray& q = solutions[nr_of_solutions];
+                    for (unsigned int i = 0; i < 7; i++)
+                        q(i) = theta[i] / rate[i];
+                    solution_configs[nr_of_solutions++] = elbow | (shoulder << 1) | (wrist << 2);
+                }
+            }
+        }
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_SRS::getArmAngle(const JntArray& q, double& arm_angle, unsigned int& config)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!srs)
+            return (error = E_NOT_SRS);
+        if (q.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        double theta[7], branch_theta[3];
+        for (unsigned int i = 0; i < 7; i++)
+            theta[i] = rate[i] * q(i);
+
+        config = std::remainder(theta[3] - elbow_zero, 2 * PI) < 0 ? 1 : 0;
+
+        const Rotation R_s = Rotation::Rot2(axis[0], theta[0]) * Rotation::Rot2(axis[1], theta[1]) *
+            Rotation::Rot2(axis[2], theta[2]);
+        const Rotation R_4 = Rotation::Rot2(axis[3], theta[3]);
+        const Vector u = elbow_point + R_4 * (W - elbow_point) - S;
+        Vector n = R_s * u;
+        const Rotation R_d = R_s * referenceRotation(u, n).Inverse();
+        n.Normalize();
+        const Vector x = perpendicular(n);
+        arm_angle = subproblem1(n, x, R_d * x);
+
+        //The configurations are the branches that reproduce q best
+        double dist[2];
+        for (unsigned int branch = 0; branch < 2; branch++) {
+            computeShoulder(R_s, branch, branch_theta);
+            dist[branch] = 0;
+            for (unsigned int i = 0; i < 3; i++)
+                dist[branch] += std::fabs(std::remainder(branch_theta[i] - theta[i], 2 * PI));
+        }
+        if (dist[1] < dist[0])
+            config |= 2;
+
+        const Rotation R_w = Rotation::Rot2(axis[4], theta[4]) * Rotation::Rot2(axis[5], theta[5]) *
+            Rotation::Rot2(axis[6], theta[6]);
+        for (unsigned int branch = 0; branch < 2; branch++) {
+            computeWrist(R_w, branch, branch_theta);
+            dist[branch] = 0;
+            for (unsigned int i = 0; i < 3; i++)
+                dist[branch] += std::fabs(std::remainder(branch_theta[i] - theta[4 + i], 2 * PI));
+        }
+        if (dist[1] < dist[0])
+            config |= 4;
+
+        return (error = E_NOERROR);
+    }
+
+    bool ChainIkSolverPos_SRS::toLimits(JntArray& q, const JntArray& q_ref) const
+    {
+        for (unsigned int i = 0; i < nj; i++) {
+            //Take the turn closest to q_ref that respects the limits
+            const double turn = 2 * PI / rate[i];
+            q(i) += turn * std::floor((q_ref(i) - q(i)) / turn + 0.5);
+            if (q(i) > q_max(i))
+                q(i) -= turn;
+            else if (q(i) < q_min(i))
+                q(i) += turn;
+            if (q(i) < q_min(i) || q(i) > q_max(i))
+                return false;
+        }
+        return true;
+    }
+
+    int ChainIkSolverPos_SRS::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!srs)
+            return (error = E_NOT_SRS);
+        if (q_init.rows() != nj || q_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+
+        double arm_angle;
+        unsigned int config;
+        getArmAngle(q_init, arm_angle, config);
+
+        //Arm angles in the order arm_angle, +step, -step, +2 step, ...
+        const double step = 2 * PI / nr_of_arm_angles;
+        for (unsigned int k = 0; k < nr_of_arm_angles; k++) {
+            const double offset = (k % 2 == 1 ? 1.0 : -1.0) * ((k + 1) / 2) * step;
+            if (solveArmAngle(arm_angle + offset, p_in) != E_NOERROR)
+                return error;
+
+            double best = std::numeric_limits<double>::infinity();
+            for (unsigned int n = 0; n < nr_of_solutions; n++) {
+                if (!toLimits(solutions[n], q_init))
+                    continue;
+                const double d = (solutions[n].data - q_init.data).squaredNorm();
+                if (d < best) {
+                    best = d;
+                    q_out = solutions[n];
+                }
+            }
+            if (best < std::numeric_limits<double>::infinity())
+                return (error = E_NOERROR);
+        }
+        return (error = E_NO_SOLUTION);
+    }
+
+    const char* ChainIkSolverPos_SRS::strError(const int error) const
+    {
+        if (E_NOT_SRS == error) return "The chain does not have a spherical-revolute-spherical structure";
+        else if (E_NO_SOLUTION == error) return "The pose is out of reach or has no solution within the joint limits";
+        else return SolverI::strError(error);
+    }
+
+}
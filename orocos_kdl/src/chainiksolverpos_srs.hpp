@@ -0,0 +1,161 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINIKSOLVERPOS_SRS_HPP
+#define KDLCHAINIKSOLVERPOS_SRS_HPP
+
+#include "chainiksolver.hpp"
+#include "chainfksolverpos_recursive.hpp"
+
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * Closed-form inverse position kinematics for 7 joint arms with a
+     * spherical-revolute-spherical (SRS) structure, like the KUKA LBR
+     * iiwa: the axes of joints 1-3 intersect in the shoulder point S,
+     * the axes of joints 5-7 in the wrist point W and the elbow joint 4
+     * changes the distance between them.
+     *
+     * The structure is detected from the joint axes at zero joint
+     * positions, so it does not depend on how the chain was built (DH
+     * parameters or not, joint scales and offsets). The kinematics are
+     * then solved as a product of exponentials with the Paden-Kahan
+     * subproblems.
+     *
+     * The redundancy is parameterised by the arm angle, the rotation of
+     * the arm plane (S, elbow, W) about the line from S to W. The arm
+     * angle is measured from the reference plane, the arm plane that
+     * reaches the same W with joint 3 at zero. For a given arm angle a
+     * pose has up to 8 solutions, numbered by their elbow (bit 0),
+     * shoulder (bit 1) and wrist (bit 2) configuration.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_SRS : public ChainIkSolverPos
+    {
+    public:
+        static const int E_NOT_SRS = -100; //! The chain does not have an SRS structure
+        static const int E_NO_SOLUTION = -101; //! The pose is out of reach or no solution respects the joint limits
+
+        /**
+         * Constructor of the solver
+         *
+         * @param chain the chain to calculate the inverse position for
+         * @param q_min the minimum joint positions
+         * @param q_max the maximum joint positions
+         * @param nr_of_arm_angles the number of arm angles, evenly
+         * spread over one turn, tried by the arm angle sweep
+         * @param eps the tolerance on the intersection of the joint axes
+         */
+        ChainIkSolverPos_SRS(const Chain& chain, const JntArray& q_min, const JntArray& q_max,
+                             unsigned int nr_of_arm_angles=36, double eps=1e-9);
+        ~ChainIkSolverPos_SRS();
+
+        /**
+         * Find joint positions for p_in by a sweep over the arm angle,
+         * starting at the arm angle of q_init and moving away from it in
+         * both directions. Returns, at the first arm angle that has
+         * solutions within the joint limits, the one closest to q_init.
+         * The cost is bounded by nr_of_arm_angles evaluations of the
+         * closed form.
+         *
+         * @return E_NOERROR, E_NOT_SRS, E_NO_SOLUTION, E_NOT_UP_TO_DATE
+         *         or E_SIZE_MISMATCH
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /**
+         * Compute all solutions for p_in at the given arm angle,
+         * regardless of the joint limits. Revolute joint positions are
+         * within half a turn of zero.
+         *
+         * @param arm_angle the arm angle in radians
+         * @param p_in the requested pose of the tip
+         * @param q_out the solutions found, up to 8. Only resized, so a
+         * vector reused from a previous call is not reallocated
+         * @param configs if not NULL, the configuration number of every
+         * solution
+         *
+         * @return E_NOERROR, E_NOT_SRS, E_NO_SOLUTION if the pose is out
+         *         of reach, E_NOT_UP_TO_DATE
+         */
+        int CartToJnt(double arm_angle, const Frame& p_in, std::vector<JntArray>& q_out,
+                      std::vector<unsigned int>* configs=NULL);
+
+        /**
+         * Compute the arm angle and configuration number of q.
+         *
+         * @return E_NOERROR, E_NOT_SRS, E_NOT_UP_TO_DATE or E_SIZE_MISMATCH
+         */
+        int getArmAngle(const JntArray& q, double& arm_angle, unsigned int& config);
+
+        /// True if the chain has an SRS structure
+        bool isSRS() const { return srs; }
+
+        /**
+         * @return E_SIZE_MISMATCH if input sizes do not match the chain
+         */
+        int setJointLimits(const JntArray& q_min, const JntArray& q_max);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIkSolverPos_SRS* clone() const { return new ChainIkSolverPos_SRS(*this); }
+
+        /// @copydoc KDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+    private:
+        /// All solutions at arm_angle, into solutions and solution_configs
+        int solveArmAngle(double arm_angle, const Frame& p_in);
+        void computeShoulder(const Rotation& R_s, bool branch, double theta[3]) const;
+        void computeWrist(const Rotation& R_w, bool branch, double theta[3]) const;
+        Rotation referenceRotation(const Vector& u, const Vector& v) const;
+        double elbowAngle(bool branch, double cos_angle) const;
+        bool toLimits(JntArray& q, const JntArray& q_ref) const;
+
+        const Chain& chain;
+        unsigned int nj;
+        JntArray q_min;
+        JntArray q_max;
+        unsigned int nr_of_arm_angles;
+        double eps;
+        ChainFkSolverPos_recursive fksolver;
+
+        // geometry at zero joint positions
+        bool srs;
+        Vector axis[7];     // unit joint axes
+        double rate[7];     // joint angle per unit of joint position
+        Vector elbow_point; // point on the elbow axis
+        Vector S;           // shoulder point
+        Vector W;           // wrist point
+        double elbow_zero;  // elbow angle at which the arm is most stretched
+        double elbow_u, elbow_v, elbow_h; // distances for the elbow angle
+        Frame T_zero;       // tip frame
+
+        // solutions of the last arm angle, sized for all 8 configurations
+        std::vector<JntArray> solutions;
+        std::vector<unsigned int> solution_configs;
+        unsigned int nr_of_solutions;
+    };
+
+}
+
+#endif
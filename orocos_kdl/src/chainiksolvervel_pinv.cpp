@@ -32,6 +32,10 @@ namespace KDL
         U(6,JntArray(nj)),
         S(nj),
         V(nj,JntArray(nj)),
+        svd_6xN(nj),
+        U_6xN(Eigen::MatrixXd::Zero(6,nj)),
+        V_6xN(Eigen::MatrixXd::Zero(nj,nj)),
+        svd_method(SVD_HOUSEHOLDER),
         tmp(nj),
         eps(_eps),
         maxiter(_maxiter),
@@ -51,6 +55,8 @@ namespace KDL
         V.resize(nj);
         for(unsigned int i = 0 ; i < V.size(); i++)
             V[i].resize(nj);
+        U_6xN.resize(6,nj);
+        V_6xN.resize(nj,nj);
         tmp.resize(nj);
     }
 
@@ -81,7 +87,11 @@ namespace KDL
         //Do a singular value decomposition of "jac" with maximum
         //iterations "maxiter", put the results in "U", "S" and "V"
         //jac = U*S*Vt
-        svdResult = svd.calculate(jac,U,S,V,maxiter);
+        const bool jacobi = (svd_method != SVD_HOUSEHOLDER);
+        if (jacobi)
+            svdResult = svd_6xN.calculate(jac.data,U_6xN,S.data,V_6xN,maxiter);
+        else
+            svdResult = svd.calculate(jac,U,S,V,maxiter);
         if (0 != svdResult)
         {
             qdot_out.data.setZero();
@@ -96,7 +106,7 @@ namespace KDL
         for (i=0;i<jac.columns();i++) {
             sum = 0.0;
             for (j=0;j<jac.rows();j++) {
-                sum+= U[j](i)*v_in(j);
+                sum+= (jacobi ? U_6xN(j,i) : U[j](i))*v_in(j);
             }
             //If the singular value is too small (<eps), don't invert it but
             //set the inverted singular value to zero (truncated svd)
@@ -114,7 +124,7 @@ namespace KDL
         for (i=0;i<jac.columns();i++) {
             sum = 0.0;
             for (j=0;j<jac.columns();j++) {
-                sum+=V[i](j)*tmp(j);
+                sum+= (jacobi ? V_6xN(i,j) : V[i](j))*tmp(j);
             }
             //Put the result in qdot_out
             qdot_out(i)=sum;
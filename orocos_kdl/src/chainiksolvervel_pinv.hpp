@@ -25,6 +25,7 @@
 #include "chainiksolver.hpp"
 #include "chainjnttojacsolver.hpp"
 #include "utilities/svd_HH.hpp"
+#include "utilities/svd_jacobi_6xN.hpp"
 
 namespace KDL
 {
@@ -92,11 +93,24 @@ namespace KDL
          */
         int getSVDResult()const {return svdResult;};
 
+        /**
+         * Select the SVD of the jacobian, SVD_HOUSEHOLDER (default), the
+         * faster SVD_JACOBI_6XN kernel or SVD_JACOBI_6XN_WARM, which
+         * starts from the decomposition of the previous call and suits
+         * consecutive calls along a trajectory. All give the same
+         * truncation of the singular values.
+         */
+        void setSVDMethod(const SVDMethod method) {svd_method = method; svd_6xN.setWarmStart(method == SVD_JACOBI_6XN_WARM);};
+        SVDMethod getSVDMethod()const {return svd_method;};
+
         /// @copydoc KDL::SolverI::strError()
         virtual const char* strError(const int error) const;
 
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIkSolverVel_pinv* clone() const { return new ChainIkSolverVel_pinv(*this); }
     private:
         const Chain& chain;
         ChainJntToJacSolver jnt2jac;
@@ -106,6 +120,10 @@ namespace KDL
         std::vector<JntArray> U;
         JntArray S;
         std::vector<JntArray> V;
+        SVD_Jacobi_6xN svd_6xN;
+        Eigen::MatrixXd U_6xN;
+        Eigen::MatrixXd V_6xN;
+        SVDMethod svd_method;
         JntArray tmp;
         double eps;
         int maxiter;
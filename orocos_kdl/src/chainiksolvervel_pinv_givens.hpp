@@ -43,6 +43,9 @@ namespace KDL
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIkSolverVel_pinv_givens* clone() const { return new ChainIkSolverVel_pinv_givens(*this); }
+
     private:
         const Chain& chain;
         unsigned int nj;
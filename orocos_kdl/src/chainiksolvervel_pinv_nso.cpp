@@ -33,6 +33,8 @@ namespace KDL
         S(Eigen::VectorXd::Zero(nj)),
         Sinv(Eigen::VectorXd::Zero(nj)),
         V(Eigen::MatrixXd::Zero(nj,nj)),
+        svd_6xN(nj),
+        svd_method(SVD_HOUSEHOLDER),
         tmp(Eigen::VectorXd::Zero(nj)),
         tmp2(Eigen::VectorXd::Zero(nj)),
         eps(_eps),
@@ -53,6 +55,8 @@ namespace KDL
         S(Eigen::VectorXd::Zero(nj)),
         Sinv(Eigen::VectorXd::Zero(nj)),
         V(Eigen::MatrixXd::Zero(nj,nj)),
+        svd_6xN(nj),
+        svd_method(SVD_HOUSEHOLDER),
         tmp(Eigen::VectorXd::Zero(nj)),
         tmp2(Eigen::VectorXd::Zero(nj)),
         eps(_eps),
@@ -96,7 +100,10 @@ namespace KDL
         //Do a singular value decomposition of "jac" with maximum
         //iterations "maxiter", put the results in "U", "S" and "V"
         //jac = U*S*Vt
-        svdResult = svd_eigen_HH(jac.data,U,S,V,tmp,maxiter);
+        if (svd_method != SVD_HOUSEHOLDER)
+            svdResult = svd_6xN.calculate(jac.data,U,S,V,maxiter);
+        else
+            svdResult = svd_eigen_HH(jac.data,U,S,V,tmp,maxiter);
         if (0 != svdResult)
         {
             qdot_out.data.setZero() ;
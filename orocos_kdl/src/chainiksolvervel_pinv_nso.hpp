@@ -24,6 +24,7 @@
 
 #include "chainiksolver.hpp"
 #include "chainjnttojacsolver.hpp"
+#include "utilities/svd_jacobi_6xN.hpp"
 #include <Eigen/Core>
 
 namespace KDL
@@ -134,9 +135,22 @@ namespace KDL
          */
         int getSVDResult()const {return svdResult;};
 
+        /**
+         * Select the SVD of the jacobian, SVD_HOUSEHOLDER (default), the
+         * faster SVD_JACOBI_6XN kernel or SVD_JACOBI_6XN_WARM, which
+         * starts from the decomposition of the previous call and suits
+         * consecutive calls along a trajectory. All give the same
+         * truncation of the singular values.
+         */
+        void setSVDMethod(const SVDMethod method) {svd_method = method; svd_6xN.setWarmStart(method == SVD_JACOBI_6XN_WARM);};
+        SVDMethod getSVDMethod()const {return svd_method;};
+
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIkSolverVel_pinv_nso* clone() const { return new ChainIkSolverVel_pinv_nso(*this); }
+
     private:
         const Chain& chain;
         ChainJntToJacSolver jnt2jac;
@@ -146,6 +160,8 @@ namespace KDL
         Eigen::VectorXd S;
         Eigen::VectorXd Sinv;
         Eigen::MatrixXd V;
+        SVD_Jacobi_6xN svd_6xN;
+        SVDMethod svd_method;
         Eigen::VectorXd tmp;
         Eigen::VectorXd tmp2;
         double eps;
@@ -33,6 +33,8 @@ namespace KDL
         U(Eigen::MatrixXd::Zero(6,nj)),
         S(Eigen::VectorXd::Zero(nj)),
         V(Eigen::MatrixXd::Zero(nj,nj)),
+        svd_6xN(nj),
+        svd_method(SVD_HOUSEHOLDER),
         eps(_eps),
         maxiter(_maxiter),
         tmp(Eigen::VectorXd::Zero(nj)),
@@ -143,7 +145,10 @@ namespace KDL
         tmp_jac_weight2 = weight_ts.lazyProduct(tmp_jac_weight1);
 
         // Compute the SVD of the weighted jacobian
-        svdResult = svd_eigen_HH(tmp_jac_weight2,U,S,V,tmp,maxiter);
+        if (svd_method != SVD_HOUSEHOLDER)
+            svdResult = svd_6xN.calculate(tmp_jac_weight2,U,S,V,maxiter);
+        else
+            svdResult = svd_eigen_HH(tmp_jac_weight2,U,S,V,tmp,maxiter);
         if (0 != svdResult)
         {
             qdot_out.data.setZero() ;
@@ -24,6 +24,7 @@
 
 #include "chainiksolver.hpp"
 #include "chainjnttojacsolver.hpp"
+#include "utilities/svd_jacobi_6xN.hpp"
 #include <Eigen/Core>
 
 namespace KDL
@@ -209,12 +210,25 @@ namespace KDL
          */
         int getSVDResult()const {return svdResult;};
 
+        /**
+         * Select the SVD of the jacobian, SVD_HOUSEHOLDER (default), the
+         * faster SVD_JACOBI_6XN kernel or SVD_JACOBI_6XN_WARM, which
+         * starts from the decomposition of the previous call and suits
+         * consecutive calls along a trajectory. All give the same
+         * truncation and damping of the singular values.
+         */
+        void setSVDMethod(const SVDMethod method) {svd_method = method; svd_6xN.setWarmStart(method == SVD_JACOBI_6XN_WARM);};
+        SVDMethod getSVDMethod()const {return svd_method;};
+
         /// @copydoc KDL::SolverI::strError()
         virtual const char* strError(const int error) const;
 
         /// @copydoc KDL::SolverI::updateInternalDataStructures()
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainIkSolverVel_wdls* clone() const { return new ChainIkSolverVel_wdls(*this); }
+
     private:
         const Chain& chain;
         ChainJntToJacSolver jnt2jac;
@@ -223,6 +237,8 @@ namespace KDL
         Eigen::MatrixXd U;
         Eigen::VectorXd S;
         Eigen::MatrixXd V;
+        SVD_Jacobi_6xN svd_6xN;
+        SVDMethod svd_method;
         double eps;
         int maxiter;
         Eigen::VectorXd tmp;
@@ -35,91 +35,139 @@ ChainJntToJacDotSolver::ChainJntToJacDotSolver(const Chain& _chain):
     chain(_chain),
     locked_joints_(chain.getNrOfJoints(),false),
     nr_of_unlocked_joints_(chain.getNrOfJoints()),
-    jac_solver_(chain),
     jac_(chain.getNrOfJoints()),
     jac_dot_(chain.getNrOfJoints()),
     representation_(HYBRID),
-    fk_solver_(chain)
+    nr_of_computed_columns_(0)
 {
 }
 
 void ChainJntToJacDotSolver::updateInternalDataStructures() {
     locked_joints_.resize(chain.getNrOfJoints(),false);
     this->setLockedJoints(locked_joints_);
-    jac_solver_.updateInternalDataStructures();
     jac_.resize(chain.getNrOfJoints());
     jac_dot_.resize(chain.getNrOfJoints());
-    fk_solver_.updateInternalDataStructures();
 }
 
 int ChainJntToJacDotSolver::JntToJacDot(const JntArrayVel& q_in, Twist& jac_dot_q_dot, int seg_nr)
 {
-    error = JntToJacDot(q_in,jac_dot_,seg_nr);
-    if (error != E_NOERROR) {
+    error = velocitySweep(q_in, seg_nr, false);
+    if (error != E_NOERROR)
         return error;
+
+    // Jdot.qdot in the Inertial representation comes out of the sweep,
+    // change the reference point and/or frame as for the full matrix
+    const Twist bias_ee = bias_.RefPoint(F_bs_ee_.p);
+    switch(representation_)
+    {
+        case HYBRID:
+            // d/dt (w x p) adds w x pdot, summed over the columns: w_ee x pdot
+            jac_dot_q_dot = bias_ee + Twist(v_ee_.rot * v_ee_.vel, Vector::Zero());
+            break;
+        case BODYFIXED:
+            // the w_ee x pdot term cancels against the rotation of the ee frame
+            jac_dot_q_dot = F_bs_ee_.M.Inverse(bias_ee);
+            break;
+        case INERTIAL:
+            jac_dot_q_dot = bias_;
+            break;
+        default:
+            return (error = E_JAC_DOT_FAILED);
     }
-    MultiplyJacobian(jac_dot_,q_in.qdot,jac_dot_q_dot);
     return (error = E_NOERROR);
 }
 
 int ChainJntToJacDotSolver::JntToJacDot(const JntArrayVel& q_in, Jacobian& jdot, int seg_nr)
 {
-    if(locked_joints_.size() != chain.getNrOfJoints())
-        return (error = E_NOT_UP_TO_DATE);
-
-    unsigned int segmentNr;
-    if(seg_nr<0)
-        segmentNr=chain.getNrOfSegments();
-    else
-        segmentNr = seg_nr;
-
     //Initialize Jacobian to zero since only segmentNr columns are computed
     SetToZero(jdot) ;
 
-    if(q_in.q.rows()!=chain.getNrOfJoints() || nr_of_unlocked_joints_!=jdot.columns())
+    if(nr_of_unlocked_joints_!=jdot.columns())
         return (error = E_SIZE_MISMATCH);
-    else if(segmentNr>chain.getNrOfSegments())
-        return (error = E_OUT_OF_RANGE);
 
-    // First compute the jacobian in the Hybrid representation
-    if (jac_solver_.JntToJac(q_in.q,jac_,segmentNr) != E_NOERROR)
-        return (error = E_JACSOLVER_FAILED);
+    error = velocitySweep(q_in, seg_nr, true);
+    if (error != E_NOERROR)
+        return error;
 
-    // Change the reference frame and/or the reference point
-    if (representation_ != HYBRID) // If HYBRID do nothing is this is the default.
+    // The sweep gives Jdot in the Inertial representation, its columns are
+    // the cross products of the parent velocity with the unit twists.
+    // Change the reference frame and/or the reference point from there.
+    for(unsigned int k=0;k<nr_of_computed_columns_;++k)
     {
-        if (fk_solver_.JntToCart(q_in.q,F_bs_ee_,segmentNr) != E_NOERROR)
-            return (error = E_FKSOLVERPOS_FAILED);
-        if (representation_ == BODYFIXED) {
-            // Ref Frame {ee}, Ref Point {ee}
-            jac_.changeBase(F_bs_ee_.M.Inverse());
-        } else if (representation_ == INERTIAL) {
-            // Ref Frame {bs}, Ref Point {bs}
-            jac_.changeRefPoint(-F_bs_ee_.p);
-        } else {
-            return (error = E_JAC_DOT_FAILED);
+        jac_dot_k_ = jac_dot_.getColumn(k);
+        if (representation_ != INERTIAL)
+        {
+            jac_i_ = jac_.getColumn(k).RefPoint(F_bs_ee_.p);
+            // Ref Frame {bs}, Ref Point {ee}: d/dt(w x p) = wdot x p + w x pdot
+            jac_dot_k_ = jac_dot_k_.RefPoint(F_bs_ee_.p) + Twist(jac_i_.rot * v_ee_.vel, Vector::Zero());
+            if (representation_ == BODYFIXED)
+            {
+                // Ref Frame {ee}, Ref Point {ee}: d/dt(R^T J) = R^T (Jdot - w_ee x J)
+                t_djdq_ = Twist(v_ee_.rot * jac_i_.vel, v_ee_.rot * jac_i_.rot);
+                jac_dot_k_ = F_bs_ee_.M.Inverse(jac_dot_k_ - t_djdq_);
+            }
         }
+        jdot.setColumn(k,jac_dot_k_);
     }
 
-    // Let's compute Jdot in the corresponding representation
-    int k=0;
+    return (error = E_NOERROR);
+}
+
+int ChainJntToJacDotSolver::velocitySweep(const JntArrayVel& q_in, int seg_nr, bool compute_columns)
+{
+    if(locked_joints_.size() != chain.getNrOfJoints())
+        return E_NOT_UP_TO_DATE;
+
+    unsigned int segmentNr;
+    if(seg_nr<0)
+        segmentNr=chain.getNrOfSegments();
+    else
+        segmentNr = seg_nr;
+
+    if(q_in.q.rows()!=chain.getNrOfJoints() || q_in.qdot.rows()!=chain.getNrOfJoints())
+        return E_SIZE_MISMATCH;
+    else if(segmentNr>chain.getNrOfSegments())
+        return E_OUT_OF_RANGE;
+
+    // Single sweep from base to ee in the Inertial representation (ref Frame
+    // {bs}, ref Point {bs}), where the unit twist of joint j is constant
+    // while joints j..n move, so that
+    //   d/dt J^i = sum_{j<i} J^j qdot^j x J^i = v_{i-1} x J^i
+    // with v_{i-1} the velocity of the parent of joint i.
+    F_bs_ee_ = Frame::Identity();
+    SetToZero(v_ee_);
+    SetToZero(bias_);
+    nr_of_computed_columns_ = 0;
+    unsigned int j=0;
+    Frame total;
     for(unsigned int i=0;i<segmentNr;++i)
     {
-        //Only increase joint nr if the segment has a joint
-        if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-
-            for(unsigned int j=0;j<chain.getNrOfJoints();++j)
+        const Segment& segment = chain.getSegment(i);
+        if(segment.getJoint().getType()!=Joint::Fixed)
+        {
+            total = F_bs_ee_*segment.pose(q_in.q(j));
+            if(!locked_joints_[j])
             {
-                // Column J is the sum of all partial derivatives  ref (41)
-                if(!locked_joints_[j])
-                    jac_dot_k_ += getPartialDerivative(jac_,j,k,representation_) * q_in.qdot(j);
+                jac_j_ = (F_bs_ee_.M*segment.twist(q_in.q(j),1.0)).RefPoint(-total.p);
+                jac_dot_k_ = v_ee_*jac_j_;
+                bias_ += jac_dot_k_*q_in.qdot(j);
+                v_ee_ += jac_j_*q_in.qdot(j);
+                if(compute_columns)
+                {
+                    jac_.setColumn(nr_of_computed_columns_,jac_j_);
+                    jac_dot_.setColumn(nr_of_computed_columns_,jac_dot_k_);
+                }
+                nr_of_computed_columns_++;
             }
-            jdot.setColumn(k++,jac_dot_k_);
-            SetToZero(jac_dot_k_);
+            j++;
         }
+        else
+            total = F_bs_ee_*segment.pose(0.0);
+        F_bs_ee_ = total;
     }
-
-    return (error = E_NOERROR);
+    // ee twist in the Hybrid representation
+    v_ee_ = v_ee_.RefPoint(F_bs_ee_.p);
+    return E_NOERROR;
 }
 
 const Twist& ChainJntToJacDotSolver::getPartialDerivative(const KDL::Jacobian& J,
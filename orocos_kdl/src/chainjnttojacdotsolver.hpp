@@ -44,6 +44,12 @@ namespace KDL
  * doi:10.1016/0094-114X(95)00069-B
  *
  * url : http://www.sciencedirect.com/science/article/pii/0094114X9500069B
+ *
+ * Jdot and Jdot*qdot are obtained in O(n) from a single forward velocity
+ * sweep in the Inertial representation, where the time derivative of a
+ * column is the cross product of the parent velocity with it, and are then
+ * transformed to the configured representation. The partial derivatives
+ * of the paper remain available through getPartialDerivative().
  */
 class ChainJntToJacDotSolver : public SolverI
 {
@@ -112,6 +118,9 @@ public:
     /// @copydoc KDL::SolverI::updateInternalDataStructures
     virtual void updateInternalDataStructures();
 
+    /// @copydoc KDL::SolverI::clone
+    virtual ChainJntToJacDotSolver* clone() const { return new ChainJntToJacDotSolver(*this); }
+
     /// @copydoc KDL::SolverI::strError()
     virtual const char* strError(const int error) const;
 
@@ -164,16 +173,25 @@ protected:
                                const unsigned int& column_idx,
                                const int& representation);
 private:
+    /**
+     * @brief Forward sweep up to seg_nr computing the ee frame, the ee twist
+     * (Hybrid), Jdot*qdot (Inertial) and, if compute_columns, the columns of
+     * J and Jdot (Inertial)
+     *
+     * @return int 0 if no errors happened
+     */
+    int velocitySweep(const KDL::JntArrayVel& q_in, int seg_nr, bool compute_columns);
 
     const Chain& chain;
     std::vector<bool> locked_joints_;
     unsigned int nr_of_unlocked_joints_;
-    ChainJntToJacSolver jac_solver_;
     Jacobian jac_;
     Jacobian jac_dot_;
     int representation_;
-    ChainFkSolverPos_recursive fk_solver_;
+    unsigned int nr_of_computed_columns_;
     Frame F_bs_ee_;
+    Twist v_ee_;
+    Twist bias_;
     Twist jac_dot_k_;
     Twist jac_j_, jac_i_;
     Twist t_djdq_;
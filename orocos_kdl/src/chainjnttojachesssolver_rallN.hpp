@@ -0,0 +1,259 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_CHAINJNTTOJACHESSSOLVER_RALLN_HPP
+#define KDL_CHAINJNTTOJACHESSSOLVER_RALLN_HPP
+
+#include "chain.hpp"
+#include "jacobian.hpp"
+#include "jntarray.hpp"
+#include "solveri.hpp"
+#include "utilities/rallN.h"
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * Forward position kinematics of chain on a forward mode scalar type
+     * T, like RallN or RallN2d. KDL::Frame is not templated on its scalar,
+     * so the pose of the tip is returned as the rotation matrix R and the
+     * position p, whose derivatives follow from those of the joint
+     * positions q (chain.getNrOfJoints() entries).
+     */
+    template <typename T>
+    void ChainFkRall(const Chain& chain, const std::vector<T>& q, T R[3][3], T p[3])
+    {
+        for (unsigned int a=0; a<3; a++)
+        {
+            for (unsigned int b=0; b<3; b++)
+                R[a][b] = (a==b ? 1.0 : 0.0);
+            p[a] = 0.0;
+        }
+        unsigned int j = 0;
+        for (unsigned int i=0; i<chain.getNrOfSegments(); i++)
+        {
+            const Segment& segment = chain.getSegment(i);
+            const Joint& joint = segment.getJoint();
+            const Frame f = segment.getFrameToTipZero();
+            const Vector axis = joint.JointAxis();
+            const Vector origin = (joint.getType() == Joint::RotAxis || joint.getType() == Joint::TransAxis) ? joint.JointOrigin() : Vector::Zero();
+            // joint pose, Rj = I + sin(angle)*K + (1-cos(angle))*K*K with K = [axis x]
+            T Rj[3][3], pj[3];
+            for (unsigned int a=0; a<3; a++)
+            {
+                for (unsigned int b=0; b<3; b++)
+                    Rj[a][b] = (a==b ? 1.0 : 0.0);
+                pj[a] = 0.0;
+            }
+            if (joint.getType() != Joint::Fixed)
+            {
+                const T angle = q[j++]*joint.getScale()+joint.getOffset();
+                switch (joint.getType())
+                {
+                case Joint::RotAxis: case Joint::RotX: case Joint::RotY: case Joint::RotZ:
+                {
+                    const double K[3][3] = {{0.0, -axis(2), axis(1)}, {axis(2), 0.0, -axis(0)}, {-axis(1), axis(0), 0.0}};
+                    const T s = sin(angle), c = 1.0-cos(angle);
+                    for (unsigned int a=0; a<3; a++)
+                    {
+                        for (unsigned int b=0; b<3; b++)
+                        {
+                            double KK = 0.0;
+                            for (unsigned int k=0; k<3; k++)
+                                KK += K[a][k]*K[k][b];
+                            Rj[a][b] = s*K[a][b]+c*KK+(a==b ? 1.0 : 0.0);
+                        }
+                    }
+                    for (unsigned int a=0; a<3; a++)
+                        pj[a] = origin(a);
+                    break;
+                }
+                case Joint::TransAxis: case Joint::TransX: case Joint::TransY: case Joint::TransZ:
+                    for (unsigned int a=0; a<3; a++)
+                        pj[a] = angle*axis(a)+origin(a);
+                    break;
+                default:
+                    break;
+                }
+            }
+            // p += R*(pj+Rj*f.p), R = R*Rj*f.M
+            T Rjf[3][3], pjf[3], Rn[3][3], pn[3];
+            for (unsigned int a=0; a<3; a++)
+            {
+                pjf[a] = pj[a]+Rj[a][0]*f.p(0)+Rj[a][1]*f.p(1)+Rj[a][2]*f.p(2);
+                for (unsigned int b=0; b<3; b++)
+                    Rjf[a][b] = Rj[a][0]*f.M(0,b)+Rj[a][1]*f.M(1,b)+Rj[a][2]*f.M(2,b);
+            }
+            for (unsigned int a=0; a<3; a++)
+            {
+                pn[a] = p[a]+R[a][0]*pjf[0]+R[a][1]*pjf[1]+R[a][2]*pjf[2];
+                for (unsigned int b=0; b<3; b++)
+                    Rn[a][b] = R[a][0]*Rjf[0][b]+R[a][1]*Rjf[1][b]+R[a][2]*Rjf[2][b];
+            }
+            for (unsigned int a=0; a<3; a++)
+            {
+                p[a] = pn[a];
+                for (unsigned int b=0; b<3; b++)
+                    R[a][b] = Rn[a][b];
+            }
+        }
+    }
+
+    /**
+     * Jacobian, and its derivatives with respect to the joint positions,
+     * of a chain with at most N joints, from a single forward kinematics
+     * pass over RallN<N> or RallN2d<N> (see ChainFkRall). The jacobian
+     * has the same convention as ChainJntToJacSolver: expressed in the
+     * base frame, with the chain tip as reference point.
+     *
+     * @ingroup KinematicFamily
+     */
+    template <int N>
+    class ChainJntToJacHessSolver_RallN : public SolverI
+    {
+    public:
+        explicit ChainJntToJacHessSolver_RallN(const Chain& _chain):
+            chain(_chain)
+        {
+            updateInternalDataStructures();
+        }
+
+        /**
+         * Calculate the jacobian and the pose of the tip in one RallN<N> pass.
+         *
+         * @return E_NOERROR, E_NOT_UP_TO_DATE, or E_SIZE_MISMATCH if the
+         *         sizes of the arguments do not match the chain or the
+         *         chain has more than N joints
+         */
+        int JntToJac(const JntArray& q_in, Jacobian& jac, Frame& p_out)
+        {
+            if (nj != chain.getNrOfJoints())
+                return (error = E_NOT_UP_TO_DATE);
+            if (nj > (unsigned int)N || q_in.rows() != nj || jac.columns() != nj)
+                return (error = E_SIZE_MISMATCH);
+            for (unsigned int i=0; i<nj; i++)
+                q1[i] = RallNVariable<N>(q_in(i), i);
+            RallN<N> R[3][3], p[3];
+            ChainFkRall(chain, q1, R, p);
+
+            Eigen::Matrix3d Rm, dR;
+            for (unsigned int a=0; a<3; a++)
+            {
+                p_out.p(a) = p[a].t;
+                for (unsigned int b=0; b<3; b++)
+                    Rm(a,b) = p_out.M(a,b) = R[a][b].t;
+            }
+            for (unsigned int k=0; k<nj; k++)
+            {
+                // the angular velocity of column k is vee(dR/dq_k*R')
+                for (unsigned int a=0; a<3; a++)
+                    for (unsigned int b=0; b<3; b++)
+                        dR(a,b) = R[a][b].grad[k];
+                const Eigen::Matrix3d W = dR*Rm.transpose();
+                jac(0,k) = p[0].grad[k];
+                jac(1,k) = p[1].grad[k];
+                jac(2,k) = p[2].grad[k];
+                jac(3,k) = W(2,1);
+                jac(4,k) = W(0,2);
+                jac(5,k) = W(1,0);
+            }
+            return (error = E_NOERROR);
+        }
+
+        /**
+         * Calculate the jacobian and its derivatives in one RallN2d<N>
+         * pass: column k of hess[l] is the derivative of column k of jac
+         * with respect to q_l, so the jacobian derivative of
+         * ChainJntToJacDotSolver is the sum of hess[l]*qdot(l).
+         *
+         * @param hess getNrOfJoints() jacobians
+         * @return E_NOERROR, E_NOT_UP_TO_DATE, or E_SIZE_MISMATCH if the
+         *         sizes of the arguments do not match the chain or the
+         *         chain has more than N joints
+         */
+        int JntToHess(const JntArray& q_in, Jacobian& jac, std::vector<Jacobian>& hess)
+        {
+            if (nj != chain.getNrOfJoints())
+                return (error = E_NOT_UP_TO_DATE);
+            if (nj > (unsigned int)N || q_in.rows() != nj || jac.columns() != nj || hess.size() != nj)
+                return (error = E_SIZE_MISMATCH);
+            for (unsigned int l=0; l<nj; l++)
+                if (hess[l].columns() != nj)
+                    return (error = E_SIZE_MISMATCH);
+            for (unsigned int i=0; i<nj; i++)
+                q2[i] = RallN2dVariable<N>(q_in(i), i);
+            RallN2d<N> R[3][3], p[3];
+            ChainFkRall(chain, q2, R, p);
+
+            Eigen::Matrix3d Rm, dR[N];
+            for (unsigned int a=0; a<3; a++)
+                for (unsigned int b=0; b<3; b++)
+                    Rm(a,b) = R[a][b].t.t;
+            for (unsigned int k=0; k<nj; k++)
+                for (unsigned int a=0; a<3; a++)
+                    for (unsigned int b=0; b<3; b++)
+                        dR[k](a,b) = R[a][b].t.grad[k];
+            for (unsigned int k=0; k<nj; k++)
+            {
+                const Eigen::Matrix3d W = dR[k]*Rm.transpose();
+                jac(0,k) = p[0].t.grad[k];
+                jac(1,k) = p[1].t.grad[k];
+                jac(2,k) = p[2].t.grad[k];
+                jac(3,k) = W(2,1);
+                jac(4,k) = W(0,2);
+                jac(5,k) = W(1,0);
+                for (unsigned int l=0; l<nj; l++)
+                {
+                    // d/dq_l vee(dR/dq_k*R') = vee(d2R/dq_k/dq_l*R'+dR/dq_k*dR/dq_l')
+                    Eigen::Matrix3d ddR;
+                    for (unsigned int a=0; a<3; a++)
+                        for (unsigned int b=0; b<3; b++)
+                            ddR(a,b) = R[a][b].grad[k].grad[l];
+                    const Eigen::Matrix3d dW = ddR*Rm.transpose()+dR[k]*dR[l].transpose();
+                    hess[l](0,k) = p[0].grad[k].grad[l];
+                    hess[l](1,k) = p[1].grad[k].grad[l];
+                    hess[l](2,k) = p[2].grad[k].grad[l];
+                    hess[l](3,k) = dW(2,1);
+                    hess[l](4,k) = dW(0,2);
+                    hess[l](5,k) = dW(1,0);
+                }
+            }
+            return (error = E_NOERROR);
+        }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures()
+        {
+            nj = chain.getNrOfJoints();
+            q1.resize(nj);
+            q2.resize(nj);
+        }
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainJntToJacHessSolver_RallN* clone() const { return new ChainJntToJacHessSolver_RallN(*this); }
+
+    private:
+        const Chain& chain;
+        unsigned int nj;
+        std::vector<RallN<N> > q1;
+        std::vector<RallN2d<N> > q2;
+    };
+
+}
+
+#endif
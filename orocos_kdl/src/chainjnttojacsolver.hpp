@@ -64,6 +64,9 @@ namespace KDL
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainJntToJacSolver* clone() const { return new ChainJntToJacSolver(*this); }
+
     private:
         const Chain& chain;
         Twist t_tmp;
@@ -0,0 +1,112 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "chainjnttojacsolver_incremental.hpp"
+
+namespace KDL
+{
+    ChainJntToJacSolver_incremental::ChainJntToJacSolver_incremental(const Chain& _chain):
+        chain(_chain),
+        fksolver(_chain),
+        twists(chain.getNrOfJoints()),
+        locked_joints_(chain.getNrOfJoints(),false),
+        nr_valid(0),
+        nr_recomputed(0)
+    {
+    }
+
+    ChainJntToJacSolver_incremental::~ChainJntToJacSolver_incremental()
+    {
+    }
+
+    void ChainJntToJacSolver_incremental::updateInternalDataStructures() {
+        fksolver.updateInternalDataStructures();
+        twists.resize(chain.getNrOfJoints());
+        locked_joints_.resize(chain.getNrOfJoints(),false);
+        nr_valid = 0;
+    }
+
+    void ChainJntToJacSolver_incremental::invalidate()
+    {
+        fksolver.invalidate();
+        nr_valid = 0;
+    }
+
+    int ChainJntToJacSolver_incremental::setLockedJoints(const std::vector<bool> locked_joints)
+    {
+        if(locked_joints_.size() != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if(locked_joints.size()!=locked_joints_.size())
+            return (error = E_SIZE_MISMATCH);
+        locked_joints_=locked_joints;
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToJacSolver_incremental::JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr)
+    {
+        Frame p_out;
+        return JntToJac(q_in, jac, p_out, seg_nr);
+    }
+
+    int ChainJntToJacSolver_incremental::JntToJac(const JntArray& q_in, Jacobian& jac, Frame& p_out, int seg_nr)
+    {
+        if(locked_joints_.size() != chain.getNrOfJoints() || twists.size() != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        unsigned int segmentNr;
+        if(seg_nr<0)
+            segmentNr=chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        //Initialize Jacobian to zero since only segmentNr columns are computed
+        SetToZero(jac) ;
+
+        if( q_in.rows()!=chain.getNrOfJoints() || jac.columns() != chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+
+        if (fksolver.updateFrames(q_in, segmentNr) != E_NOERROR)
+            return (error = fksolver.getError());
+        nr_recomputed = fksolver.getNrOfRecomputedSegments();
+        if (fksolver.getFirstChangedSegment() < nr_valid)
+            nr_valid = fksolver.getFirstChangedSegment();
+
+        p_out = segmentNr > 0 ? fksolver.getSegmentFrame(segmentNr-1) : Frame::Identity();
+        unsigned int j=0;
+        unsigned int k=0;
+        for (unsigned int i=0;i<segmentNr;i++) {
+            const Segment& segment = chain.getSegment(i);
+            if(segment.getJoint().getType()!=Joint::Fixed) {
+                // twist of the joint in the base frame, reference point at the segment tip
+                if (i >= nr_valid) {
+                    if (i == 0)
+                        twists[j] = segment.twist(q_in(j),1.0);
+                    else
+                        twists[j] = fksolver.getSegmentFrame(i-1).M*segment.twist(q_in(j),1.0);
+                }
+                if(!locked_joints_[j])
+                    jac.setColumn(k++,twists[j].RefPoint(p_out.p-fksolver.getSegmentFrame(i).p));
+                j++;
+            }
+        }
+        if (segmentNr > nr_valid)
+            nr_valid = segmentNr;
+        return (error = E_NOERROR);
+    }
+}
@@ -0,0 +1,97 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_CHAINJNTTOJACSOLVER_INCREMENTAL_HPP
+#define KDL_CHAINJNTTOJACSOLVER_INCREMENTAL_HPP
+
+#include "solveri.hpp"
+#include "frames.hpp"
+#include "jacobian.hpp"
+#include "jntarray.hpp"
+#include "chain.hpp"
+#include "chainfksolverpos_incremental.hpp"
+
+namespace KDL
+{
+    /**
+     * @brief Jacobian solver for a KDL::Chain that reuses the unchanged
+     * part of the previous call.
+     *
+     * The segment frames come from a KDL::ChainFkSolverPos_incremental and
+     * the joint twists (base frame, reference point at the tip of their
+     * segment) are cached as well, so only the twists from the first
+     * changed joint onward are recomputed. The columns are then obtained
+     * by moving every twist to the end effector. The result is the same
+     * as the one of KDL::ChainJntToJacSolver.
+     */
+    class ChainJntToJacSolver_incremental : public SolverI
+    {
+    public:
+        explicit ChainJntToJacSolver_incremental(const Chain& chain);
+        virtual ~ChainJntToJacSolver_incremental();
+
+        /**
+         * Calculate the jacobian expressed in the base frame of the
+         * chain, with reference point at the end effector of the
+         * chain.
+         *
+         * @param q_in input joint positions
+         * @param jac output jacobian
+         * @param seg_nr The final segment to compute
+         * @return success/error code
+         */
+        virtual int JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr=-1);
+
+        /**
+         * Same as JntToJac, also returning the frame of segment seg_nr
+         * which is computed along.
+         */
+        int JntToJac(const JntArray& q_in, Jacobian& jac, Frame& p_out, int seg_nr=-1);
+
+        /**
+         *
+         * @param locked_joints new values for locked joints
+         * @return success/error code
+         */
+        int setLockedJoints(const std::vector<bool> locked_joints);
+
+        /**
+         * Forget all cached frames and twists, the next call recomputes
+         * the chain from the base.
+         */
+        void invalidate();
+
+        /// Number of segments whose pose or twist was evaluated by the last call
+        unsigned int getNrOfRecomputedSegments() const { return nr_recomputed; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainJntToJacSolver_incremental* clone() const { return new ChainJntToJacSolver_incremental(*this); }
+
+    private:
+        const Chain& chain;
+        ChainFkSolverPos_incremental fksolver;
+        std::vector<Twist> twists;
+        std::vector<bool> locked_joints_;
+        unsigned int nr_valid;
+        unsigned int nr_recomputed;
+    };
+}
+#endif
@@ -0,0 +1,299 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#include "chainpathparamsolver_toppra.hpp"
+#include <Eigen/Cholesky>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace KDL {
+
+    namespace {
+        typedef Eigen::Matrix<double,6,1> Vector6d;
+        typedef Eigen::Matrix<double,6,6> Matrix6d;
+
+        const double inf = std::numeric_limits<double>::infinity();
+        // coefficients below this are taken as zero
+        const double tiny = 1e-12;
+        // slack on the feasibility checks, for rounding errors
+        const double tol = 1e-9;
+
+        Vector6d toVector6d(const Twist& t)
+        {
+            Vector6d e;
+            e << t.vel(0), t.vel(1), t.vel(2), t.rot(0), t.rot(1), t.rot(2);
+            return e;
+        }
+
+        // diff() of the rotations, without rounding small angles to zero
+        Vector rotError(const Rotation& a, const Rotation& b)
+        {
+            const Rotation r = b*a.Inverse();
+            const Vector v(0.5*(r(2,1) - r(1,2)), 0.5*(r(0,2) - r(2,0)), 0.5*(r(1,0) - r(0,1)));
+            // |v| = sin(angle), close enough to the angle when it is small
+            if (v.Norm() < 1e-3)
+                return v;
+            return diff(a, b);
+        }
+    }
+
+    ChainPathParamSolver_TOPPRA::ChainPathParamSolver_TOPPRA(const Chain& _chain, const JntArray& _q_dot_max,
+                                                             const JntArray& _q_dotdot_max, const JntArray& _torque_max,
+                                                             const Vector& grav, unsigned int _nr_of_grid_points,
+                                                             double _eps, unsigned int _maxiter):
+        chain(_chain),
+        nj(chain.getNrOfJoints()),
+        q_dot_max(_q_dot_max),
+        q_dotdot_max(_q_dotdot_max),
+        torque_max(_torque_max),
+        nr_of_grid_points(_nr_of_grid_points),
+        eps(_eps),
+        maxiter(_maxiter),
+        jacsolver(chain),
+        jacdotsolver(chain),
+        dynparam(chain, grav)
+    {
+        initAuxVariables();
+    }
+
+    void ChainPathParamSolver_TOPPRA::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        jacsolver.updateInternalDataStructures();
+        jacdotsolver.updateInternalDataStructures();
+        dynparam.updateInternalDataStructures();
+        initAuxVariables();
+    }
+
+    void ChainPathParamSolver_TOPPRA::initAuxVariables()
+    {
+        const unsigned int n = nr_of_grid_points;
+        s.resize(n);
+        q_path.assign(n, JntArray(nj));
+        qp_path.assign(n, JntArray(nj));
+        qpp_path.assign(n, JntArray(nj));
+        nr_of_rows = (q_dot_max.rows() == nj ? nj : 0)
+            + (q_dotdot_max.rows() == nj ? 2*nj : 0)
+            + (torque_max.rows() == nj ? 2*nj : 0);
+        row_a.resize(n*nr_of_rows);
+        row_b.resize(n*nr_of_rows);
+        row_c.resize(n*nr_of_rows);
+        k_lo.resize(n);
+        k_hi.resize(n);
+        x.resize(n);
+        sd.resize(n);
+        lower_p.reserve(nr_of_rows+1);
+        lower_q.reserve(nr_of_rows+1);
+        upper_p.reserve(nr_of_rows+1);
+        upper_q.reserve(nr_of_rows+1);
+        jac.resize(nj);
+        H.resize(nj);
+        coriolis.resize(nj);
+        gravity.resize(nj);
+    }
+
+    int ChainPathParamSolver_TOPPRA::followPath(const Path& path, const JntArray& q_init)
+    {
+        const unsigned int n = nr_of_grid_points;
+        const double length = path.PathLength();
+        JntArray q(q_init);
+        Frame f;
+        JntArrayVel q_qp(nj);
+        Twist jdot_qp;
+        Eigen::LDLT<Matrix6d> ldlt;
+        for (unsigned int i = 0; i < n; ++i) {
+            s[i] = length*i/(n-1);
+            if (i > 0) {
+                // predict from the derivatives at the previous point
+                const double ds = s[i] - s[i-1];
+                q.data = q_path[i-1].data + ds*qp_path[i-1].data + (0.5*ds*ds)*qpp_path[i-1].data;
+            }
+            const Frame target = path.Pos(s[i]);
+            for (unsigned int iter = 0; ; ++iter) {
+                int ret = jacsolver.JntToJac(q, jac, f);
+                if (ret < 0)
+                    return (error = ret);
+                // minimum norm inverse J^T*(J*J^T)^-1, slightly damped
+                ldlt.compute(jac.data*jac.data.transpose() + tiny*Matrix6d::Identity());
+                const Twist e(target.p - f.p, rotError(f.M, target.M));
+                if (e.vel.Norm() < eps && e.rot.Norm() < eps)
+                    break;
+                if (iter == maxiter)
+                    return (error = E_PATH_NOT_FOLLOWED);
+                q.data += jac.data.transpose()*ldlt.solve(toVector6d(e));
+            }
+            q_path[i] = q;
+            qp_path[i].data = jac.data.transpose()*ldlt.solve(toVector6d(path.Vel(s[i], 1.0)));
+            q_qp.q = q;
+            q_qp.qdot = qp_path[i];
+            int ret = jacdotsolver.JntToJacDot(q_qp, jdot_qp);
+            if (ret < 0)
+                return (error = ret);
+            qpp_path[i].data = jac.data.transpose()*ldlt.solve(toVector6d(path.Acc(s[i], 1.0, 0.0) - jdot_qp));
+        }
+        return (error = E_NOERROR);
+    }
+
+    void ChainPathParamSolver_TOPPRA::addConstraints(unsigned int i)
+    {
+        double* a = &row_a[i*nr_of_rows];
+        double* b = &row_b[i*nr_of_rows];
+        double* c = &row_c[i*nr_of_rows];
+        const JntArray& qp = qp_path[i];
+        const JntArray& qpp = qpp_path[i];
+        unsigned int r = 0;
+        // |dq/ds*sd| <= q_dot_max
+        if (q_dot_max.rows() == nj)
+            for (unsigned int j = 0; j < nj; ++j, ++r) {
+                a[r] = 0.0;
+                b[r] = qp(j)*qp(j);
+                c[r] = q_dot_max(j)*q_dot_max(j);
+            }
+        // |dq/ds*u + d2q/ds2*x| <= q_dotdot_max
+        if (q_dotdot_max.rows() == nj)
+            for (unsigned int j = 0; j < nj; ++j, r += 2) {
+                a[r] = qp(j);   b[r] = qpp(j);   c[r] = q_dotdot_max(j);
+                a[r+1] = -qp(j); b[r+1] = -qpp(j); c[r+1] = q_dotdot_max(j);
+            }
+        // |H*dq/ds*u + (H*d2q/ds2 + C*dq/ds)*x + G| <= torque_max
+        if (torque_max.rows() == nj) {
+            dynparam.JntToDynamics(q_path[i], qp, H, coriolis, gravity);
+            const Eigen::VectorXd A = H.data*qp.data;
+            const Eigen::VectorXd B = H.data*qpp.data + coriolis.data;
+            for (unsigned int j = 0; j < nj; ++j, r += 2) {
+                a[r] = A(j);    b[r] = B(j);    c[r] = torque_max(j) - gravity(j);
+                a[r+1] = -A(j); b[r+1] = -B(j); c[r+1] = torque_max(j) + gravity(j);
+            }
+        }
+    }
+
+    bool ChainPathParamSolver_TOPPRA::controllable(unsigned int i, double ds, double lo_next, double hi_next,
+                                                    double& lo, double& hi)
+    {
+        // Every row a*u + b*x <= c bounds u from below (a < 0) or above
+        // (a > 0) by a linear function p + q*x, or bounds x (a == 0).
+        // Some u exists iff every lower bound is below every upper bound.
+        lower_p.clear(); lower_q.clear(); upper_p.clear(); upper_q.clear();
+        lo = 0.0;
+        hi = inf;
+        const double* a = &row_a[i*nr_of_rows];
+        const double* b = &row_b[i*nr_of_rows];
+        const double* c = &row_c[i*nr_of_rows];
+        for (unsigned int r = 0; r < nr_of_rows + 2; ++r) {
+            double ar, br, cr;
+            if (r < nr_of_rows) {
+                ar = a[r]; br = b[r]; cr = c[r];
+            }
+            else if (r == nr_of_rows) {
+                // x + 2*ds*u <= hi_next
+                ar = 2*ds; br = 1.0; cr = hi_next;
+            }
+            else {
+                // x + 2*ds*u >= lo_next
+                ar = -2*ds; br = -1.0; cr = -lo_next;
+            }
+            if (ar > tiny) {
+                upper_p.push_back(cr/ar);
+                upper_q.push_back(-br/ar);
+            }
+            else if (ar < -tiny) {
+                lower_p.push_back(cr/ar);
+                lower_q.push_back(-br/ar);
+            }
+            else if (br > tiny)
+                hi = std::min(hi, cr/br);
+            else if (br < -tiny)
+                lo = std::max(lo, cr/br);
+            else if (cr < -tol)
+                return false;
+        }
+        for (unsigned int l = 0; l < lower_p.size(); ++l)
+            for (unsigned int k = 0; k < upper_p.size(); ++k) {
+                // lower_p + lower_q*x <= upper_p + upper_q*x
+                const double coef = lower_q[l] - upper_q[k];
+                const double rhs = upper_p[k] - lower_p[l];
+                if (coef > tiny)
+                    hi = std::min(hi, rhs/coef);
+                else if (coef < -tiny)
+                    lo = std::max(lo, rhs/coef);
+                else if (rhs < -tol)
+                    return false;
+            }
+        return lo <= hi + tol*(1.0 + std::abs(hi));
+    }
+
+    int ChainPathParamSolver_TOPPRA::Solve(const Path& path, const JntArray& q_init, VelocityProfile_Grid& profile)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if (q_init.rows() != nj || nr_of_grid_points < 2
+            || (q_dot_max.rows() != 0 && q_dot_max.rows() != nj)
+            || (q_dotdot_max.rows() != 0 && q_dotdot_max.rows() != nj)
+            || (torque_max.rows() != 0 && torque_max.rows() != nj))
+            return (error = E_SIZE_MISMATCH);
+
+        if (followPath(path, q_init) < 0)
+            return error;
+        const unsigned int n = nr_of_grid_points;
+        for (unsigned int i = 0; i < n; ++i)
+            addConstraints(i);
+
+        // Backward pass: controllable sets, ending at rest
+        k_lo[n-1] = k_hi[n-1] = 0.0;
+        for (int i = n-2; i >= 0; --i) {
+            if (!controllable(i, s[i+1]-s[i], k_lo[i+1], k_hi[i+1], k_lo[i], k_hi[i]))
+                return (error = E_INFEASIBLE);
+            k_hi[i] = std::max(k_hi[i], k_lo[i]);
+        }
+        if (k_lo[0] > tol)
+            return (error = E_INFEASIBLE);
+
+        // Forward pass: starting at rest, the largest acceleration that
+        // keeps x within the controllable set of the next grid point
+        x[0] = 0.0;
+        for (unsigned int i = 0; i + 1 < n; ++i) {
+            const double ds = s[i+1] - s[i];
+            double u = (k_hi[i+1] - x[i])/(2*ds);
+            const double* a = &row_a[i*nr_of_rows];
+            const double* b = &row_b[i*nr_of_rows];
+            const double* c = &row_c[i*nr_of_rows];
+            for (unsigned int r = 0; r < nr_of_rows; ++r)
+                if (a[r] > tiny)
+                    u = std::min(u, (c[r] - b[r]*x[i])/a[r]);
+            x[i+1] = std::min(std::max(x[i] + 2*ds*u, k_lo[i+1]), k_hi[i+1]);
+        }
+        for (unsigned int i = 0; i < n; ++i)
+            sd[i] = std::sqrt(std::max(x[i], 0.0));
+        for (unsigned int i = 0; i + 1 < n; ++i)
+            if (sd[i] + sd[i+1] <= 0.0 && s[i+1] > s[i])
+                return (error = E_INFEASIBLE);
+
+        profile.SetGrid(s, sd);
+        return (error = E_NOERROR);
+    }
+
+    const char* ChainPathParamSolver_TOPPRA::strError(const int error) const
+    {
+        if (E_PATH_NOT_FOLLOWED == error) return "The joints cannot follow the path";
+        else if (E_INFEASIBLE == error) return "No motion along the path respects the limits";
+        else return SolverI::strError(error);
+    }
+
+}
@@ -0,0 +1,154 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_CHAINPATHPARAMSOLVER_TOPPRA_HPP
+#define KDL_CHAINPATHPARAMSOLVER_TOPPRA_HPP
+
+#include "solveri.hpp"
+#include "chain.hpp"
+#include "path.hpp"
+#include "velocityprofile_grid.hpp"
+#include "chainjnttojacsolver_incremental.hpp"
+#include "chainjnttojacdotsolver.hpp"
+#include "chaindynparam.hpp"
+
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * \brief Time optimal parameterization of a Cartesian path by
+     * reachability analysis (TOPP-RA).
+     *
+     * Computes the fastest rest to rest motion of the end effector of a
+     * chain along a KDL::Path that respects joint velocity, acceleration
+     * and torque limits. The algorithm is the one of H. Pham and Q.-C.
+     * Pham, "A New Approach to Time-Optimal Path Parameterization Based
+     * on Reachability Analysis", IEEE Transactions on Robotics, 2018:
+     *
+     *  - the path is sampled at a uniform grid of path positions s_i and
+     *    followed in joint space: Newton steps with the minimum norm
+     *    inverse of the Jacobian, starting from a prediction with the
+     *    derivatives at the previous grid point, give q(s_i), dq/ds and
+     *    d2q/ds2 (the latter with ChainJntToJacDotSolver);
+     *  - in terms of x = sd^2 and u = sdd, the joint velocities are
+     *    dq/ds*sd, the accelerations dq/ds*u + d2q/ds2*x and the torques
+     *    H*dq/ds*u + (H*d2q/ds2 + C(q,dq/ds)*dq/ds)*x + G, so every limit
+     *    is a linear constraint in (u, x). H, C*dq/ds and G come from
+     *    one ChainDynParam::JntToDynamics() pass;
+     *  - a backward pass computes the controllable set of x at every
+     *    grid point, the velocities from which the end can still be
+     *    reached at rest, and a forward pass then takes the largest
+     *    acceleration that stays within them.
+     *
+     * The constraint sets are two dimensional, so the linear programs of
+     * the backward pass are solved exactly by intersecting the bounds
+     * that every pair of constraints puts on x, without a generic LP
+     * solver. The result is a VelocityProfile_Grid, to be combined with
+     * the path in a Trajectory_Segment.
+     *
+     * A type of limit is left out by passing an empty JntArray for it.
+     */
+    class ChainPathParamSolver_TOPPRA : public SolverI
+    {
+    public:
+        static const int E_PATH_NOT_FOLLOWED = -100; //! The joints cannot follow the path
+        static const int E_INFEASIBLE = -101; //! No motion along the path respects the limits
+
+        /**
+         * Constructor of the solver
+         *
+         * @param chain the chain, an internal reference is stored
+         * @param q_dot_max the maximum joint velocities, or empty
+         * @param q_dotdot_max the maximum joint accelerations, or empty
+         * @param torque_max the maximum joint torques, or empty
+         * @param grav the gravity vector, for the torques
+         * @param nr_of_grid_points the number of grid points, >= 2
+         * @param eps the tolerance on the pose error when following the path
+         * @param maxiter the maximum number of Newton steps per grid point
+         */
+        ChainPathParamSolver_TOPPRA(const Chain& chain, const JntArray& q_dot_max,
+                                    const JntArray& q_dotdot_max, const JntArray& torque_max,
+                                    const Vector& grav, unsigned int nr_of_grid_points=1000,
+                                    double eps=1e-9, unsigned int maxiter=20);
+
+        /**
+         * Compute the time optimal motion along path, starting and
+         * ending at rest.
+         *
+         * @param path the path of the end effector, in the base frame
+         * @param q_init joint positions close to the start of the path
+         * @param profile the resulting profile of the path position
+         * @return E_NOERROR, E_PATH_NOT_FOLLOWED, E_INFEASIBLE,
+         *         E_NOT_UP_TO_DATE or E_SIZE_MISMATCH
+         */
+        int Solve(const Path& path, const JntArray& q_init, VelocityProfile_Grid& profile);
+
+        /// Path positions of the grid of the last Solve()
+        const std::vector<double>& getGrid() const { return s; }
+
+        /// Joint positions q(s) at the grid points
+        const std::vector<JntArray>& getJointPath() const { return q_path; }
+
+        /// Derivatives dq/ds at the grid points
+        const std::vector<JntArray>& getJointPathVel() const { return qp_path; }
+
+        /// Second derivatives d2q/ds2 at the grid points
+        const std::vector<JntArray>& getJointPathAcc() const { return qpp_path; }
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual ChainPathParamSolver_TOPPRA* clone() const { return new ChainPathParamSolver_TOPPRA(*this); }
+
+        /// @copydoc KDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+    private:
+        int followPath(const Path& path, const JntArray& q_init);
+        // constraint rows a*u + b*x <= c of grid point i
+        void addConstraints(unsigned int i);
+        // interval of x for which a u satisfies the rows of grid point i
+        // and reaches [k_lo, k_hi] after ds, false if it is empty
+        bool controllable(unsigned int i, double ds, double k_lo, double k_hi, double& lo, double& hi);
+        void initAuxVariables();
+
+        const Chain& chain;
+        unsigned int nj;
+        JntArray q_dot_max, q_dotdot_max, torque_max;
+        unsigned int nr_of_grid_points;
+        double eps;
+        unsigned int maxiter;
+        ChainJntToJacSolver_incremental jacsolver;
+        ChainJntToJacDotSolver jacdotsolver;
+        ChainDynParam dynparam;
+
+        std::vector<double> s;
+        std::vector<JntArray> q_path, qp_path, qpp_path;
+        unsigned int nr_of_rows;
+        std::vector<double> row_a, row_b, row_c;
+        std::vector<double> k_lo, k_hi, x, sd;
+        std::vector<double> lower_p, lower_q, upper_p, upper_q;
+        Jacobian jac;
+        JntSpaceInertiaMatrix H;
+        JntArray coriolis, gravity;
+    };
+}
+
+#endif
@@ -0,0 +1,217 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_FIXEDCHAIN_HPP
+#define KDL_FIXEDCHAIN_HPP
+
+#include "chain.hpp"
+#include "frames.hpp"
+#include "rigidbodyinertia.hpp"
+#include <Eigen/Core>
+#include <array>
+#include <cmath>
+
+namespace KDL {
+
+    /**
+     * \brief Compile-time unrolled loop over the indices [I,N).
+     *
+     * forward() calls f(I), f(I+1), ..., f(N-1), backward() calls them in
+     * the reverse order. Once inlined, every call sees a constant index.
+     */
+    template<unsigned int I, unsigned int N>
+    struct FixedChainUnroll
+    {
+        template<typename F>
+        static inline void forward(const F& f)
+        {
+            f(I);
+            FixedChainUnroll<I+1,N>::forward(f);
+        }
+
+        template<typename F>
+        static inline void backward(const F& f)
+        {
+            FixedChainUnroll<I+1,N>::backward(f);
+            f(I);
+        }
+    };
+
+    template<unsigned int N>
+    struct FixedChainUnroll<N,N>
+    {
+        template<typename F>
+        static inline void forward(const F&) {}
+
+        template<typename F>
+        static inline void backward(const F&) {}
+    };
+
+    /**
+     * \brief Serial kinematic chain with a number of joints N fixed at
+     * compile time.
+     *
+     * A FixedChain is built once from a KDL::Chain with exactly N
+     * non-fixed joints. Every joint is given a frame, body j, with its z
+     * axis along the joint axis: joint j rotates body j about, or moves
+     * it along, that z axis. All constant transformations between two
+     * joints, i.e. the tip frame of a segment, the fixed segments behind
+     * it and the origin and axis of the next joint, are folded into a
+     * single frame, and the inertia of the fixed segments behind a joint
+     * is added to the body that moves with that joint. The resulting
+     * kinematics and dynamics are identical to those of the original
+     * chain, while the pose of a body costs one sin/cos pair and its
+     * motion subspace is constant.
+     *
+     * All storage is fixed-size, so the FixedChain* solvers neither
+     * allocate nor loop over std::vector<Segment>.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<unsigned int N>
+    class FixedChain
+    {
+        static_assert(N > 0, "A FixedChain needs at least one joint");
+    public:
+        typedef Eigen::Matrix<double,N,1> JntVector;
+        typedef Eigen::Matrix<double,6,N> JacobianMatrix;
+        typedef Eigen::Matrix<double,N,N> InertiaMatrix;
+
+        FixedChain():
+            valid(false)
+        {
+        }
+
+        /**
+         * Builds the fixed-size representation of chain. If the chain does
+         * not have exactly N non-fixed joints, isValid() returns false and
+         * the FixedChain* solvers refuse to compute.
+         */
+        explicit FixedChain(const Chain& chain):
+            valid(false)
+        {
+            setChain(chain);
+        }
+
+        /**
+         * (Re)builds the fixed-size representation of chain.
+         * \return true if the chain has exactly N non-fixed joints
+         */
+        bool setChain(const Chain& chain)
+        {
+            valid = (chain.getNrOfJoints() == N);
+            if (!valid)
+                return false;
+
+            // post collects the constant transformations behind body j,
+            // or in front of the first joint
+            Frame post = Frame::Identity();
+            int j = -1;
+            for (unsigned int i = 0; i < chain.getNrOfSegments(); i++) {
+                const Segment& segment = chain.getSegment(i);
+                const Joint& joint = segment.getJoint();
+                if (joint.getType() != Joint::Fixed) {
+                    j++;
+                    const bool axis_type = joint.getType() == Joint::RotAxis || joint.getType() == Joint::TransAxis;
+                    const Rotation R = axisToZ(joint.JointAxis());
+                    f_joint[j] = post * Frame(R, axis_type ? joint.JointOrigin() : Vector::Zero());
+                    f_tip[j] = Frame(R.Inverse()) * segment.getFrameToTipZero();
+                    revolute[j] = joint.getType() == Joint::RotAxis || joint.getType() == Joint::RotX ||
+                                  joint.getType() == Joint::RotY || joint.getType() == Joint::RotZ;
+                    scale[j] = joint.getScale();
+                    offset[j] = joint.getOffset();
+                    S[j] = revolute[j] ? Twist(Vector::Zero(), Vector(0.0, 0.0, scale[j]))
+                                       : Twist(Vector(0.0, 0.0, scale[j]), Vector::Zero());
+                    inertia[j] = f_tip[j] * segment.getInertia();
+                    joint_inertia[j] = joint.getInertia();
+                    post = f_tip[j];
+                } else {
+                    post = post * segment.pose(0.0);
+                    if (j >= 0)
+                        inertia[j] = inertia[j] + post * segment.getInertia();
+                }
+            }
+            f_end = post;
+            return true;
+        }
+
+        /// Whether the chain this was built from has exactly N joints
+        bool isValid() const { return valid; }
+
+        static unsigned int getNrOfJoints() { return N; }
+
+        /**
+         * Pose of body j with respect to body j-1, or to the chain base
+         * for j=0, at joint position q
+         */
+        Frame pose(unsigned int j, double q) const
+        {
+            const Rotation& M = f_joint[j].M;
+            const double qj = scale[j] * q + offset[j];
+            if (!revolute[j])
+                return Frame(M, f_joint[j].p + M.UnitZ() * qj);
+            // f_joint[j].M * RotZ(qj) only mixes the first two columns
+            const double s = sin(qj);
+            const double c = cos(qj);
+            return Frame(Rotation(M(0,0)*c + M(0,1)*s, M(0,1)*c - M(0,0)*s, M(0,2),
+                                  M(1,0)*c + M(1,1)*s, M(1,1)*c - M(1,0)*s, M(1,2),
+                                  M(2,0)*c + M(2,1)*s, M(2,1)*c - M(2,0)*s, M(2,2)),
+                         f_joint[j].p);
+        }
+
+        /// Unit twist of joint j, constant in body j
+        const Twist& getMotionSubspace(unsigned int j) const { return S[j]; }
+
+        /// Inertia of body j in body j, with the inertia of trailing fixed segments folded in
+        const RigidBodyInertia& getInertia(unsigned int j) const { return inertia[j]; }
+
+        /// 1D inertia of joint j along its axis, see Joint::getInertia()
+        double getJointInertia(unsigned int j) const { return joint_inertia[j]; }
+
+        /// Tip frame of the segment of joint j with respect to body j
+        const Frame& getFrameToTip(unsigned int j) const { return f_tip[j]; }
+
+        /// Chain tip with respect to body N-1
+        const Frame& getFrameToEnd() const { return f_end; }
+
+    private:
+        /// A rotation with axis as its z column
+        static Rotation axisToZ(const Vector& axis)
+        {
+            if (axis == Vector(0.0, 0.0, 1.0))
+                return Rotation::Identity();
+            const Vector e = std::fabs(axis.x()) < 0.9 ? Vector(1.0, 0.0, 0.0) : Vector(0.0, 1.0, 0.0);
+            Vector x = e - axis * dot(e, axis);
+            x.Normalize();
+            return Rotation(x, axis * x, axis);
+        }
+
+        bool valid;
+        std::array<Frame, N> f_joint;
+        std::array<Frame, N> f_tip;
+        Frame f_end;
+        std::array<bool, N> revolute;
+        std::array<double, N> scale;
+        std::array<double, N> offset;
+        std::array<Twist, N> S;
+        std::array<RigidBodyInertia, N> inertia;
+        std::array<double, N> joint_inertia;
+    };
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_FIXEDCHAINDYNPARAM_HPP
+#define KDL_FIXEDCHAINDYNPARAM_HPP
+
+#include "fixedchainidsolver_recursive_newton_euler.hpp"
+
+namespace KDL {
+
+    /**
+     * Joint-space inertia matrix H, coriolis and gravity torques of a
+     * FixedChain<N>, the fixed-size counterpart of ChainDynParam.
+     *
+     * H is calculated with the composite rigid body algorithm of
+     * Featherstone, "Rigid Body Dynamics Algorithms", 2008, page 107.
+     * Coriolis and gravity torques come from RNE passes with zero
+     * accelerations.
+     */
+    template<unsigned int N>
+    class FixedChainDynParam : public SolverI
+    {
+    public:
+        typedef typename FixedChain<N>::JntVector JntVector;
+        typedef typename FixedChain<N>::InertiaMatrix InertiaMatrix;
+
+        FixedChainDynParam(const FixedChain<N>& _chain, Vector grav):
+            chain(_chain),
+            idsolver_coriolis(_chain, Vector::Zero()),
+            idsolver_gravity(_chain, grav)
+        {
+        }
+
+        int JntToMass(const JntVector& q, InertiaMatrix& H)
+        {
+            if (!chain.isValid())
+                return (error = E_NOT_UP_TO_DATE);
+            const FixedChain<N>& c = chain;
+            //Sweep from root to leaf
+            FixedChainUnroll<0,N>::forward([&](unsigned int j) {
+                X[j] = c.pose(j, q(j));
+                Ic[j] = c.getInertia(j);
+            });
+            //Sweep from leaf to root
+            FixedChainUnroll<0,N>::backward([&](unsigned int k) {
+                if (k != 0)
+                    Ic[k-1] = Ic[k-1] + X[k] * Ic[k];
+                Wrench F = Ic[k] * c.getMotionSubspace(k);
+                H(k,k) = dot(c.getMotionSubspace(k), F) + c.getJointInertia(k);
+                for (unsigned int j = k; j > 0; j--) {
+                    F = X[j] * F;
+                    H(k,j-1) = H(j-1,k) = dot(F, c.getMotionSubspace(j-1));
+                }
+            });
+            return (error = E_NOERROR);
+        }
+
+        int JntToCoriolis(const JntVector& q, const JntVector& q_dot, JntVector& coriolis)
+        {
+            return (error = idsolver_coriolis.CartToJnt(q, q_dot, JntVector::Zero(), coriolis));
+        }
+
+        int JntToGravity(const JntVector& q, JntVector& gravity)
+        {
+            return (error = idsolver_gravity.CartToJnt(q, JntVector::Zero(), JntVector::Zero(), gravity));
+        }
+
+        virtual void updateInternalDataStructures() {}
+
+        /// @copydoc KDL::SolverI::clone
+        virtual FixedChainDynParam* clone() const { return new FixedChainDynParam(*this); }
+
+    private:
+        const FixedChain<N>& chain;
+        FixedChainIdSolver_RNE<N> idsolver_coriolis;
+        FixedChainIdSolver_RNE<N> idsolver_gravity;
+        std::array<Frame, N> X;
+        std::array<RigidBodyInertia, N> Ic;
+    };
+
+}
+
+#endif
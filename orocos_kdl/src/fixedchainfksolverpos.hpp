@@ -0,0 +1,72 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_FIXEDCHAINFKSOLVERPOS_HPP
+#define KDL_FIXEDCHAINFKSOLVERPOS_HPP
+
+#include "fixedchain.hpp"
+#include "solveri.hpp"
+
+namespace KDL {
+
+    /**
+     * Forward position kinematics for a FixedChain<N>. The segment loop is
+     * unrolled at compile time and no memory is allocated.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<unsigned int N>
+    class FixedChainFkSolverPos : public SolverI
+    {
+    public:
+        typedef typename FixedChain<N>::JntVector JntVector;
+
+        explicit FixedChainFkSolverPos(const FixedChain<N>& _chain):
+            chain(_chain)
+        {
+        }
+
+        /**
+         * Calculate the pose of the chain tip.
+         * \param q_in The joint positions
+         * \param p_out The pose of the tip with respect to the base
+         */
+        int JntToCart(const JntVector& q_in, Frame& p_out)
+        {
+            if (!chain.isValid())
+                return (error = E_NOT_UP_TO_DATE);
+            Frame F;
+            const FixedChain<N>& c = chain;
+            FixedChainUnroll<0,N>::forward([&](unsigned int j) {
+                F = (j == 0) ? c.pose(j, q_in(j)) : F * c.pose(j, q_in(j));
+            });
+            p_out = F * chain.getFrameToEnd();
+            return (error = E_NOERROR);
+        }
+
+        virtual void updateInternalDataStructures() {}
+
+        /// @copydoc KDL::SolverI::clone
+        virtual FixedChainFkSolverPos* clone() const { return new FixedChainFkSolverPos(*this); }
+
+    private:
+        const FixedChain<N>& chain;
+    };
+
+}
+
+#endif
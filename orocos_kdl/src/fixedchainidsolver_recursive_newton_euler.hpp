@@ -0,0 +1,126 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_FIXEDCHAINIDSOLVER_RECURSIVE_NEWTON_EULER_HPP
+#define KDL_FIXEDCHAINIDSOLVER_RECURSIVE_NEWTON_EULER_HPP
+
+#include "fixedchain.hpp"
+#include "solveri.hpp"
+
+namespace KDL {
+
+    /**
+     * \brief Recursive newton euler inverse dynamics solver for a
+     * FixedChain<N>.
+     *
+     * Same algorithm as ChainIdSolver_RNE (Featherstone, "Rigid Body
+     * Dynamics Algorithms", 2008, page 96), with the segment loops
+     * unrolled at compile time and all working memory held in fixed-size
+     * members.
+     */
+    template<unsigned int N>
+    class FixedChainIdSolver_RNE : public SolverI
+    {
+    public:
+        typedef typename FixedChain<N>::JntVector JntVector;
+        typedef std::array<Wrench, N> FixedWrenches;
+
+        /**
+         * \param chain The kinematic chain to calculate the inverse dynamics for
+         * \param grav The gravity vector to use during the calculation.
+         */
+        FixedChainIdSolver_RNE(const FixedChain<N>& _chain, Vector grav):
+            chain(_chain),
+            ag(-Twist(grav, Vector::Zero()))
+        {
+        }
+
+        /**
+         * Function to calculate from Cartesian forces to joint torques.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param q_dotdot The current joint accelerations
+         * \param f_ext The external forces (no gravity) on the bodies of
+         * the N joints, expressed in the tip frame of each body
+         * Output parameters:
+         * \param torques the resulting torques for the joints
+         */
+        int CartToJnt(const JntVector& q, const JntVector& q_dot, const JntVector& q_dotdot,
+                      const FixedWrenches& f_ext, JntVector& torques)
+        {
+            return recurse(q, q_dot, q_dotdot, &f_ext, torques);
+        }
+
+        /**
+         * Same as above, without external forces.
+         */
+        int CartToJnt(const JntVector& q, const JntVector& q_dot, const JntVector& q_dotdot, JntVector& torques)
+        {
+            return recurse(q, q_dot, q_dotdot, 0, torques);
+        }
+
+        virtual void updateInternalDataStructures() {}
+
+        /// @copydoc KDL::SolverI::clone
+        virtual FixedChainIdSolver_RNE* clone() const { return new FixedChainIdSolver_RNE(*this); }
+
+    private:
+        int recurse(const JntVector& q, const JntVector& q_dot, const JntVector& q_dotdot,
+                    const FixedWrenches* f_ext, JntVector& torques)
+        {
+            if (!chain.isValid())
+                return (error = E_NOT_UP_TO_DATE);
+            const FixedChain<N>& c = chain;
+            //Sweep from root to leaf
+            FixedChainUnroll<0,N>::forward([&](unsigned int j) {
+                X[j] = c.pose(j, q(j));
+                const Twist& S = c.getMotionSubspace(j);
+                const Twist vj = S * q_dot(j);
+                if (j == 0) {
+                    v[j] = vj;
+                    a[j] = X[j].Inverse(ag) + S * q_dotdot(j);
+                } else {
+                    v[j] = X[j].Inverse(v[j-1]) + vj;
+                    a[j] = X[j].Inverse(a[j-1]) + S * q_dotdot(j) + v[j] * vj;
+                }
+                const RigidBodyInertia& Ij = c.getInertia(j);
+                f[j] = Ij * a[j] + v[j] * (Ij * v[j]);
+                //the external forces are expressed in the tip frame of the segment
+                if (f_ext)
+                    f[j] = f[j] - c.getFrameToTip(j) * (*f_ext)[j];
+            });
+            //Sweep from leaf to root
+            FixedChainUnroll<0,N>::backward([&](unsigned int j) {
+                torques(j) = dot(c.getMotionSubspace(j), f[j]) + c.getJointInertia(j) * q_dotdot(j);
+                if (j != 0)
+                    f[j-1] = f[j-1] + X[j] * f[j];
+            });
+            return (error = E_NOERROR);
+        }
+
+        const FixedChain<N>& chain;
+        Twist ag;
+        std::array<Frame, N> X;
+        std::array<Twist, N> v;
+        std::array<Twist, N> a;
+        std::array<Wrench, N> f;
+    };
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_FIXEDCHAINJNTTOJACSOLVER_HPP
+#define KDL_FIXEDCHAINJNTTOJACSOLVER_HPP
+
+#include "fixedchain.hpp"
+#include "solveri.hpp"
+
+namespace KDL {
+
+    /**
+     * Jacobian of a FixedChain<N>, with the same convention as
+     * ChainJntToJacSolver: expressed in the base frame, with the chain tip
+     * as reference point. The segment loop is unrolled at compile time and
+     * no memory is allocated.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<unsigned int N>
+    class FixedChainJntToJacSolver : public SolverI
+    {
+    public:
+        typedef typename FixedChain<N>::JntVector JntVector;
+        typedef typename FixedChain<N>::JacobianMatrix JacobianMatrix;
+
+        explicit FixedChainJntToJacSolver(const FixedChain<N>& _chain):
+            chain(_chain)
+        {
+        }
+
+        /**
+         * Calculate the jacobian expressed in the base frame with the
+         * chain tip as reference point.
+         * \param q_in The joint positions
+         * \param jac The resulting jacobian
+         */
+        int JntToJac(const JntVector& q_in, JacobianMatrix& jac)
+        {
+            Frame p_out;
+            return JntToJac(q_in, jac, p_out);
+        }
+
+        /**
+         * Same as JntToJac(q_in, jac), also returning the pose of the chain
+         * tip that comes out of the same sweep.
+         */
+        int JntToJac(const JntVector& q_in, JacobianMatrix& jac, Frame& p_out)
+        {
+            if (!chain.isValid())
+                return (error = E_NOT_UP_TO_DATE);
+            Frame F;
+            const FixedChain<N>& c = chain;
+            FixedChainUnroll<0,N>::forward([&](unsigned int j) {
+                //unit twist of joint j expressed in the base, with the origin of body j as reference point
+                F = (j == 0) ? c.pose(j, q_in(j)) : F * c.pose(j, q_in(j));
+                t[j] = F.M * c.getMotionSubspace(j);
+                p[j] = F.p;
+            });
+            p_out = F * chain.getFrameToEnd();
+            FixedChainUnroll<0,N>::forward([&](unsigned int j) {
+                const Twist t_ee = t[j].RefPoint(p_out.p - p[j]);
+                jac.col(j) << t_ee.vel.x(), t_ee.vel.y(), t_ee.vel.z(),
+                              t_ee.rot.x(), t_ee.rot.y(), t_ee.rot.z();
+            });
+            return (error = E_NOERROR);
+        }
+
+        virtual void updateInternalDataStructures() {}
+
+        /// @copydoc KDL::SolverI::clone
+        virtual FixedChainJntToJacSolver* clone() const { return new FixedChainJntToJacSolver(*this); }
+
+    private:
+        const FixedChain<N>& chain;
+        std::array<Twist, N> t;
+        std::array<Vector, N> p;
+    };
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "flattree.hpp"
+
+namespace KDL
+{
+    FlatTree::FlatTree():
+        nrOfJoints(0)
+    {
+        update(Tree());
+    }
+
+    FlatTree::FlatTree(const Tree& tree):
+        nrOfJoints(0)
+    {
+        update(tree);
+    }
+
+    void FlatTree::update(const Tree& tree)
+    {
+        const unsigned int n = tree.getNrOfSegments() + 1;
+        segments.clear();
+        parents.clear();
+        q_nrs.clear();
+        names.clear();
+        indices.clear();
+        segments.reserve(n);
+        parents.reserve(n);
+        q_nrs.reserve(n);
+        names.reserve(n);
+        subtree_ends.resize(n);
+        nrOfJoints = tree.getNrOfJoints();
+        addRecursive(tree.getRootSegment(), -1);
+
+        joint_parents.assign(nrOfJoints, -1);
+        for (unsigned int i = 0; i < segments.size(); i++) {
+            if (q_nrs[i] < 0)
+                continue;
+            int p = parents[i];
+            while (p >= 0 && q_nrs[p] < 0)
+                p = parents[p];
+            joint_parents[q_nrs[i]] = p < 0 ? -1 : q_nrs[p];
+        }
+    }
+
+    void FlatTree::addRecursive(SegmentMap::const_iterator element, int parent)
+    {
+        const unsigned int i = segments.size();
+        const Segment& segment = GetTreeElementSegment(element->second);
+        segments.push_back(segment);
+        parents.push_back(parent);
+        // the root has no parent and is never moving, whatever its joint
+        if (parent >= 0 && segment.getJoint().getType() != Joint::Fixed)
+            q_nrs.push_back(GetTreeElementQNr(element->second));
+        else
+            q_nrs.push_back(-1);
+        names.push_back(element->first);
+        indices[element->first] = i;
+
+        const std::vector<SegmentMap::const_iterator>& children = GetTreeElementChildren(element->second);
+        for (unsigned int c = 0; c < children.size(); c++)
+            addRecursive(children[c], i);
+        subtree_ends[i] = segments.size();
+    }
+
+    int FlatTree::getIndex(const std::string& name) const
+    {
+        std::map<std::string, unsigned int>::const_iterator it = indices.find(name);
+        if (it == indices.end())
+            return -1;
+        return it->second;
+    }
+}
@@ -0,0 +1,137 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_FLATTREE_HPP
+#define KDL_FLATTREE_HPP
+
+#include "tree.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace KDL
+{
+    /**
+     * \brief Flattened, index based view of a KDL::Tree for the tree solvers.
+     *
+     * The elements of the tree, including the root, are stored in
+     * contiguous arrays in depth-first pre-order: the root has index 0,
+     * every element comes after its parent and the descendants of
+     * element i are the elements i+1 .. getSubtreeEnd(i)-1. Forward
+     * (root to leaves) sweeps are plain loops over increasing indices
+     * and backward sweeps loops over decreasing indices, without any
+     * map lookups or recursion.
+     *
+     * Names only have to be resolved, through getIndex(), when setting
+     * up a computation. The segments are copied, so the view does not
+     * follow later changes of the tree: call update() after modifying it.
+     */
+    class FlatTree
+    {
+    public:
+        /// Empty view, holding only a root element
+        FlatTree();
+
+        /// View of tree
+        explicit FlatTree(const Tree& tree);
+
+        /// Rebuild the view from tree
+        void update(const Tree& tree);
+
+        /// Number of elements, the root included (Tree::getNrOfSegments()+1)
+        unsigned int getNrOfElements() const { return segments.size(); }
+
+        unsigned int getNrOfJoints() const { return nrOfJoints; }
+
+        const Segment& getSegment(unsigned int i) const { return segments[i]; }
+
+        /// Index of the parent of element i, -1 for the root
+        int getParent(unsigned int i) const { return parents[i]; }
+
+        /// Joint number of element i, -1 if its joint is fixed
+        int getQNr(unsigned int i) const { return q_nrs[i]; }
+
+        /**
+         * Parent joint of every joint: the number of the joint of the
+         * nearest moving ancestor, -1 if there is none. The parent joint
+         * always has a lower number, see KDL::ltl_factorize().
+         */
+        const std::vector<int>& getJointParents() const { return joint_parents; }
+
+        /// One past the index of the last descendant of element i
+        unsigned int getSubtreeEnd(unsigned int i) const { return subtree_ends[i]; }
+
+        const std::string& getName(unsigned int i) const { return names[i]; }
+
+        /// Index of the element with the given name, -1 if there is none
+        int getIndex(const std::string& name) const;
+
+    private:
+        void addRecursive(SegmentMap::const_iterator element, int parent);
+
+        std::vector<Segment> segments;
+        std::vector<int> parents;
+        std::vector<int> q_nrs;
+        std::vector<int> joint_parents;
+        std::vector<unsigned int> subtree_ends;
+        std::vector<std::string> names;
+        std::map<std::string, unsigned int> indices;
+        unsigned int nrOfJoints;
+    };
+
+    /**
+     * \brief Indices in a FlatTree of the keys of a name keyed map, such
+     * as a WrenchMap, kept from one call of a solver to the next.
+     *
+     * resolve() only compares the keys with those of the previous call
+     * and looks them up with FlatTree::getIndex() when they changed, so a
+     * solver called every cycle with the same keys does no lookups.
+     */
+    class FlatTreeIndices
+    {
+    public:
+        /// Index of every key of map in flat, in map order, -1 for unknown keys
+        template<typename Map>
+        const std::vector<int>& resolve(const FlatTree& flat, const Map& map)
+        {
+            bool same = map.size() == names.size();
+            typename Map::const_iterator it = map.begin();
+            for (unsigned int k = 0; same && k < names.size(); ++k, ++it)
+                same = it->first == names[k];
+            if (!same) {
+                names.clear();
+                indices.clear();
+                for (it = map.begin(); it != map.end(); ++it) {
+                    names.push_back(it->first);
+                    indices.push_back(flat.getIndex(it->first));
+                }
+            }
+            return indices;
+        }
+
+        /// Forget the resolved keys, needed after FlatTree::update()
+        void clear() { names.clear(); indices.clear(); }
+
+    private:
+        std::vector<std::string> names;
+        std::vector<int> indices;
+    };
+}
+
+#endif
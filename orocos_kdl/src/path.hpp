@@ -86,7 +86,7 @@ class Path
 		 * This is not always a physical length , ie when dealing with rotations
 		 * that are dominant.
 		 */
-		virtual double PathLength() = 0;
+		virtual double PathLength() const = 0;
 
 		/**
 		 * Returns the Frame at the current path length s
@@ -102,7 +102,7 @@ double Path_Circle::LengthToS(double length) {
 }
 
 
-double Path_Circle::PathLength() {
+double Path_Circle::PathLength() const {
 	return pathlength;
 }
 
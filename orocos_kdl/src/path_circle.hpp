@@ -94,7 +94,7 @@ class Path_Circle : public Path
 
 		double LengthToS(double length);
 
-		virtual double PathLength();
+		virtual double PathLength() const;
 		virtual Frame Pos(double s) const;
 		virtual Twist Vel(double s,double sd) const;
 		virtual Twist Acc(double s,double sd,double sdd) const;
@@ -43,40 +43,31 @@
 #include "path_composite.hpp"
 #include "utilities/error.h"
 #include "utilities/scoped_ptr.hpp"
+#include <algorithm>
 #include <memory>
 
 namespace KDL {
 
 // s should be in allowable limits, this is not checked
-// simple linear search : TODO : make it binary search
-// uses cached_... variables
-// returns the relative path length within the segment
-// you probably want to use the cached_index variable
-double Path_Composite::Lookup(double s) const
+// binary search for the first segment ending at or after s
+int Path_Composite::Lookup(double s, double& inner_s) const
 {
 	assert(s>=-1e-12);
 	assert(s<=pathlength+1e-12);
-	if ( (cached_starts <=s) && ( s <= cached_ends) ) {
-		return s - cached_starts;
+	if (dv.empty()) {
+		inner_s = 0;
+		return 0;
 	}
-	double previous_s=0;
-	for (unsigned int i=0;i<dv.size();++i) {
-		if ((s <= dv[i])||(i == (dv.size()-1) )) {
-			cached_index = i;
-			cached_starts = previous_s;
-			cached_ends   = dv[i];
-			return s - previous_s;
-		}
-		previous_s = dv[i];
-	}
-	return 0;
+	DoubleVector::const_iterator it = std::lower_bound(dv.begin(), dv.end(), s);
+	if (it == dv.end())
+		--it;
+	const int i = static_cast<int>(it - dv.begin());
+	inner_s = (i == 0) ? s : s - dv[i-1];
+	return i;
 }
 
 Path_Composite::Path_Composite() {
 	pathlength    = 0;
-	cached_starts = 0;
-	cached_ends   = 0;
-	cached_index  = 0;
 }
 
 void Path_Composite::Add(Path* geom, bool aggregate ) {
@@ -90,24 +81,27 @@ double Path_Composite::LengthToS(double length) {
 	return 0;
 }
 
-double Path_Composite::PathLength() {
+double Path_Composite::PathLength() const {
 	return pathlength;
 }
 
 
 Frame Path_Composite::Pos(double s) const {
-	s = Lookup(s);
-	return gv[cached_index].first->Pos(s);
+	double inner_s;
+	const int i = Lookup(s, inner_s);
+	return gv[i].first->Pos(inner_s);
 }
 
 Twist Path_Composite::Vel(double s,double sd) const {
-	s = Lookup(s);
-	return gv[cached_index].first->Vel(s,sd);
+	double inner_s;
+	const int i = Lookup(s, inner_s);
+	return gv[i].first->Vel(inner_s,sd);
 }
 
 Twist Path_Composite::Acc(double s,double sd,double sdd) const {
-	s = Lookup(s);
-	return gv[cached_index].first->Acc(s,sd,sdd);
+	double inner_s;
+	const int i = Lookup(s, inner_s);
+	return gv[i].first->Acc(inner_s,sd,sdd);
 }
 
 Path* Path_Composite::Clone()  {
@@ -146,8 +140,7 @@ double Path_Composite::GetLengthToEndOfSegment(int i) {
 void Path_Composite::GetCurrentSegmentLocation(double s, int& segment_number,
 		double& inner_s)
 {
-	inner_s = Lookup(s);
-	segment_number= cached_index;
+	segment_number = Lookup(s, inner_s);
 }
 
 Path_Composite::~Path_Composite() {
@@ -55,10 +55,9 @@ namespace KDL {
 	  * A Path being the composition of other Path objects.
 	  *
 	  * For several of its methods, this class needs to lookup the segment corresponding to a value
-	  * of the path variable s.  To increase efficiency, this value is cached.
-	  *
-	  * \TODO Currently a linear search is used to look up the segment. A binary search is more efficient.  Can STL be used for this ?
-	  * \TODO Increase the efficiency for caching for the common case of a fine grained monotonously increasing path variable s.
+	  * of the path variable s.  The lengths to the end of the segments are stored cumulatively and
+	  * searched with a binary search, without any cached state, so that the const methods can be
+	  * called from several threads at once.
 	  *
 	  * \TODO For all Path.., VelocityProfile.., Trajectory... check the bounds on the inputs with asserts.
 	  *
@@ -75,11 +74,9 @@ namespace KDL {
 		DoubleVector   dv;
 		double pathlength;
 
-		// lookup mechanism :
-		mutable double cached_starts;
-		mutable double cached_ends;
-		mutable int    cached_index;
-		double Lookup(double s) const;
+		// lookup mechanism : returns the index of the segment containing s
+		// and sets inner_s to the path length within that segment
+		int Lookup(double s, double& inner_s) const;
 	public:
 
 
@@ -98,7 +95,7 @@ namespace KDL {
 		 * This is not always a physical length , ie when dealing with rotations
 		 * that are dominant.
 		 */
-		virtual double PathLength();
+		virtual double PathLength() const;
 
 		/**
 		 * Returns the Frame at the current path length s
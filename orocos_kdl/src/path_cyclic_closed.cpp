@@ -53,7 +53,7 @@ double Path_Cyclic_Closed::LengthToS(double length) {
 	return 0;
 }
 
-double Path_Cyclic_Closed::PathLength(){
+double Path_Cyclic_Closed::PathLength() const {
 	return geom->PathLength()*times;
 }
 
@@ -65,7 +65,7 @@ namespace KDL {
 	public:
 		Path_Cyclic_Closed(Path* _geom,int _times, bool _aggregate=true);
 		virtual double LengthToS(double length);
-		virtual double PathLength();
+		virtual double PathLength() const;
 		virtual Frame Pos(double s) const;
 		virtual Twist Vel(double s,double sd) const;
 		virtual Twist Acc(double s,double sd,double sdd) const;
@@ -129,7 +129,7 @@ Path_Line::Path_Line(const Frame& startpos,
 double Path_Line::LengthToS(double length) {
 	return length/scalelin;
 }
-double Path_Line::PathLength(){
+double Path_Line::PathLength() const {
 	return pathlength;
 }
 Frame Path_Line::Pos(double s) const  {
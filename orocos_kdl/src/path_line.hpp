@@ -115,7 +115,7 @@ class Path_Line : public Path
 			double eqradius,
 			bool _aggregate=true);
 		double LengthToS(double length);
-		virtual double PathLength();
+		virtual double PathLength() const;
 		virtual Frame Pos(double s) const;
 		virtual Twist Vel(double s,double sd) const ;
 		virtual Twist Acc(double s,double sd,double sdd) const;
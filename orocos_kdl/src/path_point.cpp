@@ -52,7 +52,7 @@ Path_Point::Path_Point(const Frame& startpos)
 double Path_Point::LengthToS(double length) {
 	return length;
 }
-double Path_Point::PathLength(){
+double Path_Point::PathLength() const {
 	return 0;
 }
 Frame Path_Point::Pos(double s) const  {
@@ -67,7 +67,7 @@ class Path_Point : public Path
 		 */
 		Path_Point(const Frame& F_base_start);
 		double LengthToS(double length);
-		virtual double PathLength();
+		virtual double PathLength() const;
 		virtual Frame Pos(double s) const;
 		virtual Twist Vel(double s,double sd) const ;
 		virtual Twist Acc(double s,double sd,double sdd) const;
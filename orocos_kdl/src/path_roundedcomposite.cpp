@@ -149,7 +149,7 @@ double Path_RoundedComposite::LengthToS(double length) {
 }
 
 
-double Path_RoundedComposite::PathLength() {
+double Path_RoundedComposite::PathLength() const {
 	return comp->PathLength();
 }
 
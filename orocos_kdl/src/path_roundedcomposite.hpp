@@ -123,7 +123,7 @@ class Path_RoundedComposite : public Path
 		 * This is not always a physical length , ie when dealing with rotations
 		 * that are dominant.
 		 */
-		virtual double PathLength();
+		virtual double PathLength() const;
 
 
 		/**
@@ -144,6 +144,17 @@ public:
 	 */
 	virtual void updateInternalDataStructures() = 0;
 
+	/**
+	 * Create a copy of the solver with its own internal state, working
+	 * on the same chain or tree, e.g. to use it from another thread (see
+	 * KDL::SolverPool). Solvers that refer to other solvers, like
+	 * KDL::ChainIkSolverPos_NR, can not be copied this way and return 0.
+	 * Derived classes of a solver that can be cloned have to override
+	 * clone() as well.
+	 * \return the new solver, owned by the caller, or 0
+	 */
+	virtual SolverI* clone() const { return 0; }
+
 protected:
 	/// Latest error, initialized to E_NOERROR in constructor
 	int		error;
@@ -0,0 +1,159 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#ifndef KDL_SOLVERPOOL_HPP
+#define KDL_SOLVERPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace KDL {
+
+    /**
+     * A fixed set of copies of a solver, made with SolverI::clone(),
+     * that threads check out to use one of them exclusively. All copies
+     * work on the chain or tree of the prototype solver, which has to
+     * outlive the pool.
+     *
+     * Checking out is lock free: every copy has a busy flag that is
+     * claimed with an atomic exchange, starting at a slot picked from
+     * the id of the calling thread so that a thread mostly gets the
+     * same copy back. When all copies are busy an extra copy is cloned
+     * for the caller and deleted on check in, so checking out never
+     * blocks; size the pool to the number of threads to avoid this.
+     *
+     * \code
+     * ChainJntToJacSolver jacsolver(chain);
+     * SolverPool<ChainJntToJacSolver> pool(jacsolver);
+     * // in any thread
+     * {
+     *     SolverPool<ChainJntToJacSolver>::Handle solver = pool.checkout();
+     *     solver->JntToJac(q, jac);
+     * } // checked in again
+     * \endcode
+     *
+     * T has to be a solver that can be cloned, solvers that refer to
+     * other solvers do not compile as T.
+     */
+    template <typename T>
+    class SolverPool
+    {
+    public:
+        /**
+         * Exclusive access to one solver of the pool, checked in again
+         * on destruction. Handles can be moved, not copied.
+         */
+        class Handle
+        {
+        public:
+            Handle(Handle&& other) : pool(other.pool), slot(other.slot), solver(other.solver)
+            {
+                other.solver = 0;
+            }
+
+            ~Handle()
+            {
+                if (solver == 0)
+                    return;
+                if (slot < 0)
+                    delete solver;
+                else
+                    pool->busy[slot].store(false, std::memory_order_release);
+            }
+
+            T& operator*() const { return *solver; }
+            T* operator->() const { return solver; }
+            T* get() const { return solver; }
+
+        private:
+            friend class SolverPool;
+            Handle(SolverPool* _pool, int _slot, T* _solver) : pool(_pool), slot(_slot), solver(_solver) {}
+            Handle(const Handle&) = delete;
+            Handle& operator=(const Handle&) = delete;
+
+            SolverPool* pool;
+            int slot;
+            T* solver;
+        };
+
+        /**
+         * @param prototype the solver to copy
+         * @param size the number of copies; 0 uses one per hardware thread
+         */
+        explicit SolverPool(const T& _prototype, unsigned int size=0) :
+            prototype(_prototype.clone()), busy(0)
+        {
+            if (size == 0)
+                size = std::max(1u, std::thread::hardware_concurrency());
+            busy = new std::atomic<bool>[size];
+            for (unsigned int i = 0; i < size; i++) {
+                solvers.push_back(prototype->clone());
+                busy[i].store(false);
+            }
+        }
+
+        ~SolverPool()
+        {
+            for (unsigned int i = 0; i < solvers.size(); i++)
+                delete solvers[i];
+            delete[] busy;
+            delete prototype;
+        }
+
+        /// Check out a solver, check it in by destroying the handle
+        Handle checkout()
+        {
+            const unsigned int n = solvers.size();
+            const unsigned int first = std::hash<std::thread::id>()(std::this_thread::get_id()) % n;
+            for (unsigned int k = 0; k < n; k++) {
+                const unsigned int i = (first + k) % n;
+                if (!busy[i].load(std::memory_order_relaxed) && !busy[i].exchange(true, std::memory_order_acquire))
+                    return Handle(this, i, solvers[i]);
+            }
+            return Handle(this, -1, prototype->clone());
+        }
+
+        unsigned int size() const { return solvers.size(); }
+
+        /**
+         * Call updateInternalDataStructures() on all solvers after
+         * changing the chain, no solver may be checked out meanwhile.
+         */
+        void updateInternalDataStructures()
+        {
+            prototype->updateInternalDataStructures();
+            for (unsigned int i = 0; i < solvers.size(); i++)
+                solvers[i]->updateInternalDataStructures();
+        }
+
+    private:
+        SolverPool(const SolverPool&) = delete;
+        SolverPool& operator=(const SolverPool&) = delete;
+
+        T* prototype;
+        std::vector<T*> solvers;
+        std::atomic<bool>* busy;
+    };
+
+}
+
+#endif
@@ -0,0 +1,220 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#include "trajectory_baked.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace KDL {
+
+	namespace {
+		// Rotation vector of R, also accurate for the small angles that
+		// Rotation::GetRot() rounds to zero
+		Vector RotVec(const Rotation& R)
+		{
+			const Vector v = 0.5*Vector(R(2,1)-R(1,2), R(0,2)-R(2,0), R(1,0)-R(0,1));
+			const double s = v.Norm();
+			const double c = 0.5*(R(0,0)+R(1,1)+R(2,2)-1.0);
+			if (c < 0)
+				return R.GetRot();
+			return (s < 1e-12) ? v : v*(std::atan2(s, c)/s);
+		}
+	}
+
+	Trajectory_Baked::Trajectory_Baked(const Trajectory& traj, double _period):
+		period(_period), duration(traj.Duration())
+	{
+		assert(period > 0);
+		// last sample at the end, a shorter last interval if needed
+		const unsigned int n = (unsigned int)std::max(0.0, std::ceil(duration/period - 1e-9)) + 1;
+		std::vector<Frame> pos(n);
+		std::vector<Twist> vel(n), acc(n);
+		for (unsigned int i = 0; i < n; ++i) {
+			const double time = std::min(i*period, duration);
+			pos[i] = traj.Pos(time);
+			vel[i] = traj.Vel(time);
+			acc[i] = traj.Acc(time);
+		}
+		Init(pos, vel, acc);
+	}
+
+	Trajectory_Baked::Trajectory_Baked(double _period, double _duration, const std::vector<Frame>& pos,
+									   const std::vector<Twist>& vel, const std::vector<Twist>& acc):
+		period(_period), duration(_duration)
+	{
+		assert(period > 0);
+		assert(!pos.empty() && pos.size() == vel.size() && pos.size() == acc.size());
+		Init(pos, vel, acc);
+	}
+
+	void Trajectory_Baked::Init(const std::vector<Frame>& pos, const std::vector<Twist>& vel, const std::vector<Twist>& acc)
+	{
+		nrofsamples = pos.size();
+		for (int c = 0; c < NR_OF_CHANNELS; ++c)
+			channels[c].resize(nrofsamples);
+		for (unsigned int i = 0; i < nrofsamples; ++i) {
+			for (int k = 0; k < 3; ++k) {
+				channels[PX+k][i] = pos[i].p(k);
+				channels[VX+k][i] = vel[i].vel(k);
+				channels[WX+k][i] = vel[i].rot(k);
+				channels[AX+k][i] = acc[i].vel(k);
+				channels[BX+k][i] = acc[i].rot(k);
+			}
+			pos[i].M.GetQuaternion(channels[QX][i], channels[QY][i], channels[QZ][i], channels[QW][i]);
+			Vector d = Vector::Zero(), e = Vector::Zero();
+			if (i+1 < nrofsamples) {
+				// R(tau) = R_i*Rot(theta(tau)) reaches R_i+1 at theta = d, where
+				// the angular velocity w_i+1 needs dtheta/dt = Jr(d)^-1*R_i+1^T*w_i+1,
+				// with Jr the right jacobian of the rotation vector
+				d = RotVec(pos[i].M.Inverse()*pos[i+1].M);
+				const Vector w = pos[i+1].M.Inverse(vel[i+1].rot);
+				const double a = d.Norm();
+				const double c = (a < 1e-4) ? 1.0/12.0 : 1.0/(a*a) - (1.0 + std::cos(a))/(2.0*a*std::sin(a));
+				e = w + 0.5*(d*w) + c*(d*(d*w));
+			}
+			for (int k = 0; k < 3; ++k) {
+				channels[DX+k][i] = d(k);
+				channels[EX+k][i] = e(k);
+			}
+		}
+	}
+
+	unsigned int Trajectory_Baked::Lookup(double time, double& tau, double& h) const
+	{
+		h = period;
+		if (nrofsamples < 2 || !(time > 0)) {
+			tau = 0;
+			return 0;
+		}
+		if (time >= duration) {
+			tau = 1;
+			h = duration - (nrofsamples-2)*period;
+			return nrofsamples-2;
+		}
+		const unsigned int i = std::min((unsigned int)(time/period), nrofsamples-2);
+		if (i == nrofsamples-2)
+			h = duration - i*period;
+		tau = (h > 0) ? std::min((time - i*period)/h, 1.0) : 0.0;
+		return i;
+	}
+
+	Vector Trajectory_Baked::Get(int channel, unsigned int i) const
+	{
+		return Vector(channels[channel][i], channels[channel+1][i], channels[channel+2][i]);
+	}
+
+	double Trajectory_Baked::Duration() const {
+		return duration;
+	}
+
+	Frame Trajectory_Baked::Pos(double time) const {
+		double tau, h;
+		const unsigned int i = Lookup(time, tau, h);
+		const Rotation R0 = Rotation::Quaternion(channels[QX][i], channels[QY][i], channels[QZ][i], channels[QW][i]);
+		if (nrofsamples < 2)
+			return Frame(R0, Get(PX, i));
+
+		// quintic Hermite basis on position, velocity and acceleration
+		const double t2 = tau*tau, t3 = t2*tau, t4 = t3*tau, t5 = t4*tau;
+		const double h0 = 1 - 10*t3 + 15*t4 - 6*t5;
+		const double h1 = tau - 6*t3 + 8*t4 - 3*t5;
+		const double h2 = 0.5*t2 - 1.5*t3 + 1.5*t4 - 0.5*t5;
+		const double h3 = 10*t3 - 15*t4 + 6*t5;
+		const double h4 = -4*t3 + 7*t4 - 3*t5;
+		const double h5 = 0.5*t3 - t4 + 0.5*t5;
+		const Vector p = h0*Get(PX, i) + (h1*h)*Get(VX, i) + (h2*h*h)*Get(AX, i)
+			+ h3*Get(PX, i+1) + (h4*h)*Get(VX, i+1) + (h5*h*h)*Get(AX, i+1);
+
+		// cubic Hermite on the rotation vector from sample i to i+1
+		const double c10 = t3 - 2*t2 + tau;
+		const double c01 = -2*t3 + 3*t2;
+		const double c11 = t3 - t2;
+		const Vector w0 = R0.Inverse(Get(WX, i));
+		const Vector theta = (c10*h)*w0 + c01*Get(DX, i) + (c11*h)*Get(EX, i);
+		// not Rotation::Rot(), that drops the axis of angles below epsilon
+		const double angle = theta.Norm();
+		return Frame(angle > 0 ? R0*Rotation::Rot2(theta/angle, angle) : R0, p);
+	}
+
+	Twist Trajectory_Baked::Vel(double time) const {
+		double tau, h;
+		const unsigned int i = Lookup(time, tau, h);
+		if (nrofsamples < 2)
+			return Twist(Get(VX, i), Get(WX, i));
+		const double t2 = tau*tau, t3 = t2*tau;
+		const double c00 = 2*t3 - 3*t2 + 1;
+		const double c10 = (t3 - 2*t2 + tau)*h;
+		const double c01 = -2*t3 + 3*t2;
+		const double c11 = (t3 - t2)*h;
+		return Twist(c00*Get(VX, i) + c10*Get(AX, i) + c01*Get(VX, i+1) + c11*Get(AX, i+1),
+					 c00*Get(WX, i) + c10*Get(BX, i) + c01*Get(WX, i+1) + c11*Get(BX, i+1));
+	}
+
+	Twist Trajectory_Baked::Acc(double time) const {
+		double tau, h;
+		const unsigned int i = Lookup(time, tau, h);
+		if (nrofsamples < 2)
+			return Twist(Get(AX, i), Get(BX, i));
+		return Twist((1-tau)*Get(AX, i) + tau*Get(AX, i+1),
+					 (1-tau)*Get(BX, i) + tau*Get(BX, i+1));
+	}
+
+	Trajectory_Baked::ErrorReport Trajectory_Baked::Compare(const Trajectory& reference, unsigned int nrofsubsamples) const
+	{
+		ErrorReport report;
+		const unsigned int n = std::max(nrofsamples, 2u) - 1;
+		for (unsigned int i = 0; i < n; ++i) {
+			for (unsigned int k = 0; k <= nrofsubsamples; ++k) {
+				const double time = std::min((i + double(k)/(nrofsubsamples+1))*period, duration);
+				const Frame f_ref = reference.Pos(time);
+				const Frame f = Pos(time);
+				const double e_pos = (f.p - f_ref.p).Norm();
+				if (e_pos > report.pos) {
+					report.pos = e_pos;
+					report.time_pos = time;
+				}
+				report.rot = std::max(report.rot, RotVec(f_ref.M.Inverse()*f.M).Norm());
+				const Twist dv = Vel(time) - reference.Vel(time);
+				report.vel = std::max(report.vel, std::sqrt(dot(dv.vel, dv.vel) + dot(dv.rot, dv.rot)));
+				const Twist da = Acc(time) - reference.Acc(time);
+				report.acc = std::max(report.acc, std::sqrt(dot(da.vel, da.vel) + dot(da.rot, da.rot)));
+			}
+		}
+		return report;
+	}
+
+	size_t Trajectory_Baked::BytesPerSample() {
+		return NR_OF_CHANNELS*sizeof(double);
+	}
+
+	size_t Trajectory_Baked::BytesPerSecond(double period) {
+		return (size_t)std::ceil(BytesPerSample()/period);
+	}
+
+	void Trajectory_Baked::Write(std::ostream& os) const {
+		os << "BAKED[ " << period << " " << duration << " " << nrofsamples << std::endl;
+		os << "]";
+	}
+
+	Trajectory* Trajectory_Baked::Clone() const {
+		return new Trajectory_Baked(*this);
+	}
+
+}
@@ -0,0 +1,131 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_TRAJECTORY_BAKED_HPP
+#define KDL_TRAJECTORY_BAKED_HPP
+
+#include "trajectory.hpp"
+#include <vector>
+
+namespace KDL {
+
+	/**
+	 * A trajectory sampled once at a fixed period, for evaluation in a
+	 * control loop.
+	 *
+	 * The constructor evaluates Pos, Vel and Acc of another trajectory at
+	 * every multiple of the period and at its end, and stores them as a
+	 * structure of arrays: one contiguous array per coordinate. Pos, Vel
+	 * and Acc then only compute an index and interpolate between the two
+	 * neighbouring samples:
+	 *  - the position with a quintic Hermite polynomial on the sampled
+	 *    position, velocity and acceleration,
+	 *  - the orientation as the rotation of the first sample followed by
+	 *    a cubic Hermite interpolation of the rotation vector towards the
+	 *    second one, with the sampled angular velocities as tangents,
+	 *  - the twist with a cubic Hermite polynomial on the sampled twist
+	 *    and acceleration,
+	 *  - the acceleration linearly.
+	 * Samples are exact, the interpolation error between them can be
+	 * measured against the original trajectory with Compare().
+	 *
+	 * A sample takes BytesPerSample() bytes, so a second of trajectory
+	 * costs BytesPerSecond(period), e.g. 200 kB at 1 kHz.
+	 *
+	 * Evaluation does not modify the object, so it can be done from
+	 * several threads at once.
+	 * @ingroup Motion
+	 */
+	class Trajectory_Baked : public Trajectory
+	{
+	public:
+		/// Largest differences with a reference trajectory, see Compare()
+		struct ErrorReport {
+			double pos;       //!< norm of the position difference
+			double rot;       //!< angle of the orientation difference
+			double vel;       //!< norm of the twist difference
+			double acc;       //!< norm of the acceleration difference
+			double time_pos;  //!< time of the largest position difference
+			ErrorReport() : pos(0), rot(0), vel(0), acc(0), time_pos(0) {}
+		};
+
+		/**
+		 * Samples traj.
+		 * @param traj trajectory to sample, not stored
+		 * @param period sample period, > 0
+		 */
+		Trajectory_Baked(const Trajectory& traj, double period);
+
+		/**
+		 * Uses the given samples, taken at the multiples of period; the
+		 * last interval may be shorter than period.
+		 * @param period sample period, > 0
+		 * @param duration time of the last sample
+		 * @param pos, vel, acc samples, all of the same size
+		 */
+		Trajectory_Baked(double period, double duration, const std::vector<Frame>& pos,
+						 const std::vector<Twist>& vel, const std::vector<Twist>& acc);
+
+		virtual double Duration() const;
+		virtual Frame Pos(double time) const;
+		virtual Twist Vel(double time) const;
+		virtual Twist Acc(double time) const;
+
+		/**
+		 * Largest differences between this trajectory and reference,
+		 * evaluated at nrofsubsamples points in every sample interval.
+		 */
+		ErrorReport Compare(const Trajectory& reference, unsigned int nrofsubsamples=4) const;
+
+		double Period() const { return period; }
+		unsigned int NrOfSamples() const { return nrofsamples; }
+
+		/// Memory taken by one sample
+		static size_t BytesPerSample();
+
+		/// Memory taken by a second of trajectory sampled at period
+		static size_t BytesPerSecond(double period);
+
+		/// Memory taken by the samples of this trajectory
+		size_t Bytes() const { return nrofsamples * BytesPerSample(); }
+
+		virtual void Write(std::ostream& os) const;
+		virtual Trajectory* Clone() const;
+		virtual ~Trajectory_Baked() {}
+
+	private:
+		// position, orientation (quaternion), twist, acceleration, the
+		// rotation vector from a sample to the next one in the sample frame
+		// and its derivative at the next sample
+		enum { PX, PY, PZ, QX, QY, QZ, QW, VX, VY, VZ, WX, WY, WZ,
+			   AX, AY, AZ, BX, BY, BZ, DX, DY, DZ, EX, EY, EZ, NR_OF_CHANNELS };
+
+		void Init(const std::vector<Frame>& pos, const std::vector<Twist>& vel, const std::vector<Twist>& acc);
+		// sample interval containing time: index, normalized time and length
+		unsigned int Lookup(double time, double& tau, double& h) const;
+		Vector Get(int channel, unsigned int i) const;
+
+		double period;
+		double duration;
+		unsigned int nrofsamples;
+		std::vector<double> channels[NR_OF_CHANNELS];
+	};
+
+}
+
+#endif
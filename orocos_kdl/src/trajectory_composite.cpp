@@ -15,6 +15,7 @@
 
 #include "trajectory_composite.hpp"
 #include "path_composite.hpp"
+#include <algorithm>
 
 namespace KDL {
 
@@ -26,63 +27,39 @@ namespace KDL {
         return duration;
     }
 
-    Frame Trajectory_Composite::Pos(double time) const {
-        // not optimal, could be done in log(#elem)
-        // or one could buffer the last segment and start looking from there.
-        unsigned int i;
-        double previoustime;
-        Trajectory* traj;
+    unsigned int Trajectory_Composite::Lookup(double time, double& local_time) const {
         if (time < 0) {
-            return vt[0]->Pos(0);
+            local_time = 0;
+            return 0;
         }
-        previoustime = 0;
-        for (i=0;i<vt.size();i++) {
-            if (time < vd[i]) {
-                return vt[i]->Pos(time-previoustime);
-            }
-            previoustime = vd[i];
+        // first element ending after time
+        VectorDouble::const_iterator it = std::upper_bound(vd.begin(), vd.end(), time);
+        if (it == vd.end()) {
+            local_time = vt.back()->Duration();
+            return vt.size()-1;
         }
-        traj = vt[vt.size()-1];
-        return traj->Pos(traj->Duration());
+        const unsigned int i = it - vd.begin();
+        local_time = (i == 0) ? time : time - vd[i-1];
+        return i;
+    }
+
+    Frame Trajectory_Composite::Pos(double time) const {
+        double local_time;
+        const unsigned int i = Lookup(time, local_time);
+        return vt[i]->Pos(local_time);
     }
 
 
     Twist Trajectory_Composite::Vel(double time) const {
-        // not optimal, could be done in log(#elem)
-        unsigned int i;
-        Trajectory* traj;
-        double previoustime;
-        if (time < 0) {
-            return vt[0]->Vel(0);
-        }
-        previoustime = 0;
-        for (i=0;i<vt.size();i++) {
-            if (time < vd[i]) {
-                return vt[i]->Vel(time-previoustime);
-            }
-            previoustime = vd[i];
-        }
-        traj = vt[vt.size()-1];
-        return traj->Vel(traj->Duration());
+        double local_time;
+        const unsigned int i = Lookup(time, local_time);
+        return vt[i]->Vel(local_time);
     }
 
     Twist Trajectory_Composite::Acc(double time) const {
-        // not optimal, could be done in log(#elem)
-    	unsigned int i;
-        Trajectory* traj;
-        double previoustime;
-        if (time < 0) {
-            return vt[0]->Acc(0);
-        }
-        previoustime = 0;
-        for (i=0;i<vt.size();i++) {
-		if (time < vd[i]) {
-			return vt[i]->Acc(time-previoustime);
-		}
-		previoustime = vd[i];
-        }
-        traj = vt[vt.size()-1];
-        return traj->Acc(traj->Duration());
+        double local_time;
+        const unsigned int i = Lookup(time, local_time);
+        return vt[i]->Acc(local_time);
     }
 
     void Trajectory_Composite::Add(Trajectory* elem) {
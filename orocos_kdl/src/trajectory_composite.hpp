@@ -27,6 +27,11 @@ namespace KDL {
   /**
    * Trajectory_Composite implements a trajectory that is composed
    * of underlying trajectoria.  Call Add to add a trajectory
+   *
+   * The end times of the elements are stored cumulatively, so Pos, Vel
+   * and Acc find the active element with a binary search in
+   * O(log(#elem)). They do not modify the object, so a composite can be
+   * evaluated from several threads at once.
    * @ingroup Motion
    */
 class Trajectory_Composite: public Trajectory
@@ -38,6 +43,10 @@ class Trajectory_Composite: public Trajectory
 		double duration;    // total duration of the composed
 				    // Trajectory
 
+		// Binary search in vd for the Trajectory active at time,
+		// returns its index and sets local_time to the time within it
+		unsigned int Lookup(double time, double& local_time) const;
+
 	public:
 		Trajectory_Composite();
 		// Constructs an empty composite
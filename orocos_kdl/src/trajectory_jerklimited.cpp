@@ -0,0 +1,153 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#include "trajectory_jerklimited.hpp"
+#include "frames_io.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace KDL {
+
+	namespace {
+		// Rotation vector of R; Rotation::GetRot() returns zero for
+		// angles below 1e-6, which would be a jump in the motion
+		Vector RotVec(const Rotation& R)
+		{
+			const Vector v = 0.5*Vector(R(2,1)-R(1,2), R(0,2)-R(2,0), R(1,0)-R(0,1));
+			const double s = v.Norm();
+			const double c = 0.5*(R(0,0)+R(1,1)+R(2,2)-1.0);
+			if (c < 0)
+				return R.GetRot();
+			return (s < 1e-12) ? v : v*(std::atan2(s, c)/s);
+		}
+
+		Rotation Exp(const Vector& r)
+		{
+			const double angle = r.Norm();
+			return (angle > 0) ? Rotation::Rot2(r/angle, angle) : Rotation::Identity();
+		}
+
+		// The angular velocity of Exp(r(t)) is Jl(r)*rd, with
+		// Jl(r)*x = x + A*(r x x) + B*(r x (r x x)); dA and dB are the
+		// derivatives of A and B to the angle, divided by the angle.
+		void JlCoefficients(double angle, double& A, double& B, double& dA, double& dB)
+		{
+			const double a2 = angle*angle;
+			if (angle < 0.05) {
+				A = 0.5 - a2/24.0;
+				B = 1.0/6.0 - a2/120.0;
+				dA = -1.0/12.0 + a2/180.0;
+				dB = -1.0/60.0 + a2/1260.0;
+			}
+			else {
+				const double s = std::sin(angle), c = std::cos(angle);
+				A = (1.0 - c)/a2;
+				B = (angle - s)/(a2*angle);
+				dA = (angle*s - 2.0*(1.0 - c))/(a2*a2);
+				dB = ((1.0 - c)*angle - 3.0*(angle - s))/(a2*a2*angle);
+			}
+		}
+	}
+
+	Trajectory_JerkLimited::Trajectory_JerkLimited(const Frame& start, double maxvel, double maxacc, double maxjerk,
+												   double maxrotvel, double maxrotacc, double maxrotjerk):
+		origin(start.M), target(start), duration(0.0)
+	{
+		for (int k = 0; k < 3; ++k) {
+			profile[k].SetMax(maxvel, maxacc, maxjerk);
+			profile[k].SetProfile(start.p(k), start.p(k));
+			profile[3+k].SetMax(maxrotvel, maxrotacc, maxrotjerk);
+			profile[3+k].SetProfile(0.0, 0.0);
+		}
+	}
+
+	void Trajectory_JerkLimited::Replan(double time, const Frame& _target)
+	{
+		const Frame pos = Pos(time);
+		const Twist vel = Vel(time);
+		const Twist acc = Acc(time);
+		// with the rotation vector at zero, its derivatives are the angular
+		// velocity and acceleration in the new origin
+		origin = pos.M;
+		target = _target;
+		const Vector rd = pos.M.Inverse(vel.rot);
+		const Vector rdd = pos.M.Inverse(acc.rot);
+		const Vector r_target = RotVec(pos.M.Inverse()*target.M);
+		duration = 0.0;
+		for (int k = 0; k < 3; ++k) {
+			profile[k].SetProfile(pos.p(k), vel.vel(k), acc.vel(k), target.p(k));
+			profile[3+k].SetProfile(0.0, rd(k), rdd(k), r_target(k));
+			duration = std::max(duration, std::max(profile[k].Duration(), profile[3+k].Duration()));
+		}
+	}
+
+	double Trajectory_JerkLimited::Duration() const
+	{
+		return duration;
+	}
+
+	Frame Trajectory_JerkLimited::Pos(double time) const
+	{
+		const Vector p(profile[0].Pos(time), profile[1].Pos(time), profile[2].Pos(time));
+		const Vector r(profile[3].Pos(time), profile[4].Pos(time), profile[5].Pos(time));
+		return Frame(origin*Exp(r), p);
+	}
+
+	Twist Trajectory_JerkLimited::Vel(double time) const
+	{
+		const Vector v(profile[0].Vel(time), profile[1].Vel(time), profile[2].Vel(time));
+		const Vector r(profile[3].Pos(time), profile[4].Pos(time), profile[5].Pos(time));
+		const Vector rd(profile[3].Vel(time), profile[4].Vel(time), profile[5].Vel(time));
+		double A, B, dA, dB;
+		JlCoefficients(r.Norm(), A, B, dA, dB);
+		return Twist(v, origin*(rd + A*(r*rd) + B*(r*(r*rd))));
+	}
+
+	Twist Trajectory_JerkLimited::Acc(double time) const
+	{
+		const Vector acc(profile[0].Acc(time), profile[1].Acc(time), profile[2].Acc(time));
+		const Vector r(profile[3].Pos(time), profile[4].Pos(time), profile[5].Pos(time));
+		const Vector rd(profile[3].Vel(time), profile[4].Vel(time), profile[5].Vel(time));
+		const Vector rdd(profile[3].Acc(time), profile[4].Acc(time), profile[5].Acc(time));
+		double A, B, dA, dB;
+		JlCoefficients(r.Norm(), A, B, dA, dB);
+		// d/dt (Jl(r)*rd)
+		const Vector r_rd = r*rd;
+		const double r_dot_rd = dot(r, rd);
+		const Vector alpha = rdd + A*(r*rdd) + B*(r*(r*rdd))
+			+ (dA*r_dot_rd)*r_rd + (dB*r_dot_rd)*(r*r_rd) + B*(rd*r_rd);
+		return Twist(acc, origin*alpha);
+	}
+
+	void Trajectory_JerkLimited::Write(std::ostream& os) const
+	{
+		os << "JERKLIMITED[ ";
+		profile[0].Write(os);
+		os << " ";
+		profile[3].Write(os);
+		os << std::endl << target << std::endl;
+		os << "]";
+	}
+
+	Trajectory* Trajectory_JerkLimited::Clone() const
+	{
+		return new Trajectory_JerkLimited(*this);
+	}
+
+}
@@ -0,0 +1,84 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#ifndef KDL_TRAJECTORY_JERKLIMITED_HPP
+#define KDL_TRAJECTORY_JERKLIMITED_HPP
+
+#include "trajectory.hpp"
+#include "velocityprofile_jerklimited.hpp"
+
+namespace KDL {
+
+	/**
+	 * An online, time-optimal, jerk-limited Cartesian motion towards a
+	 * target frame that may change at any time.
+	 *
+	 * Replan() starts a new motion from the position, velocity and
+	 * acceleration the current one has at a given time, so calling it at
+	 * every control cycle with the latest target, e.g. a tracked marker,
+	 * gives a motion that is continuous up to the acceleration.
+	 *
+	 * Every axis of the position, and of the rotation vector of the
+	 * orientation relative to the orientation at the last Replan(),
+	 * follows its own VelocityProfile_JerkLimited, so the limits hold per
+	 * axis and the axes are not synchronized: the path to the target is
+	 * not a straight line. Replanning takes about ten microseconds.
+	 * @ingroup Motion
+	 */
+	class Trajectory_JerkLimited : public Trajectory
+	{
+	public:
+		/**
+		 * Standing still at start.
+		 * @param maxvel, maxacc, maxjerk limits per axis of the position
+		 * @param maxrotvel, maxrotacc, maxrotjerk limits per axis of the
+		 * rotation vector
+		 */
+		Trajectory_JerkLimited(const Frame& start, double maxvel, double maxacc, double maxjerk,
+							   double maxrotvel, double maxrotacc, double maxrotjerk);
+
+		/**
+		 * Starts a new motion towards target, from the state at the given
+		 * time of the current one; that state is at time 0 of the new one.
+		 */
+		void Replan(double time, const Frame& target);
+
+		/// The frame the motion comes to rest at
+		const Frame& Target() const { return target; }
+
+		virtual double Duration() const;
+		virtual Frame Pos(double time) const;
+		virtual Twist Vel(double time) const;
+		virtual Twist Acc(double time) const;
+		virtual void Write(std::ostream& os) const;
+		virtual Trajectory* Clone() const;
+		virtual ~Trajectory_JerkLimited() {}
+
+	private:
+		// orientation at the last Replan(), the rotation vector is relative to it
+		Rotation origin;
+		Frame target;
+		// position x, y, z and rotation vector x, y, z
+		VelocityProfile_JerkLimited profile[6];
+		double duration;
+	};
+
+}
+
+#endif
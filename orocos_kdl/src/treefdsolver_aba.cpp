@@ -0,0 +1,144 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "treefdsolver_aba.hpp"
+
+namespace KDL{
+
+    TreeFdSolver_ABA::TreeFdSolver_ABA(const Tree& tree_, Vector grav):
+        tree(tree_), nj(tree.getNrOfJoints()), ns(tree.getNrOfSegments())
+    {
+      ag=-Twist(grav,Vector::Zero());
+      initAuxVariables();
+    }
+
+    void TreeFdSolver_ABA::updateInternalDataStructures() {
+      nj = tree.getNrOfJoints();
+      ns = tree.getNrOfSegments();
+      initAuxVariables();
+    }
+
+    void TreeFdSolver_ABA::initAuxVariables() {
+      flat.update(tree);
+      f_ext_indices.clear();
+      const unsigned int n = flat.getNrOfElements();
+      X.resize(n);
+      S.resize(n);
+      v.resize(n);
+      c.resize(n);
+      a.resize(n);
+      pA.resize(n);
+      U.resize(n);
+      D.resize(n);
+      u.resize(n);
+      IA.resize(n);
+    }
+
+    int TreeFdSolver_ABA::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const WrenchMap& f_ext, JntArray &q_dotdot)
+    {
+      //Check that the tree was not modified externally
+      if(nj != tree.getNrOfJoints() || ns != tree.getNrOfSegments())
+        return (error = E_NOT_UP_TO_DATE);
+
+      //Check sizes of joint vectors
+      if(q.rows()!=nj || q_dot.rows()!=nj || torques.rows()!=nj || q_dotdot.rows()!=nj)
+        return (error = E_SIZE_MISMATCH);
+
+      const int n = flat.getNrOfElements();
+
+      //Velocities and bias forces, from the root to the leaves
+      for(int i=0;i<n;i++) {
+        const Segment& seg = flat.getSegment(i);
+        const int p = flat.getParent(i);
+
+        double q_, qdot_;
+        const int j = flat.getQNr(i);
+        if(j >= 0) {
+          q_ = q(j);
+          qdot_ = q_dot(j);
+        }
+        else
+          q_ = qdot_ = 0.0;
+
+        //Remark this is the inverse of the frame for transformations from the parent to the current coord frame
+        X[i] = seg.pose(q_);
+        S[i] = X[i].M.Inverse( seg.twist(q_,1.0) );
+        Twist vj = S[i]*qdot_;
+
+        if(p < 0)
+          v[i] = vj;
+        else
+          v[i] = X[i].Inverse(v[p]) + vj;
+        c[i] = v[i]*vj;
+
+        const RigidBodyInertia& I = seg.getInertia();
+        IA[i] = I;
+        pA[i] = v[i]*(I*v[i]);
+      }
+
+      //the names of f_ext are only looked up when they changed since the last call
+      const std::vector<int>& f_ext_index = f_ext_indices.resolve(flat, f_ext);
+      WrenchMap::const_iterator it = f_ext.begin();
+      for(unsigned int k = 0; k < f_ext_index.size(); ++k, ++it) {
+        const int i = f_ext_index[k];
+        if(i >= 0)
+          pA[i] = pA[i] - it->second;
+      }
+
+      //Articulated body inertias, from the leaves to the root: all children
+      //of an element have added their contributions when it is reached
+      for(int i=n-1;i>=0;i--) {
+        const int j = flat.getQNr(i);
+        ArticulatedBodyInertia Ia = IA[i];
+        Wrench pa;
+        if(j >= 0) {
+          U[i] = Ia*S[i];
+          D[i] = dot(S[i],U[i]) + flat.getSegment(i).getJoint().getInertia();
+          u[i] = torques(j) - dot(S[i],pA[i]);
+          Eigen::Map<const Eigen::Vector3d> f(U[i].force.data);
+          Eigen::Map<const Eigen::Vector3d> nu(U[i].torque.data);
+          Ia = Ia - ArticulatedBodyInertia(f*f.transpose()/D[i], nu*f.transpose()/D[i], nu*nu.transpose()/D[i]);
+          pa = pA[i] + Ia*c[i] + U[i]*(u[i]/D[i]);
+        }
+        else
+          pa = pA[i] + Ia*c[i];
+
+        //add the articulated body to the parent segment
+        const int p = flat.getParent(i);
+        if(p >= 0) {
+          IA[p] = IA[p] + X[i]*Ia;
+          pA[p] = pA[p] + X[i]*pa;
+        }
+      }
+
+      //Accelerations, from the root to the leaves
+      for(int i=0;i<n;i++) {
+        const int p = flat.getParent(i);
+        if(p < 0)
+          a[i] = X[i].Inverse(ag) + c[i];
+        else
+          a[i] = X[i].Inverse(a[p]) + c[i];
+
+        const int j = flat.getQNr(i);
+        if(j >= 0) {
+          q_dotdot(j) = (u[i] - dot(a[i],U[i]))/D[i];
+          a[i] = a[i] + S[i]*q_dotdot(j);
+        }
+      }
+      return (error = E_NOERROR);
+    }
+}//namespace
@@ -0,0 +1,90 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_TREE_FDSOLVER_ABA_HPP
+#define KDL_TREE_FDSOLVER_ABA_HPP
+
+#include "treefdsolver.hpp"
+#include "articulatedbodyinertia.hpp"
+#include "flattree.hpp"
+#include <Eigen/StdVector>
+
+namespace KDL{
+    /**
+     * \brief Articulated body algorithm forward dynamics solver for kinematic trees.
+     *
+     * It calculates the accelerations for the joints, given the position
+     * and velocity of the joints (q,qdot), the joint torques, external
+     * forces on the segments (expressed in the segments reference frame)
+     * and the dynamical parameters of the segments.
+     *
+     * This is an extension of the forward dynamics solver for kinematic
+     * chains, \see ChainFdSolver_ABA. As in TreeIdSolver_RNE, an STL map is
+     * used for the external wrenches and the three passes are sweeps over a
+     * KDL::FlatTree.
+     */
+    class TreeFdSolver_ABA : public TreeFdSolver {
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param tree The kinematic tree to calculate the forward dynamics for, an internal reference will be stored.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        TreeFdSolver_ABA(const Tree& tree, Vector grav);
+
+        /**
+         * Function to calculate from joint torques to joint accelerations.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param torques The current joint torques (applied by controller)
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param q_dotdot The resulting joint accelerations
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const WrenchMap& f_ext, JntArray &q_dotdot);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual TreeFdSolver_ABA* clone() const { return new TreeFdSolver_ABA(*this); }
+
+    private:
+        ///Helper function to initialize private members
+        void initAuxVariables();
+
+        const Tree& tree;
+        unsigned int nj;
+        unsigned int ns;
+        FlatTree flat;
+        FlatTreeIndices f_ext_indices;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> c;
+        std::vector<Twist> a;
+        std::vector<Wrench> pA;
+        std::vector<Wrench> U;
+        std::vector<double> D;
+        std::vector<double> u;
+        std::vector<ArticulatedBodyInertia, Eigen::aligned_allocator<ArticulatedBodyInertia> > IA;
+        Twist ag;
+    };
+}
+
+#endif
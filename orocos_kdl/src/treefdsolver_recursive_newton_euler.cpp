@@ -0,0 +1,108 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "treefdsolver_recursive_newton_euler.hpp"
+#include "utilities/ltl_solver_eigen.hpp"
+
+namespace KDL{
+
+    TreeFdSolver_RNE::TreeFdSolver_RNE(const Tree& tree_, Vector grav):
+        tree(tree_), nj(tree.getNrOfJoints()), ns(tree.getNrOfSegments()),
+        IdSolver(tree, grav)
+    {
+      initAuxVariables();
+    }
+
+    void TreeFdSolver_RNE::updateInternalDataStructures() {
+      nj = tree.getNrOfJoints();
+      ns = tree.getNrOfSegments();
+      IdSolver.updateInternalDataStructures();
+      initAuxVariables();
+    }
+
+    void TreeFdSolver_RNE::initAuxVariables() {
+      flat.update(tree);
+      const unsigned int n = flat.getNrOfElements();
+      X.resize(n);
+      S.resize(n);
+      Ic.resize(n);
+      H.resize(nj,nj);
+      q_dotdot_zero.resize(nj);
+      Tzeroacc.resize(nj);
+      acc.resize(nj);
+    }
+
+    int TreeFdSolver_RNE::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const WrenchMap& f_ext, JntArray &q_dotdot)
+    {
+      //Check that the tree was not modified externally
+      if(nj != tree.getNrOfJoints() || ns != tree.getNrOfSegments())
+        return (error = E_NOT_UP_TO_DATE);
+
+      //Check sizes of joint vectors
+      if(q.rows()!=nj || q_dot.rows()!=nj || torques.rows()!=nj || q_dotdot.rows()!=nj)
+        return (error = E_SIZE_MISMATCH);
+
+      const int n = flat.getNrOfElements();
+
+      //Poses and motion subspaces, from the root to the leaves
+      for(int i=0;i<n;i++) {
+        const Segment& seg = flat.getSegment(i);
+        const int j = flat.getQNr(i);
+        const double q_ = j >= 0 ? q(j) : 0.0;
+        //Remark this is the inverse of the frame for transformations from the parent to the current coord frame
+        X[i] = seg.pose(q_);
+        S[i] = X[i].M.Inverse( seg.twist(q_,1.0) );
+        Ic[i] = seg.getInertia();
+      }
+
+      //Composite inertias, from the leaves to the root. Only the lower
+      //triangle entries between a joint and its ancestor joints are
+      //filled in, these are the only ones ltl_factorize() reads.
+      for(int i=n-1;i>=0;i--) {
+        const int j = flat.getQNr(i);
+        if(j >= 0) {
+          Wrench F = Ic[i]*S[i];
+          H(j,j) = dot(S[i],F) + flat.getSegment(i).getJoint().getInertia();
+          for(int l=i; flat.getParent(l) >= 0; ) {
+            F = X[l]*F;
+            l = flat.getParent(l);
+            const int k = flat.getQNr(l);
+            if(k >= 0)
+              H(j,k) = dot(F,S[l]);
+          }
+        }
+        const int p = flat.getParent(i);
+        if(p >= 0)
+          Ic[p] = Ic[p] + X[i]*Ic[i];
+      }
+
+      //Non-inertial torques, by inputting zero joint acceleration to ID
+      SetToZero(q_dotdot_zero);
+      error = IdSolver.CartToJnt(q, q_dot, q_dotdot_zero, f_ext, Tzeroacc);
+      if(error < 0)
+        return (error);
+
+      error = ltl_factorize(H, flat.getJointParents());
+      if(error < 0)
+        return (error);
+      acc = torques.data - Tzeroacc.data;
+      ltl_solve(H, flat.getJointParents(), acc);
+      q_dotdot.data = acc;
+      return (error = E_NOERROR);
+    }
+}//namespace
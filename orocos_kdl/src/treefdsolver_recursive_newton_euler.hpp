@@ -0,0 +1,88 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_TREE_FDSOLVER_RECURSIVE_NEWTON_EULER_HPP
+#define KDL_TREE_FDSOLVER_RECURSIVE_NEWTON_EULER_HPP
+
+#include "treefdsolver.hpp"
+#include "treeidsolver_recursive_newton_euler.hpp"
+#include "flattree.hpp"
+#include "rigidbodyinertia.hpp"
+#include <Eigen/Core>
+
+namespace KDL{
+    /**
+     * \brief Recursive newton euler forward dynamics solver for kinematic trees.
+     *
+     * This is the extension of ChainFdSolver_RNE to trees: the joint
+     * space inertia matrix H is computed with the composite rigid body
+     * algorithm over a KDL::FlatTree, the bias torques with
+     * TreeIdSolver_RNE at zero joint acceleration, and H is factorized
+     * as L^T*L with ltl_factorize() using the joint parents of the tree,
+     * see "Rigid Body Dynamics Algorithms", Roy Featherstone, 2008,
+     * Chapter 6. Only the entries of H between a joint and its
+     * ancestors are computed and used, so the cost grows with the depth
+     * of the tree rather than with the number of joints cubed.
+     */
+    class TreeFdSolver_RNE : public TreeFdSolver {
+    public:
+        /**
+         * Constructor for the solver, it will allocate all the necessary memory
+         * \param tree The kinematic tree to calculate the forward dynamics for, an internal reference will be stored.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        TreeFdSolver_RNE(const Tree& tree, Vector grav);
+
+        /**
+         * Function to calculate from joint torques to joint accelerations.
+         * Input parameters;
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param torques The current joint torques (applied by controller)
+         * \param f_ext The external forces (no gravity) on the segments
+         * Output parameters:
+         * \param q_dotdot The resulting joint accelerations
+         */
+        int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &torques, const WrenchMap& f_ext, JntArray &q_dotdot);
+
+        /// @copydoc KDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc KDL::SolverI::clone
+        virtual TreeFdSolver_RNE* clone() const { return new TreeFdSolver_RNE(*this); }
+
+    private:
+        ///Helper function to initialize private members
+        void initAuxVariables();
+
+        const Tree& tree;
+        unsigned int nj;
+        unsigned int ns;
+        FlatTree flat;
+        TreeIdSolver_RNE IdSolver;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<RigidBodyInertia> Ic;
+        Eigen::MatrixXd H;
+        JntArray q_dotdot_zero;
+        JntArray Tzeroacc;
+        Eigen::VectorXd acc;
+    };
+}
+
+#endif
@@ -21,45 +21,53 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "treefksolverpos_recursive.hpp"
-#include <iostream>
 
 namespace KDL {
 
     TreeFkSolverPos_recursive::TreeFkSolverPos_recursive(const Tree& _tree):
-        tree(_tree)
+        flat(_tree)
     {
     }
 
     int TreeFkSolverPos_recursive::JntToCart(const JntArray& q_in, Frame& p_out, std::string segmentName)
-    {      
-		SegmentMap::const_iterator it = tree.getSegment(segmentName); 
-       
-        
-        if(q_in.rows() != tree.getNrOfJoints())
-    	    	return -1;
-        else if(it == tree.getSegments().end()) //if the segment name is not found
-         	return -2;
-        else{
-			p_out = recursiveFk(q_in, it);
-        	return 0;        	
+    {
+        const int i = flat.getIndex(segmentName);
+        if(q_in.rows() != flat.getNrOfJoints())
+            return -1;
+        else if(i < 0) //if the segment name is not found
+            return -2;
+        return JntToCart(q_in, p_out, (unsigned int)i);
+    }
+
+    int TreeFkSolverPos_recursive::JntToCart(const JntArray& q_in, Frame& p_out, unsigned int segmentIndex)
+    {
+        if(q_in.rows() != flat.getNrOfJoints())
+            return -1;
+        else if(segmentIndex >= flat.getNrOfElements())
+            return -2;
+
+        //walk up to the root, composing the frames from the left
+        p_out = Frame::Identity();
+        for (int i = segmentIndex; i >= 0; i = flat.getParent(i)) {
+            const int q_nr = flat.getQNr(i);
+            p_out = flat.getSegment(i).pose(q_nr < 0 ? 0.0 : q_in(q_nr)) * p_out;
         }
+        return 0;
     }
 
-	Frame TreeFkSolverPos_recursive::recursiveFk(const JntArray& q_in, const SegmentMap::const_iterator& it)
-	{
-		//gets the frame for the current element (segment)
-        const TreeElementType& currentElement = it->second;
-        Frame currentFrame = GetTreeElementSegment(currentElement).pose(q_in(GetTreeElementQNr(currentElement)));
+    int TreeFkSolverPos_recursive::JntToCart(const JntArray& q_in, std::vector<Frame>& p_out)
+    {
+        if(q_in.rows() != flat.getNrOfJoints())
+            return -1;
 
-		SegmentMap::const_iterator rootIterator = tree.getRootSegment();
-		if(it == rootIterator){
-			return currentFrame;	
-		}
-		else{
-            SegmentMap::const_iterator parentIt = GetTreeElementParent(currentElement);
-			return recursiveFk(q_in, parentIt) * currentFrame;
-		}
-	}
+        p_out.resize(flat.getNrOfElements());
+        p_out[0] = flat.getSegment(0).pose(0.0);
+        for (unsigned int i = 1; i < flat.getNrOfElements(); i++) {
+            const int q_nr = flat.getQNr(i);
+            p_out[i] = p_out[flat.getParent(i)] * flat.getSegment(i).pose(q_nr < 0 ? 0.0 : q_in(q_nr));
+        }
+        return 0;
+    }
 
     TreeFkSolverPos_recursive::~TreeFkSolverPos_recursive()
     {
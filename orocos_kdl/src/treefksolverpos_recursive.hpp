@@ -24,6 +24,7 @@
 #define KDLTREEFKSOLVERPOS_RECURSIVE_HPP
 
 #include "treefksolver.hpp"
+#include "flattree.hpp"
 
 namespace KDL {
 
@@ -32,6 +33,10 @@ namespace KDL {
      * algorithm to calculate the position transformation from joint
      * space to Cartesian space of a general kinematic tree (KDL::Tree).
      *
+     * The solver works on a KDL::FlatTree built from a copy of the tree
+     * at construction: it walks the parent indices from the segment to
+     * the root instead of recursing over the segment map.
+     *
      * @ingroup KinematicFamily
      */
     class TreeFkSolverPos_recursive : public TreeFkSolverPos
@@ -42,10 +47,24 @@ namespace KDL {
 
         virtual int JntToCart(const JntArray& q_in, Frame& p_out, std::string segmentName);
 
+        /**
+         * Same as JntToCart with a segment name, for the element with
+         * index segmentIndex in getFlatTree()
+         */
+        int JntToCart(const JntArray& q_in, Frame& p_out, unsigned int segmentIndex);
+
+        /**
+         * Frames of all elements of getFlatTree() w.r.t. the root, in a
+         * single sweep over the tree
+         *
+         * @param p_out resized to getFlatTree().getNrOfElements()
+         */
+        int JntToCart(const JntArray& q_in, std::vector<Frame>& p_out);
+
+        const FlatTree& getFlatTree() const { return flat; }
+
     private:
-        const Tree tree;
-        
-        Frame recursiveFk(const JntArray& q_in, const SegmentMap::const_iterator& it);
+        const FlatTree flat;
     };
 
 }
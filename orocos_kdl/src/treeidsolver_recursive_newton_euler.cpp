@@ -20,8 +20,6 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "treeidsolver_recursive_newton_euler.hpp"
-#include "frames_io.hpp"
-#include <stdexcept>
 
 namespace KDL{
 
@@ -39,14 +37,14 @@ namespace KDL{
     }
 
     void TreeIdSolver_RNE::initAuxVariables() {
-      const SegmentMap& segments = tree.getSegments();
-      for(SegmentMap::const_iterator seg = segments.begin(); seg != segments.end(); seg++) {
-        X[seg->first] = Frame();
-        S[seg->first] = Twist();
-        v[seg->first] = Twist();
-        a[seg->first] = Twist();
-        f[seg->first] = Wrench();
-      }
+      flat.update(tree);
+      f_ext_indices.clear();
+      const unsigned int n = flat.getNrOfElements();
+      X.resize(n);
+      S.resize(n);
+      v.resize(n);
+      a.resize(n);
+      f.resize(n);
     }
 
     int TreeIdSolver_RNE::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const WrenchMap& f_ext, JntArray &torques)
@@ -59,81 +57,74 @@ namespace KDL{
       if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj)
         return (error = E_SIZE_MISMATCH);
 
-      try {
-        //Do the recursion here
-        rne_step(tree.getRootSegment(), q, q_dot, q_dotdot, f_ext, torques);
-      }
-      catch(const std::out_of_range&) {
-        //If in rne_step we get an out_of_range exception it means that some call
-        //to map::at failed. This can happen only if updateInternalDataStructures
-        //was not called after changing something in the tree. Note that it
-        //should be impossible to reach this point as consistency of the tree is
-        //checked above.
-        return (error = E_NOT_UP_TO_DATE);
-      }
-      return (error = E_NOERROR);
-    }
-
-
-    void TreeIdSolver_RNE::rne_step(SegmentMap::const_iterator segment, const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const WrenchMap& f_ext, JntArray& torques) {
-      const Segment& seg = GetTreeElementSegment(segment->second);
-      const std::string& segname = segment->first;
-      const std::string& parname = GetTreeElementParent(segment->second)->first;
-
-      //Do forward calculations involving velocity & acceleration of this segment
-      double q_, qdot_, qdotdot_;
-      unsigned int j = GetTreeElementQNr(segment->second);
-      if(seg.getJoint().getType()!=Joint::Fixed) {
-        q_ = q(j);
-        qdot_ = q_dot(j);
-        qdotdot_ = q_dotdot(j);
+      const unsigned int n = flat.getNrOfElements();
+
+      //Sweep from the root to the leaves, the parent of an element always comes first
+      for(unsigned int i=0;i<n;i++) {
+        const Segment& seg = flat.getSegment(i);
+        const int p = flat.getParent(i);
+
+        //Do forward calculations involving velocity & acceleration of this segment
+        double q_, qdot_, qdotdot_;
+        const int j = flat.getQNr(i);
+        if(j >= 0) {
+          q_ = q(j);
+          qdot_ = q_dot(j);
+          qdotdot_ = q_dotdot(j);
+        }
+        else
+          q_ = qdot_ = qdotdot_ = 0.0;
+
+        //Calculate segment properties: X,S,vj,cj
+
+        //Remark this is the inverse of the frame for transformations from the parent to the current coord frame
+        X[i] = seg.pose(q_);
+
+        //Transform velocity and unit velocity to segment frame
+        Twist vj = X[i].M.Inverse( seg.twist(q_,qdot_) );
+        S[i] = X[i].M.Inverse( seg.twist(q_,1.0) );
+
+        //calculate velocity and acceleration of the segment (in segment coordinates)
+        if(p < 0) {
+          v[i] = vj;
+          a[i] = X[i].Inverse(ag) + S[i]*qdotdot_+ v[i]*vj;
+        }
+        else {
+          v[i] = X[i].Inverse(v[p]) + vj;
+          a[i] = X[i].Inverse(a[p]) + S[i]*qdotdot_ + v[i]*vj;
+        }
+
+        //Calculate the force for the joint
+        //Collect RigidBodyInertia and external forces
+        const RigidBodyInertia& I = seg.getInertia();
+        f[i] = I*a[i] + v[i]*(I*v[i]);
       }
-      else
-        q_ = qdot_ = qdotdot_ = 0.0;
 
-      //Calculate segment properties: X,S,vj,cj
-
-      //Remark this is the inverse of the frame for transformations from the parent to the current coord frame
-      X.at(segname) = seg.pose(q_);
-
-      //Transform velocity and unit velocity to segment frame
-      Twist vj = X.at(segname).M.Inverse( seg.twist(q_,qdot_) );
-      S.at(segname) = X.at(segname).M.Inverse( seg.twist(q_,1.0) );
-
-      //calculate velocity and acceleration of the segment (in segment coordinates)
-      if(segment == tree.getRootSegment()) {
-        v.at(segname) = vj;
-        a.at(segname) = X.at(segname).Inverse(ag) + S.at(segname)*qdotdot_+ v.at(segname)*vj;
-      }
-      else {
-        v.at(segname) = X.at(segname).Inverse(v.at(parname)) + vj;
-        a.at(segname) = X.at(segname).Inverse(a.at(parname)) + S.at(segname)*qdotdot_ + v.at(segname)*vj;
+      //the names of f_ext are only looked up when they changed since the last call
+      const std::vector<int>& f_ext_index = f_ext_indices.resolve(flat, f_ext);
+      WrenchMap::const_iterator it = f_ext.begin();
+      for(unsigned int k = 0; k < f_ext_index.size(); ++k, ++it) {
+        const int i = f_ext_index[k];
+        if(i >= 0)
+          f[i] = f[i] - it->second;
       }
 
-      //Calculate the force for the joint
-      //Collect RigidBodyInertia and external forces
-      const RigidBodyInertia& I = seg.getInertia();
-      f.at(segname) = I*a.at(segname) + v.at(segname)*(I*v.at(segname));
-      if(f_ext.find(segname) != f_ext.end())
-        f.at(segname) = f.at(segname) - f_ext.at(segname);
-
-      //propagate calculations over each child segment
-      SegmentMap::const_iterator child;
-      for (unsigned int i = 0; i < GetTreeElementChildren(segment->second).size(); i++) {
-        child = GetTreeElementChildren(segment->second)[i];
-        rne_step(child, q, q_dot, q_dotdot, f_ext, torques);
+      //Sweep back from the leaves to the root: do backward calculations involving wrenches and joint efforts
+      for(int i=n-1;i>=0;i--) {
+        const Segment& seg = flat.getSegment(i);
+
+        //If there is a moving joint, evaluate its effort
+        const int j = flat.getQNr(i);
+        if(j >= 0) {
+          torques(j) = dot(S[i], f[i]);
+          torques(j) += seg.getJoint().getInertia()*q_dotdot(j);  // add torque from joint inertia
+        }
+
+        //add reaction forces to parent segment
+        const int p = flat.getParent(i);
+        if(p >= 0)
+          f[p] = f[p] + X[i]*f[i];
       }
-
-      //do backward calculations involving wrenches and joint efforts
-
-      //If there is a moving joint, evaluate its effort
-      if(seg.getJoint().getType()!=Joint::Fixed) {
-        torques(j) = dot(S.at(segname), f.at(segname));
-        torques(j) += seg.getJoint().getInertia()*q_dotdot(j);  // add torque from joint inertia
-      }
-
-      //add reaction forces to parent segment
-      if(segment != tree.getRootSegment())
-        f.at(parname) = f.at(parname) + X.at(segname)*f.at(segname);
+      return (error = E_NOERROR);
     }
 }//namespace
@@ -23,6 +23,7 @@
 #define KDL_TREE_IDSOLVER_RECURSIVE_NEWTON_EULER_HPP
 
 #include "treeidsolver.hpp"
+#include "flattree.hpp"
 
 namespace KDL{
     /**
@@ -34,9 +35,9 @@ namespace KDL{
      * parameters of the segments.
      *
      * This is an extension of the inverse dynamic solver for kinematic chains,
-     * \see ChainIdSolver_RNE. The main difference is the use of STL maps
-     * instead of vectors to represent external wrenches (as well as internal
-     * variables exploited during the recursion).
+     * \see ChainIdSolver_RNE. The main difference is the use of an STL map
+     * to represent external wrenches. Internally the recursion runs as two
+     * sweeps over a KDL::FlatTree, with the variables stored per index.
      */
     class TreeIdSolver_RNE : public TreeIdSolver {
     public:
@@ -62,21 +63,23 @@ namespace KDL{
         /// @copydoc KDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
+        /// @copydoc KDL::SolverI::clone
+        virtual TreeIdSolver_RNE* clone() const { return new TreeIdSolver_RNE(*this); }
+
     private:
-        ///Helper function to initialize private members X, S, v, a, f
+        ///Helper function to initialize private members flat, X, S, v, a, f
         void initAuxVariables();
 
-        ///One recursion step
-        void rne_step(SegmentMap::const_iterator segment, const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const WrenchMap& f_ext, JntArray& torques);
-
         const Tree& tree;
         unsigned int nj;
         unsigned int ns;
-        std::map<std::string,Frame> X;
-        std::map<std::string,Twist> S;
-        std::map<std::string,Twist> v;
-        std::map<std::string,Twist> a;
-        std::map<std::string,Wrench> f;
+        FlatTree flat;
+        FlatTreeIndices f_ext_indices;
+        std::vector<Frame> X;
+        std::vector<Twist> S;
+        std::vector<Twist> v;
+        std::vector<Twist> a;
+        std::vector<Wrench> f;
         Twist ag;
     };
 }
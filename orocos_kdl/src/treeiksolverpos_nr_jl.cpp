@@ -22,6 +22,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "treeiksolverpos_nr_jl.hpp"
+#include <algorithm>
 
 namespace KDL {
     TreeIkSolverPos_NR_JL::TreeIkSolverPos_NR_JL(const Tree& _tree,
@@ -30,34 +31,65 @@ namespace KDL {
                                                  TreeFkSolverPos& _fksolver, TreeIkSolverVel& _iksolver,
                                                  unsigned int _maxiter, double _eps) :
         tree(_tree), q_min(_q_min), q_max(_q_max), iksolver(_iksolver),
-        fksolver(_fksolver), delta_q(tree.getNrOfJoints()),
+        fksolver(_fksolver),
+        fksolver_flat(dynamic_cast<TreeFkSolverPos_recursive*>(&_fksolver)),
+        iksolver_wdls(dynamic_cast<TreeIkSolverVel_wdls*>(&_iksolver)),
+        delta_q(tree.getNrOfJoints()),
         endpoints(_endpoints), maxiter(_maxiter), eps(_eps)
     {
+        if (iksolver_wdls)
+            delta_twists_flat.resize(iksolver_wdls->getEndpoints().size(), Twist::Zero());
         for (size_t i = 0; i < endpoints.size(); i++) {
             frames.insert(Frames::value_type(endpoints[i], Frame::Identity()));
             delta_twists.insert(Twists::value_type(endpoints[i], Twist::Zero()));
         }
+        targets.reserve(frames.size());
     }
     
     double TreeIkSolverPos_NR_JL::CartToJnt(const JntArray& q_init, const Frames& p_in, JntArray& q_out) {
         q_out = q_init;
         
-        //First check if all elements in p_in are available:
-        for(Frames::const_iterator f_des_it=p_in.begin();f_des_it!=p_in.end();++f_des_it)
-            if(frames.find(f_des_it->first)==frames.end())
+        //First check if all elements in p_in are available and get all
+        //iterators and indices for them once, outside of the iteration loop:
+        bool indexed = fksolver_flat && iksolver_wdls;
+        targets.clear();
+        for(Frames::const_iterator f_des_it=p_in.begin();f_des_it!=p_in.end();++f_des_it) {
+            Frames::iterator f_it = frames.find(f_des_it->first);
+            if(f_it==frames.end())
                 return -2;
+            Target target = {f_des_it, f_it, delta_twists.find(f_des_it->first), 0, 0};
+            if (indexed) {
+                const int segment = fksolver_flat->getFlatTree().getIndex(f_des_it->first);
+                const std::vector<std::string>& names = iksolver_wdls->getEndpoints();
+                const std::vector<std::string>::const_iterator name =
+                    std::lower_bound(names.begin(), names.end(), f_des_it->first);
+                //names unknown to the solvers are reported by the name based calls
+                indexed = segment >= 0 && name != names.end() && *name == f_des_it->first;
+                target.segment = segment;
+                target.twist = name - names.begin();
+            }
+            targets.push_back(target);
+        }
         
         unsigned int k=0;
         while(++k <= maxiter) {
-            for (Frames::const_iterator f_des_it=p_in.begin();f_des_it!=p_in.end();++f_des_it){
-                //Get all iterators for this endpoint
-                Frames::iterator f_it = frames.find(f_des_it->first);
-                Twists::iterator delta_twist = delta_twists.find(f_des_it->first);
-                
-                fksolver.JntToCart(q_out, f_it->second, f_it->first);
-                delta_twist->second = diff(f_it->second, f_des_it->second);
+            double res;
+            if (indexed) {
+                for (size_t i = 0; i < targets.size(); ++i) {
+                    const Target& target = targets[i];
+                    fksolver_flat->JntToCart(q_out, target.f_it->second, target.segment);
+                    delta_twists_flat[target.twist] = diff(target.f_it->second, target.f_des_it->second);
+                }
+                res = iksolver_wdls->CartToJnt(q_out, delta_twists_flat, delta_q);
+            }
+            else {
+                for (size_t i = 0; i < targets.size(); ++i) {
+                    const Target& target = targets[i];
+                    fksolver.JntToCart(q_out, target.f_it->second, target.f_it->first);
+                    target.delta_twist->second = diff(target.f_it->second, target.f_des_it->second);
+                }
+                res = iksolver.CartToJnt(q_out, delta_twists, delta_q);
             }
-            double res = iksolver.CartToJnt(q_out, delta_twists, delta_q);
             if (res < eps) return res;
             
             Add(q_out, delta_q, q_out);
@@ -26,6 +26,8 @@
 
 #include "treeiksolver.hpp"
 #include "treefksolver.hpp"
+#include "treefksolverpos_recursive.hpp"
+#include "treeiksolvervel_wdls.hpp"
 #include <vector>
 #include <string>
 
@@ -37,6 +39,10 @@ namespace KDL {
  * position transformation from Cartesian to joint space of a general
  * KDL::Tree. Takes joint limits into account.
  *
+ * With a TreeFkSolverPos_recursive and a TreeIkSolverVel_wdls, the
+ * endpoints are resolved to indices once per call, and the iterations
+ * use their index based overloads, without any name lookups.
+ *
  * @ingroup KinematicFamily
  */
 class TreeIkSolverPos_NR_JL: public TreeIkSolverPos {
@@ -70,11 +76,27 @@ private:
     JntArray q_max;
     TreeIkSolverVel& iksolver;
     TreeFkSolverPos& fksolver;
+    //the same solvers if they have index based overloads, else 0
+    TreeFkSolverPos_recursive* fksolver_flat;
+    TreeIkSolverVel_wdls* iksolver_wdls;
     JntArray delta_q;
     Frames frames;
     Twists delta_twists;
+    //delta twists in the order of iksolver_wdls->getEndpoints()
+    std::vector<Twist> delta_twists_flat;
     std::vector<std::string> endpoints;
-    
+
+    //Requested endpoint with its entries in frames and delta_twists, and
+    //its indices in the FlatTree of fksolver_flat and in delta_twists_flat
+    struct Target {
+        Frames::const_iterator f_des_it;
+        Frames::iterator f_it;
+        Twists::iterator delta_twist;
+        unsigned int segment;
+        unsigned int twist;
+    };
+    std::vector<Target> targets;
+
     unsigned int maxiter;
     double eps;
 };
@@ -7,11 +7,13 @@
 
 #include "treeiksolvervel_wdls.hpp"
 #include "utilities/svd_eigen_HH.hpp"
+#include <algorithm>
+#include <limits>
 
 namespace KDL {    
     TreeIkSolverVel_wdls::TreeIkSolverVel_wdls(const Tree& tree_in, const std::vector<std::string>& endpoints) :
-        tree(tree_in), jnttojacsolver(tree),
-        J(Eigen::MatrixXd::Zero(6 * endpoints.size(), tree.getNrOfJoints())),
+        jnttojacsolver(tree_in),
+        J(Eigen::MatrixXd::Zero(6 * endpoints.size(), tree_in.getNrOfJoints())),
         Wy(Eigen::MatrixXd::Identity(J.rows(),J.rows())),
         Wq(Eigen::MatrixXd::Identity(J.cols(),J.cols())),
         J_Wq(J.rows(),J.cols()),Wy_J_Wq(J.rows(),J.cols()),
@@ -23,11 +25,18 @@ namespace KDL {
         tmp(Eigen::VectorXd::Zero(J.cols())),S(Eigen::VectorXd::Zero(J.cols())),
         lambda(0)
     {
-        
-        for (size_t i = 0; i < endpoints.size(); ++i) {
-            jacobians.insert(Jacobians::value_type(endpoints[i], Jacobian(tree.getNrOfJoints())));
+        //Keep the endpoints sorted by name, this fixes the row order of J,
+        //and resolve them to flat indices once
+        endpoint_names = endpoints;
+        std::sort(endpoint_names.begin(), endpoint_names.end());
+        endpoint_names.erase(std::unique(endpoint_names.begin(), endpoint_names.end()), endpoint_names.end());
+        for (size_t i = 0; i < endpoint_names.size(); ++i) {
+            //unknown endpoints get an invalid index, JntToJac reports them
+            const int index = jnttojacsolver.getFlatTree().getIndex(endpoint_names[i]);
+            endpoint_indices.push_back(index < 0 ? std::numeric_limits<unsigned int>::max() : (unsigned int)index);
+            jacobians.push_back(Jacobian(tree_in.getNrOfJoints()));
         }
-        
+        twists.resize(endpoint_names.size(), Twist::Zero());
     }
     
     TreeIkSolverVel_wdls::~TreeIkSolverVel_wdls() {
@@ -47,30 +56,43 @@ namespace KDL {
     
     double TreeIkSolverVel_wdls::CartToJnt(const JntArray& q_in, const Twists& v_in, JntArray& qdot_out) {
         
-        //First check if we are configured for this Twists:
+        //Both v_in and endpoint_names are sorted by name, so a single merge
+        //checks that we are configured for this Twists and orders them,
+        //endpoints without a twist get a zero twist:
+        unsigned int k = 0;
         for (Twists::const_iterator v_it = v_in.begin(); v_it != v_in.end(); ++v_it) {
-            if (jacobians.find(v_it->first) == jacobians.end())
+            while (k < endpoint_names.size() && endpoint_names[k] < v_it->first)
+                twists[k++] = Twist::Zero();
+            if (k == endpoint_names.size() || endpoint_names[k] != v_it->first)
                 return -2;
+            twists[k++] = v_it->second;
         }
+        for (; k < twists.size(); ++k)
+            twists[k] = Twist::Zero();
+        return CartToJnt(q_in, twists, qdot_out);
+    }
+
+    double TreeIkSolverVel_wdls::CartToJnt(const JntArray& q_in, const std::vector<Twist>& v_in, JntArray& qdot_out) {
+
+        if (v_in.size() != endpoint_names.size())
+            return -2;
         //Check if q_in has the right size
-        if (q_in.rows() != tree.getNrOfJoints())
+        const unsigned int nj = jnttojacsolver.getFlatTree().getNrOfJoints();
+        if (q_in.rows() != nj)
             return -1;
         
         //Lets get all the jacobians we need:
-        unsigned int k = 0;
-        for (Jacobians::iterator jac_it = jacobians.begin(); jac_it
-                 != jacobians.end(); ++jac_it) {
-            int ret = jnttojacsolver.JntToJac(q_in, jac_it->second, jac_it->first);
+        for (unsigned int k = 0; k < endpoint_indices.size(); ++k) {
+            int ret = jnttojacsolver.JntToJac(q_in, jacobians[k], endpoint_indices[k]);
             if (ret < 0)
                 return ret;
             else {
                 //lets put the jacobian in the big matrix and put the twist in the big t:
-                J.block(6*k,0, 6,tree.getNrOfJoints()) = jac_it->second.data;
-                const Twist& twist=v_in.find(jac_it->first)->second;
+                J.block(6*k,0, 6,nj) = jacobians[k].data;
+                const Twist& twist=v_in[k];
                 t.segment(6*k,3)   = Eigen::Map<const Eigen::Vector3d>(twist.vel.data);
                 t.segment(6*k+3,3) = Eigen::Map<const Eigen::Vector3d>(twist.rot.data);
             }
-            ++k;
         }
         
         //Lets use the wdls algorithm to find the qdot:
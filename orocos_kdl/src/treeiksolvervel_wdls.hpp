@@ -23,6 +23,16 @@ namespace KDL {
         
         virtual double CartToJnt(const JntArray& q_in, const Twists& v_in, JntArray& qdot_out);
 
+        /*
+         * Same as CartToJnt with a Twists map, with the twists of all
+         * endpoints in the order of getEndpoints(), without any name
+         * lookups. Returns -2 if v_in does not have one twist per endpoint.
+         */
+        double CartToJnt(const JntArray& q_in, const std::vector<Twist>& v_in, JntArray& qdot_out);
+
+        /// The endpoints, sorted by name
+        const std::vector<std::string>& getEndpoints() const {return endpoint_names;}
+
         /*
          * Set the joint space weighting matrix
          *
@@ -78,9 +88,11 @@ namespace KDL {
         double getLambda () const {return lambda;}
 
     private:
-        Tree tree;
         TreeJntToJacSolver jnttojacsolver;
-        Jacobians jacobians;
+        std::vector<std::string> endpoint_names;
+        std::vector<unsigned int> endpoint_indices;
+        std::vector<Jacobian> jacobians;
+        std::vector<Twist> twists;
         
         Eigen::MatrixXd J, Wy, Wq, J_Wq, Wy_J_Wq, U, V, Wy_U, Wq_V;
         Eigen::VectorXd t, Wy_t, qdot, tmp, S;
@@ -6,49 +6,58 @@
  */
 
 #include "treejnttojacsolver.hpp"
-#include <iostream>
-#include "kinfam_io.hpp"
 
 namespace KDL {
 
 TreeJntToJacSolver::TreeJntToJacSolver(const Tree& tree_in) :
-    tree(tree_in) {
+    flat(tree_in) {
 }
 
 TreeJntToJacSolver::~TreeJntToJacSolver() {
 }
 
 int TreeJntToJacSolver::JntToJac(const JntArray& q_in, Jacobian& jac, const std::string& segmentname) {
+    //Lets search the tree-element
+    const int index = flat.getIndex(segmentname);
+
     //First we check all the sizes:
-    if (q_in.rows() != tree.getNrOfJoints() || jac.columns() != tree.getNrOfJoints())
+    if (q_in.rows() != flat.getNrOfJoints() || jac.columns() != flat.getNrOfJoints())
         return -1;
-    
-    //Lets search the tree-element
-    SegmentMap::const_iterator it = tree.getSegments().find(segmentname);
 
     //If segmentname is not inside the tree, back out:
-    if (it == tree.getSegments().end())
+    if (index < 0)
+        return -2;
+
+    return JntToJac(q_in, jac, (unsigned int)index);
+}
+
+int TreeJntToJacSolver::JntToJac(const JntArray& q_in, Jacobian& jac, unsigned int index) {
+    //First we check all the sizes:
+    if (q_in.rows() != flat.getNrOfJoints() || jac.columns() != flat.getNrOfJoints())
+        return -1;
+
+    if (index >= flat.getNrOfElements())
         return -2;
-    
+
     //Let's make the jacobian zero:
     SetToZero(jac);
-    
-    SegmentMap::const_iterator root = tree.getRootSegment();
 
     Frame T_total = Frame::Identity();
-    //Lets recursively iterate until we are in the root segment
-    while (it != root) {
-        //get the corresponding q_nr for this TreeElement:
-        unsigned int q_nr = GetTreeElementQNr(it->second);
-        
+    //Lets iterate over the parents until we are in the root segment
+    for (unsigned int i = index; i != 0; i = flat.getParent(i)) {
+        const Segment& segment = flat.getSegment(i);
+        //get the corresponding q_nr for this element:
+        const int q_nr = flat.getQNr(i);
+        const double q = q_nr < 0 ? 0.0 : q_in(q_nr);
+
         //get the pose of the segment:
-        Frame T_local = GetTreeElementSegment(it->second).pose(q_in(q_nr));
+        Frame T_local = segment.pose(q);
         //calculate new T_end:
         T_total = T_local * T_total;
-        
+
         //get the twist of the segment:
-        if (GetTreeElementSegment(it->second).getJoint().getType() != Joint::Fixed) {
-            Twist t_local = GetTreeElementSegment(it->second).twist(q_in(q_nr), 1.0);
+        if (q_nr >= 0) {
+            Twist t_local = segment.twist(q, 1.0);
             //transform the endpoint of the local twist to the global endpoint:
             t_local = t_local.RefPoint(T_total.p - T_local.p);
             //transform the base of the twist to the endpoint
@@ -56,14 +65,11 @@ int TreeJntToJacSolver::JntToJac(const JntArray& q_in, Jacobian& jac, const std:
             //store the twist in the jacobian:
             jac.setColumn(q_nr,t_local);
         }//endif
-        //goto the parent
-        it = GetTreeElementParent(it->second);
-    }//endwhile
+    }//endfor
     //Change the base of the complete jacobian from the endpoint to the base
     changeBase(jac, T_total.M, jac);
-    
+
     return 0;
-    
+
 }//end JntToJac
 }//end namespace
-
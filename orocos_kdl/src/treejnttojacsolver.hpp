@@ -9,6 +9,7 @@
 #define TREEJNTTOJACSOLVER_HPP_
 
 #include "tree.hpp"
+#include "flattree.hpp"
 #include "jacobian.hpp"
 #include "jntarray.hpp"
 
@@ -28,8 +29,16 @@ public:
     int JntToJac(const JntArray& q_in, Jacobian& jac,
             const std::string& segmentname);
 
+    /*
+     * Same as above for the element with the given index in getFlatTree(),
+     * without any name lookup.
+     */
+    int JntToJac(const JntArray& q_in, Jacobian& jac, unsigned int index);
+
+    const FlatTree& getFlatTree() const { return flat; }
+
 private:
-    KDL::Tree tree;
+    FlatTree flat;
 
 };
 
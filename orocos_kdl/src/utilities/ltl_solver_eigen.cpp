@@ -0,0 +1,88 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "ltl_solver_eigen.hpp"
+
+#include <cmath>
+
+namespace KDL
+{
+    int ltl_factorize(Eigen::MatrixXd& H, const std::vector<int>& lambda)
+    {
+        const int n = H.rows();
+        if (H.cols() != n || (int)lambda.size() != n)
+            return SolverI::E_SIZE_MISMATCH;
+        for (int i = 0; i < n; i++)
+            if (lambda[i] < -1 || lambda[i] >= i)
+                return SolverI::E_SIZE_MISMATCH;
+
+        for (int k = n - 1; k >= 0; k--) {
+            if (!(H(k, k) > 0.0))
+                return SolverI::E_UNDEFINED;
+            H(k, k) = std::sqrt(H(k, k));
+            for (int i = lambda[k]; i != -1; i = lambda[i])
+                H(k, i) /= H(k, k);
+            for (int i = lambda[k]; i != -1; i = lambda[i])
+                for (int j = i; j != -1; j = lambda[j])
+                    H(i, j) -= H(k, i) * H(k, j);
+        }
+        return SolverI::E_NOERROR;
+    }
+
+    template <typename Derived>
+    static void solveLt(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixBase<Derived>& x)
+    {
+        for (int i = L.rows() - 1; i >= 0; i--) {
+            x.row(i) /= L(i, i);
+            for (int j = lambda[i]; j != -1; j = lambda[j])
+                x.row(j) -= L(i, j) * x.row(i);
+        }
+    }
+
+    template <typename Derived>
+    static void solveL(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixBase<Derived>& x)
+    {
+        for (int i = 0; i < L.rows(); i++) {
+            for (int j = lambda[i]; j != -1; j = lambda[j])
+                x.row(i) -= L(i, j) * x.row(j);
+            x.row(i) /= L(i, i);
+        }
+    }
+
+    void ltl_solve(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixXd& x)
+    {
+        solveLt(L, lambda, x);
+        solveL(L, lambda, x);
+    }
+
+    void ltl_solve(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::VectorXd& x)
+    {
+        solveLt(L, lambda, x);
+        solveL(L, lambda, x);
+    }
+
+    void ltl_solve_Lt(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixXd& x)
+    {
+        solveLt(L, lambda, x);
+    }
+
+    void ltl_solve_L(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixXd& x)
+    {
+        solveL(L, lambda, x);
+    }
+}
@@ -0,0 +1,76 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#ifndef KDL_LTL_SOLVER_EIGEN_HPP
+#define KDL_LTL_SOLVER_EIGEN_HPP
+
+#include <Eigen/Core>
+#include <vector>
+#include "../solveri.hpp"
+
+namespace KDL
+{
+    /**
+     * \brief Sparse factorization H = L^T*L of a joint space inertia matrix.
+     *
+     * In the joint space inertia matrix of a kinematic tree H(i,j) is
+     * zero unless joint i is an ancestor of joint j or the other way
+     * round. With the joints numbered such that every joint comes after
+     * its parent, this pattern is described by the parent array lambda,
+     * lambda[i] being the parent joint of joint i (-1 for a joint
+     * without parent joint). The factorization L^T*L, with L lower
+     * triangular, keeps this pattern: L(i,j) is zero unless j is an
+     * ancestor of i, and it is computed by walking the ancestors of every
+     * joint only. This costs O(n*d^2) instead of O(n^3) operations, with
+     * d the depth of the tree; the solves cost O(n*d) instead of O(n^2).
+     * For a chain, lambda[i] = i-1, it is a plain Cholesky factorization.
+     *
+     * The algorithms are those of "Rigid Body Dynamics Algorithms", Roy
+     * Featherstone, 2008, section 6.5.
+     *
+     * @param H symmetric positive definite n x n matrix, only the lower
+     * triangle is used; replaced by L in the lower triangle, the strictly
+     * upper triangle is not touched
+     * @param lambda parent array of size n, lambda[i] < i
+     * @return E_NOERROR, E_SIZE_MISMATCH if the sizes do not match or
+     * lambda is not a parent array, E_UNDEFINED if H is not positive definite
+     */
+    int ltl_factorize(Eigen::MatrixXd& H, const std::vector<int>& lambda);
+
+    /**
+     * Solve H*x = b in place, with L the result of ltl_factorize().
+     *
+     * @param L factorization of H
+     * @param lambda parent array used for the factorization
+     * @param x b on input, H^-1*b on output, one column per right hand side
+     */
+    void ltl_solve(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixXd& x);
+    void ltl_solve(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::VectorXd& x);
+
+    /**
+     * Multiply by L^-T in place, e.g. to compute J*H^-1*J^T as Y^T*Y
+     * with Y = L^-T*J^T.
+     */
+    void ltl_solve_Lt(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixXd& x);
+
+    /// Multiply by L^-1 in place
+    void ltl_solve_L(const Eigen::MatrixXd& L, const std::vector<int>& lambda, Eigen::MatrixXd& x);
+}
+
+#endif
@@ -0,0 +1,168 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#ifndef KDL_RALLN_H
+#define KDL_RALLN_H
+
+#include "rall1d.h"
+#include <Eigen/Core>
+
+namespace KDL {
+
+/**
+ * Gradient type for Rall1d that holds N partial derivatives (lanes)
+ * at once. With it a single evaluation of an expression propagates
+ * the derivatives with respect to N independent variables, e.g. all
+ * joint positions of a chain, instead of one direction per pass as
+ * with Rall1d<double>.
+ *
+ * The lanes of type T are combined element by element. T can itself
+ * be a Rall1d with an N lane gradient, which gives the second order
+ * derivatives (see RallN2d).
+ */
+template <typename T, int N>
+class RallNGradient
+{
+public:
+    T lane[N];
+
+    RallNGradient() {}
+
+    T& operator[](int i) {return lane[i];}
+    const T& operator[](int i) const {return lane[i];}
+
+    RallNGradient& operator+=(const RallNGradient& rhs)
+        {for (int i=0;i<N;++i) lane[i]+=rhs.lane[i]; return *this;}
+    RallNGradient& operator-=(const RallNGradient& rhs)
+        {for (int i=0;i<N;++i) lane[i]-=rhs.lane[i]; return *this;}
+    RallNGradient& operator*=(const T& rhs)
+        {for (int i=0;i<N;++i) lane[i]*=rhs; return *this;}
+    RallNGradient& operator/=(const T& rhs)
+        {for (int i=0;i<N;++i) lane[i]/=rhs; return *this;}
+    RallNGradient& operator*=(double rhs)
+        {for (int i=0;i<N;++i) lane[i]*=rhs; return *this;}
+    RallNGradient& operator/=(double rhs)
+        {for (int i=0;i<N;++i) lane[i]/=rhs; return *this;}
+
+    friend RallNGradient operator+(const RallNGradient& lhs,const RallNGradient& rhs)
+        {RallNGradient r(lhs); return r+=rhs;}
+    friend RallNGradient operator-(const RallNGradient& lhs,const RallNGradient& rhs)
+        {RallNGradient r(lhs); return r-=rhs;}
+    friend RallNGradient operator-(const RallNGradient& arg)
+        {RallNGradient r; for (int i=0;i<N;++i) r.lane[i]=-arg.lane[i]; return r;}
+    friend RallNGradient operator*(const T& s,const RallNGradient& v)
+        {RallNGradient r; for (int i=0;i<N;++i) r.lane[i]=s*v.lane[i]; return r;}
+    friend RallNGradient operator*(const RallNGradient& v,const T& s)
+        {RallNGradient r; for (int i=0;i<N;++i) r.lane[i]=v.lane[i]*s; return r;}
+    friend RallNGradient operator/(const RallNGradient& v,const T& s)
+        {RallNGradient r(v); return r/=s;}
+    friend RallNGradient operator*(double s,const RallNGradient& v)
+        {RallNGradient r; for (int i=0;i<N;++i) r.lane[i]=s*v.lane[i]; return r;}
+    friend RallNGradient operator*(const RallNGradient& v,double s)
+        {return s*v;}
+    friend RallNGradient operator/(const RallNGradient& v,double s)
+        {RallNGradient r(v); return r/=s;}
+
+    friend RallNGradient LinComb(const T& alfa,const RallNGradient& a,const T& beta,const RallNGradient& b)
+        {RallNGradient r; LinCombR(alfa,a,beta,b,r); return r;}
+    friend void LinCombR(const T& alfa,const RallNGradient& a,const T& beta,const RallNGradient& b,RallNGradient& result)
+        {for (int i=0;i<N;++i) result.lane[i]=alfa*a.lane[i]+beta*b.lane[i];}
+    friend void SetToZero(RallNGradient& arg)
+        {for (int i=0;i<N;++i) SetToZero(arg.lane[i]);}
+    friend bool Equal(const RallNGradient& a,const RallNGradient& b,double eps=epsilon)
+        {for (int i=0;i<N;++i) if (!Equal(a.lane[i],b.lane[i],eps)) return false; return true;}
+};
+
+/**
+ * The lanes of a first order gradient are doubles, they are stored in
+ * a fixed size Eigen vector so that Eigen vectorizes the element wise
+ * operations. The vector is not aligned, Rall1d objects can be stored
+ * in std containers and class members without aligned allocators.
+ */
+template <int N>
+class RallNGradient<double,N> : public Eigen::Matrix<double,N,1,Eigen::DontAlign>
+{
+public:
+    typedef Eigen::Matrix<double,N,1,Eigen::DontAlign> Base;
+
+    RallNGradient() : Base(Base::Zero()) {}
+
+    template <typename Derived>
+    RallNGradient(const Eigen::MatrixBase<Derived>& other) : Base(other) {}
+
+    template <typename Derived>
+    RallNGradient& operator=(const Eigen::MatrixBase<Derived>& other)
+        {Base::operator=(other); return *this;}
+
+    friend RallNGradient LinComb(double alfa,const RallNGradient& a,double beta,const RallNGradient& b)
+        {return alfa*a+beta*b;}
+    friend void LinCombR(double alfa,const RallNGradient& a,double beta,const RallNGradient& b,RallNGradient& result)
+        {result=alfa*a+beta*b;}
+    friend void SetToZero(RallNGradient& arg)
+        {arg.setZero();}
+    friend bool Equal(const RallNGradient& a,const RallNGradient& b,double eps=epsilon)
+        {return ((a-b).array().abs()<eps).all();}
+};
+
+/**
+ * Value and the N partial derivatives with respect to N independent
+ * variables. Create the variables with RallNVariable, the partial
+ * derivatives of a result x are x.grad[0..N-1].
+ */
+template <int N>
+using RallN = Rall1d<double,RallNGradient<double,N>,double>;
+
+/**
+ * Value, gradient and hessian with respect to N independent variables,
+ * a RallN nested into itself. Create the variables with
+ * RallN2dVariable, for a result x:
+ *  - x.t.t is the value
+ *  - x.t.grad[k] is the first derivative with respect to variable k
+ *  - x.grad[k].grad[l] is the second derivative with respect to
+ *    variables k and l
+ */
+template <int N>
+using RallN2d = Rall1d<RallN<N>,RallNGradient<RallN<N>,N>,double>;
+
+/**
+ * @return the i-th of N independent variables at the given value
+ */
+template <int N>
+inline RallN<N> RallNVariable(double value,int i)
+{
+    RallN<N> x(value);
+    x.grad[i]=1.0;
+    return x;
+}
+
+/**
+ * @return the i-th of N independent variables at the given value, with
+ * second order derivatives
+ */
+template <int N>
+inline RallN2d<N> RallN2dVariable(double value,int i)
+{
+    RallN2d<N> x(RallNVariable<N>(value,i));
+    x.grad[i]=RallN<N>(1.0);
+    return x;
+}
+
+}
+
+#endif
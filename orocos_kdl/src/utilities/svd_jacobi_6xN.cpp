@@ -0,0 +1,160 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include "svd_jacobi_6xN.hpp"
+#include <cmath>
+
+namespace KDL
+{
+    //round robin ordering of the 15 pairs of rows
+    static const int jacobi_pairs[5][3][2] = {{{0, 1}, {2, 3}, {4, 5}},
+                                              {{0, 2}, {1, 4}, {3, 5}},
+                                              {{0, 3}, {1, 5}, {2, 4}},
+                                              {{0, 4}, {1, 3}, {2, 5}},
+                                              {{0, 5}, {1, 2}, {3, 4}}};
+
+    SVD_Jacobi_6xN::SVD_Jacobi_6xN(unsigned int columns):
+        B(columns, 6),
+        W(Eigen::Matrix<double, 6, 6>::Identity()),
+        warm_start(false),
+        warm_valid(false),
+        max_warm_sweeps(5),
+        nr_of_sweeps(0),
+        nr_of_restarts(0)
+    {
+    }
+
+    void SVD_Jacobi_6xN::setWarmStart(bool warm_start_in, int max_warm_sweeps_in)
+    {
+        warm_start = warm_start_in;
+        max_warm_sweeps = max_warm_sweeps_in;
+    }
+
+    int SVD_Jacobi_6xN::calculate(const Eigen::MatrixXd& A, Eigen::MatrixXd& U, Eigen::VectorXd& S,
+                                  Eigen::MatrixXd& V, int maxiter, double epsilon)
+    {
+        const int cols = static_cast<int>(A.cols());
+        const int rank = cols < 6 ? cols : 6;
+        if (A.rows() != 6 || S.size() != cols || V.rows() != cols || V.cols() != cols ||
+            U.rows() != 6 || U.cols() < rank)
+            return -1;
+
+        nr_of_sweeps = 0;
+        int result = -2;
+        if (warm_start && warm_valid && B.rows() == cols) {
+            //the rotation of the last call, applied to the new A. It is
+            //orthonormalised first, rounding errors add up over many calls
+            for (int i = 0; i < 6; ++i) {
+                for (int j = 0; j < i; ++j)
+                    W.col(i) -= W.col(j).dot(W.col(i)) * W.col(j);
+                W.col(i).normalize();
+            }
+            B.noalias() = A.transpose() * W;
+            result = rotate(cols, max_warm_sweeps, epsilon);
+            if (result != 0)
+                ++nr_of_restarts;
+        }
+        if (result != 0) {
+            B = A.transpose();
+            W.setIdentity();
+            result = rotate(cols, maxiter, epsilon);
+        }
+        warm_valid = (result == 0);
+
+        //selection sort of the singular triplets in decreasing order
+        U.setZero();
+        S.setZero();
+        V.setZero();
+        for (int i = 0; i < rank; ++i) {
+            int k;
+            norms.maxCoeff(&k);
+            S(i) = std::sqrt(norms(k));
+            U.col(i) = W.col(k);
+            if (S(i) > 0.0)
+                V.col(i) = B.col(k) / S(i);
+            norms(k) = -1.0;
+        }
+        return result;
+    }
+
+    int SVD_Jacobi_6xN::rotate(int cols, int maxiter, double epsilon)
+    {
+        for (int i = 0; i < 6; ++i)
+            norms(i) = B.col(i).squaredNorm();
+        //rows of the size of the rounding errors, left by a rank
+        //deficient A, are never rotated
+        const double tiny = cols * epsilon * cols * epsilon * norms.sum();
+        const double epsilon2 = epsilon * epsilon;
+
+        bool converged = false;
+        for (int sweep = 0; sweep < maxiter && !converged; ++sweep) {
+            converged = true;
+            ++nr_of_sweeps;
+            for (int round = 0; round < 5; ++round) {
+                //the three rotations of a round, computed independently
+                double c[3], s[3], tg[3];
+                bool active[3];
+                for (int m = 0; m < 3; ++m) {
+                    const int p = jacobi_pairs[round][m][0];
+                    const int q = jacobi_pairs[round][m][1];
+                    const double alpha = norms(p);
+                    const double beta = norms(q);
+                    const double gamma = B.col(p).dot(B.col(q));
+                    active[m] = alpha > tiny && beta > tiny && gamma * gamma > epsilon2 * alpha * beta;
+                    //rotation that zeroes the off-diagonal element of
+                    //the 2x2 Gram matrix [alpha gamma; gamma beta]
+                    const double zeta = (beta - alpha) / (2.0 * (active[m] ? gamma : 1.0));
+                    const double t = (zeta >= 0.0 ? 1.0 : -1.0) / (std::fabs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                    c[m] = 1.0 / std::sqrt(1.0 + t * t);
+                    s[m] = c[m] * t;
+                    tg[m] = t * gamma;
+                }
+                for (int m = 0; m < 3; ++m) {
+                    if (!active[m])
+                        continue;
+                    converged = false;
+                    const int p = jacobi_pairs[round][m][0];
+                    const int q = jacobi_pairs[round][m][1];
+                    double* bp = B.col(p).data();
+                    double* bq = B.col(q).data();
+                    for (int k = 0; k < cols; ++k) {
+                        const double x = bp[k];
+                        const double y = bq[k];
+                        bp[k] = c[m] * x - s[m] * y;
+                        bq[k] = s[m] * x + c[m] * y;
+                    }
+                    double* wp = W.col(p).data();
+                    double* wq = W.col(q).data();
+                    for (int k = 0; k < 6; ++k) {
+                        const double x = wp[k];
+                        const double y = wq[k];
+                        wp[k] = c[m] * x - s[m] * y;
+                        wq[k] = s[m] * x + c[m] * y;
+                    }
+                    norms(p) -= tg[m];
+                    norms(q) += tg[m];
+                }
+            }
+            //refresh the norms, the updates lose accuracy for small rows
+            if (!converged)
+                for (int i = 0; i < 6; ++i)
+                    norms(i) = B.col(i).squaredNorm();
+        }
+        return converged ? 0 : -2;
+    }
+}
@@ -0,0 +1,115 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_SVD_JACOBI_6XN_HPP
+#define KDL_SVD_JACOBI_6XN_HPP
+
+#include <Eigen/Core>
+
+namespace KDL
+{
+    /**
+     * Singular value decomposition used by the velocity IK solvers
+     */
+    enum SVDMethod {
+        SVD_HOUSEHOLDER, //! Householder bidiagonalisation (svd_eigen_HH or SVD_HH)
+        SVD_JACOBI_6XN,  //! One-sided Jacobi kernel for 6 x n matrices (SVD_Jacobi_6xN)
+        SVD_JACOBI_6XN_WARM //! SVD_Jacobi_6xN started from the previous decomposition
+    };
+
+    /**
+     * SVD of a 6 x n matrix, like a jacobian, with the one-sided Jacobi
+     * (Hestenes) method. Plane rotations are applied to the six rows of
+     * A until they are mutually orthogonal, which gives A = U*S*V' with
+     * the 6 x 6 rotation U accumulated in a fixed size matrix. Every
+     * sweep visits the 15 pairs of rows in 5 rounds of 3 disjoint pairs,
+     * the rotations of one round are independent of each other. The
+     * iterations stop as soon as a sweep does not rotate any pair.
+     *
+     * Only the min(6,n) leading singular triplets are computed: the
+     * remaining singular values and columns of U and V are set to zero.
+     * This is all a (damped) pseudo inverse needs. The singular values
+     * are sorted in decreasing order.
+     *
+     * With warm start enabled the rotation U of the previous call is the
+     * initial guess: for a slowly changing A, like the jacobian between
+     * two control ticks, the rows of A'*U are almost orthogonal already
+     * and one or two sweeps refine them. When this does not converge
+     * within a few sweeps the decomposition restarts from scratch.
+     */
+    class SVD_Jacobi_6xN
+    {
+    public:
+        /**
+         * @param columns the number of columns to allocate the
+         * workspace for, other sizes are reallocated on first use
+         */
+        explicit SVD_Jacobi_6xN(unsigned int columns=0);
+
+        /**
+         * @param A matrix<double>(6xn)
+         * @param U matrix<double>(6xm), m >= min(6,n)
+         * @param S vector<double> n
+         * @param V matrix<double>(nxn)
+         * @param maxiter maximum number of sweeps over all pairs of rows
+         * @param epsilon two rows are orthogonal when the cosine of their
+         * angle is below epsilon, rows with a norm below n*epsilon times
+         * the norm of A are not rotated
+         *
+         * @return -1 if the sizes do not match, -2 if maxiter is
+         * exceeded, 0 otherwise
+         */
+        int calculate(const Eigen::MatrixXd& A, Eigen::MatrixXd& U, Eigen::VectorXd& S,
+                      Eigen::MatrixXd& V, int maxiter=150, double epsilon=1e-15);
+
+        /**
+         * Start every decomposition from the rotation of the previous
+         * successful one.
+         *
+         * @param warm_start enable or disable the warm start
+         * @param max_warm_sweeps the number of sweeps after which a warm
+         * started decomposition falls back to a full one
+         */
+        void setWarmStart(bool warm_start, int max_warm_sweeps=5);
+        bool getWarmStart() const { return warm_start; }
+
+        /// Forget the previous decomposition, the next one starts cold
+        void reset() { warm_valid = false; }
+
+        /// Number of sweeps of the last call, a fallback included
+        int getNrOfSweeps() const { return nr_of_sweeps; }
+
+        /// Number of warm starts that fell back to a full decomposition
+        unsigned int getNrOfRestarts() const { return nr_of_restarts; }
+
+    private:
+        int rotate(int cols, int maxiter, double epsilon);
+
+        /// transpose of A, rotated in place, its columns become S*V'
+        Eigen::Matrix<double, Eigen::Dynamic, 6> B;
+        Eigen::Matrix<double, 6, 6> W;
+        /// squared norms of the columns of B
+        Eigen::Matrix<double, 6, 1> norms;
+        bool warm_start;
+        bool warm_valid;
+        int max_warm_sweeps;
+        int nr_of_sweeps;
+        unsigned int nr_of_restarts;
+    };
+}
+#endif
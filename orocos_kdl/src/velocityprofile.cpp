@@ -46,10 +46,60 @@
 #include "velocityprofile_dirac.hpp"
 #include "velocityprofile_trap.hpp"
 #include "velocityprofile_traphalf.hpp"
+#include "velocityprofile_jerklimited.hpp"
 #include <string.h>
+#include <algorithm>
 
 namespace KDL {
 
+void VelocityProfile::Evaluate(const double* time,unsigned int n,
+	double* pos,double* vel,double* acc) const {
+	for (unsigned int i=0;i<n;++i) {
+		if (pos) pos[i] = Pos(time[i]);
+		if (vel) vel[i] = Vel(time[i]);
+		if (acc) acc[i] = Acc(time[i]);
+	}
+}
+
+namespace {
+	// pos, vel and acc of a phase with position k[0]+t*(k[1]+k[2]*t) at
+	// the times [begin,end): loops without branches, which vectorize
+	void EvaluatePhase(const double* time,unsigned int begin,unsigned int end,
+		const double k[3],double* pos,double* vel,double* acc) {
+		const double k1 = k[0], k2 = k[1], k3 = k[2];
+		if (pos)
+			for (unsigned int i=begin;i<end;++i)
+				pos[i] = k1+time[i]*(k2+k3*time[i]);
+		if (vel)
+			for (unsigned int i=begin;i<end;++i)
+				vel[i] = k2+2*k3*time[i];
+		if (acc)
+			for (unsigned int i=begin;i<end;++i)
+				acc[i] = 2*k3;
+	}
+}
+
+bool VelocityProfile::EvaluatePhases(const double* time,unsigned int n,
+	double startpos,double endpos,double t1,double t2,double duration,
+	const double a[3],const double b[3],const double c[3],
+	double* pos,double* vel,double* acc) {
+	if (!std::is_sorted(time,time+n))
+		return false;
+	// the same phase bounds as the Pos(), Vel() and Acc() of the profiles
+	const unsigned int i0 = std::lower_bound(time,time+n,0.0)-time;
+	const unsigned int i1 = std::lower_bound(time+i0,time+n,t1)-time;
+	const unsigned int i2 = std::lower_bound(time+i1,time+n,t2)-time;
+	const unsigned int i3 = std::upper_bound(time+i2,time+n,duration)-time;
+	const double before[3] = {startpos,0,0};
+	const double after[3] = {endpos,0,0};
+	EvaluatePhase(time,0,i0,before,pos,vel,acc);
+	EvaluatePhase(time,i0,i1,a,pos,vel,acc);
+	EvaluatePhase(time,i1,i2,b,pos,vel,acc);
+	EvaluatePhase(time,i2,i3,c,pos,vel,acc);
+	EvaluatePhase(time,i3,n,after,pos,vel,acc);
+	return true;
+}
+
 VelocityProfile* VelocityProfile::Read(std::istream& is) {
 	IOTrace("VelocityProfile::Read");
 	char storage[25];
@@ -86,6 +136,18 @@ VelocityProfile* VelocityProfile::Read(std::istream& is) {
 		Eat(is,']');
 		IOTracePop();
 		return new VelocityProfile_TrapHalf(maxvel,maxacc,starting);
+	} else if (strcmp(storage,"JERKLIMITED")==0) {
+		double maxvel;
+		double maxacc;
+		double maxjerk;
+		is >> maxvel;
+		Eat(is,',');
+		is >> maxacc;
+		Eat(is,',');
+		is >> maxjerk;
+		Eat(is,']');
+		IOTracePop();
+		return new VelocityProfile_JerkLimited(maxvel,maxacc,maxjerk);
 	}
 	else {
 		throw Error_MotionIO_Unexpected_MotProf();
@@ -90,6 +90,25 @@ class VelocityProfile
 		// returns the acceleration at <time> in the units of the input
 		// of the constructor of the derived class.
 
+		virtual void Evaluate(const double* time,unsigned int n,
+			double* pos,double* vel,double* acc) const;
+		// evaluates Pos(), Vel() and Acc() at the <n> times in <time>
+		// into the arrays <pos>, <vel> and <acc>; an array that is 0 is
+		// skipped. The default calls Pos(), Vel() and Acc() per sample,
+		// derived classes override it with loops the compiler can
+		// vectorize, to amortize the cost over many samples.
+
+		void PosBatch(const double* time,unsigned int n,double* pos) const {
+			Evaluate(time,n,pos,0,0);
+		}
+		void VelBatch(const double* time,unsigned int n,double* vel) const {
+			Evaluate(time,n,0,vel,0);
+		}
+		void AccBatch(const double* time,unsigned int n,double* acc) const {
+			Evaluate(time,n,0,0,acc);
+		}
+		// Pos(), Vel() and Acc() at the <n> times in <time>, see Evaluate()
+
 		virtual void Write(std::ostream& os) const = 0;
 		// Writes object to a stream.
 
@@ -100,6 +119,18 @@ class VelocityProfile
 		// returns copy of current VelocityProfile object. (virtual constructor)
 
 		virtual ~VelocityProfile() {}
+
+	protected:
+		static bool EvaluatePhases(const double* time,unsigned int n,
+			double startpos,double endpos,double t1,double t2,double duration,
+			const double a[3],const double b[3],const double c[3],
+			double* pos,double* vel,double* acc);
+		// Evaluate() for profiles of three phases with positions
+		// k[0]+t*(k[1]+k[2]*t), for k = a up to <t1>, b up to <t2> and c up
+		// to <duration>, and constant at <startpos> before 0 and at
+		// <endpos> after <duration>. Sorted times are split into the
+		// ranges of the phases and evaluated with loops that vectorize.
+		// Returns false, without evaluating, if <time> is not sorted.
 	};
 }
 
@@ -0,0 +1,144 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#include "velocityprofile_grid.hpp"
+#include "utilities/error.h"
+#include <algorithm>
+#include <cassert>
+
+namespace KDL {
+
+	VelocityProfile_Grid::VelocityProfile_Grid():
+		s(1, 0.0), sd(1, 0.0), sdd(1, 0.0), t(1, 0.0)
+	{
+	}
+
+	VelocityProfile_Grid::VelocityProfile_Grid(const std::vector<double>& _s, const std::vector<double>& _sd)
+	{
+		SetGrid(_s, _sd);
+	}
+
+	void VelocityProfile_Grid::SetGrid(const std::vector<double>& _s, const std::vector<double>& _sd)
+	{
+		assert(!_s.empty() && _s.size() == _sd.size());
+		s = _s;
+		sd = _sd;
+		const unsigned int n = s.size();
+		sdd.assign(n, 0.0);
+		t.assign(n, 0.0);
+		for (unsigned int i = 0; i + 1 < n; ++i) {
+			const double ds = s[i+1] - s[i];
+			const double v = sd[i] + sd[i+1];
+			// constant acceleration: ds = (sd_i + sd_i+1)/2*dt
+			if (ds > 0 && v > 0) {
+				sdd[i] = (sd[i+1]*sd[i+1] - sd[i]*sd[i])/(2*ds);
+				t[i+1] = t[i] + 2*ds/v;
+			}
+			else
+				t[i+1] = t[i];
+		}
+	}
+
+	void VelocityProfile_Grid::SetProfile(double /*pos1*/, double /*pos2*/)
+	{
+		throw Error_MotionPlanning_Not_Applicable();
+	}
+
+	void VelocityProfile_Grid::SetProfileDuration(double pos1, double pos2, double duration)
+	{
+		if (pos1 != s.front() || pos2 != s.back())
+			throw Error_MotionPlanning_Not_Applicable();
+		if (!(duration > t.back()) || t.back() <= 0)
+			return;
+		// t -> k*t scales the velocities with 1/k and the accelerations with 1/k^2
+		const double k = duration/t.back();
+		for (unsigned int i = 0; i < s.size(); ++i) {
+			sd[i] /= k;
+			sdd[i] /= k*k;
+			t[i] *= k;
+		}
+	}
+
+	unsigned int VelocityProfile_Grid::Lookup(double time, double& tau) const
+	{
+		if (!(time > 0)) {
+			tau = 0;
+			return 0;
+		}
+		if (time >= t.back()) {
+			// the last interval with a duration, at its end
+			unsigned int i = t.size() - 1;
+			while (i > 0 && t[i-1] == t.back())
+				--i;
+			if (i == 0) {
+				tau = 0;
+				return t.size() - 1;
+			}
+			tau = t[i] - t[i-1];
+			return i - 1;
+		}
+		const unsigned int i = std::upper_bound(t.begin(), t.end(), time) - t.begin() - 1;
+		tau = time - t[i];
+		return i;
+	}
+
+	double VelocityProfile_Grid::Duration() const
+	{
+		return t.back();
+	}
+
+	double VelocityProfile_Grid::Pos(double time) const
+	{
+		double tau;
+		const unsigned int i = Lookup(time, tau);
+		return s[i] + sd[i]*tau + 0.5*sdd[i]*tau*tau;
+	}
+
+	double VelocityProfile_Grid::Vel(double time) const
+	{
+		if (time < 0 || time > t.back())
+			return 0;
+		double tau;
+		const unsigned int i = Lookup(time, tau);
+		return sd[i] + sdd[i]*tau;
+	}
+
+	double VelocityProfile_Grid::Acc(double time) const
+	{
+		if (time < 0 || time > t.back())
+			return 0;
+		double tau;
+		const unsigned int i = Lookup(time, tau);
+		return sdd[i];
+	}
+
+	void VelocityProfile_Grid::Write(std::ostream& os) const
+	{
+		os << "GRID[ " << s.size();
+		for (unsigned int i = 0; i < s.size(); ++i)
+			os << " " << s[i] << " " << sd[i];
+		os << " ]";
+	}
+
+	VelocityProfile* VelocityProfile_Grid::Clone() const
+	{
+		return new VelocityProfile_Grid(*this);
+	}
+
+}
@@ -0,0 +1,86 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef KDL_VELOCITYPROFILE_GRID_HPP
+#define KDL_VELOCITYPROFILE_GRID_HPP
+
+#include "velocityprofile.hpp"
+#include <vector>
+
+namespace KDL {
+
+	/**
+	 * \brief A VelocityProfile given by its velocity at a grid of positions.
+	 *
+	 * Between two grid points s_i and s_i+1 the acceleration is constant,
+	 * (sd_i+1^2 - sd_i^2)/(2*(s_i+1 - s_i)), so the square of the velocity
+	 * is linear in s. This is the form of the profiles computed by
+	 * ChainPathParamSolver_TOPPRA.
+	 * @ingroup Motion
+	 */
+	class VelocityProfile_Grid : public VelocityProfile
+	{
+	public:
+		/// Profile standing still at 0
+		VelocityProfile_Grid();
+
+		/// @see SetGrid()
+		VelocityProfile_Grid(const std::vector<double>& s, const std::vector<double>& sd);
+
+		/**
+		 * Sets the profile.
+		 * @param s increasing grid positions
+		 * @param sd velocities >= 0 at the grid positions; two successive
+		 * zero velocities are only allowed at the same position
+		 */
+		void SetGrid(const std::vector<double>& s, const std::vector<double>& sd);
+
+		/// Not applicable, throws Error_MotionPlanning_Not_Applicable
+		virtual void SetProfile(double pos1, double pos2);
+
+		/**
+		 * Stretches the profile in time to the given duration, which
+		 * cannot be shorter than the current one. pos1 and pos2 have to
+		 * be the ends of the grid, otherwise
+		 * Error_MotionPlanning_Not_Applicable is thrown.
+		 */
+		virtual void SetProfileDuration(double pos1, double pos2, double duration);
+
+		virtual double Duration() const;
+		virtual double Pos(double time) const;
+		virtual double Vel(double time) const;
+		virtual double Acc(double time) const;
+		virtual void Write(std::ostream& os) const;
+		virtual VelocityProfile* Clone() const;
+		virtual ~VelocityProfile_Grid() {}
+
+		/// Number of grid points
+		unsigned int NrOfPoints() const { return s.size(); }
+		/// Time at which grid point i is reached
+		double Time(unsigned int i) const { return t[i]; }
+
+	private:
+		// grid interval active at time, and the time within it
+		unsigned int Lookup(double time, double& tau) const;
+
+		std::vector<double> s, sd, sdd, t;
+	};
+
+}
+
+#endif
@@ -0,0 +1,227 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#include "velocityprofile_jerklimited.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace KDL {
+
+	VelocityProfile_JerkLimited::VelocityProfile_JerkLimited(double _maxvel, double _maxacc, double _maxjerk):
+		maxvel(_maxvel), maxacc(_maxacc), maxjerk(_maxjerk)
+	{
+		// standing still at 0
+		for (int k = 0; k < NR_OF_PHASES; ++k)
+			j[k] = d[k] = 0.0;
+		for (int k = 0; k <= NR_OF_PHASES; ++k)
+			p[k] = v[k] = a[k] = t[k] = 0.0;
+	}
+
+	void VelocityProfile_JerkLimited::SetMax(double _maxvel, double _maxacc, double _maxjerk)
+	{
+		maxvel = _maxvel;
+		maxacc = _maxacc;
+		maxjerk = _maxjerk;
+	}
+
+	void VelocityProfile_JerkLimited::velocityChange(double vel, double acc, double target_vel,
+	                                                 double* jerk, double* duration) const
+	{
+		// Accelerate towards the target velocity when bringing the
+		// acceleration to zero right away stays short of it, otherwise
+		// decelerate; mirrored below so that the peak acceleration is >= 0.
+		const double vel_stop = vel + acc*std::abs(acc)/(2*maxjerk);
+		const double dir = (target_vel >= vel_stop) ? 1.0 : -1.0;
+		const double acc0 = dir*acc;
+		const double dvel = dir*(target_vel - vel);
+		// without a phase at the peak acceleration ap, the velocity
+		// changes by (2*ap^2 - acc0^2)/(2*maxjerk)
+		double ap = maxacc;
+		if (acc0 <= maxacc)
+			ap = std::min(maxacc, std::sqrt(std::max(0.0, maxjerk*dvel + 0.5*acc0*acc0)));
+		const double t1 = std::abs(ap - acc0)/maxjerk;
+		const double t3 = ap/maxjerk;
+		const double dvel13 = 0.5*(acc0 + ap)*t1 + 0.5*ap*t3;
+		jerk[0] = (ap >= acc0) ? dir*maxjerk : -dir*maxjerk;
+		duration[0] = t1;
+		jerk[1] = 0.0;
+		duration[1] = (ap > 0) ? std::max(0.0, (dvel - dvel13)/ap) : 0.0;
+		jerk[2] = -dir*maxjerk;
+		duration[2] = t3;
+	}
+
+	void VelocityProfile_JerkLimited::integrate()
+	{
+		for (int k = 0; k < NR_OF_PHASES; ++k) {
+			const double T = d[k];
+			p[k+1] = p[k] + T*(v[k] + T*(0.5*a[k] + T*j[k]/6.0));
+			v[k+1] = v[k] + T*(a[k] + 0.5*T*j[k]);
+			a[k+1] = a[k] + T*j[k];
+			t[k+1] = t[k] + T;
+		}
+	}
+
+	double VelocityProfile_JerkLimited::plan(double peak_vel, double cruise)
+	{
+		velocityChange(v[0], a[0], peak_vel, j, d);
+		j[3] = 0.0;
+		d[3] = cruise;
+		velocityChange(peak_vel, 0.0, 0.0, j+4, d+4);
+		integrate();
+		return p[NR_OF_PHASES] - p[0];
+	}
+
+	void VelocityProfile_JerkLimited::SetProfile(double pos1, double pos2)
+	{
+		SetProfile(pos1, 0.0, 0.0, pos2);
+	}
+
+	void VelocityProfile_JerkLimited::SetProfile(double pos, double vel, double acc, double target)
+	{
+		p[0] = pos;
+		v[0] = vel;
+		a[0] = acc;
+		t[0] = 0.0;
+		const double delta = target - pos;
+		const double dist_max = plan(maxvel, 0.0);
+		if (delta >= dist_max)
+			plan(maxvel, (delta - dist_max)/maxvel);
+		else {
+			const double dist_min = plan(-maxvel, 0.0);
+			if (delta <= dist_min)
+				plan(-maxvel, (dist_min - delta)/maxvel);
+			else {
+				// The distance is continuous in the peak velocity, find where
+				// it is delta with the Illinois variant of regula falsi
+				double lo = -maxvel, hi = maxvel;
+				double f_lo = dist_min - delta, f_hi = dist_max - delta;
+				double peak = 0.0;
+				int side = 0;
+				for (int i = 0; i < 100; ++i) {
+					peak = (lo*f_hi - hi*f_lo)/(f_hi - f_lo);
+					if (!(peak > lo && peak < hi))
+						break;
+					const double f = plan(peak, 0.0) - delta;
+					if (f == 0.0)
+						break;
+					if (f < 0) {
+						lo = peak;
+						f_lo = f;
+						if (side < 0)
+							f_hi *= 0.5;
+						side = -1;
+					}
+					else {
+						hi = peak;
+						f_hi = f;
+						if (side > 0)
+							f_lo *= 0.5;
+						side = 1;
+					}
+				}
+				plan(peak, 0.0);
+			}
+		}
+		p[NR_OF_PHASES] = target;
+		v[NR_OF_PHASES] = a[NR_OF_PHASES] = 0.0;
+	}
+
+	void VelocityProfile_JerkLimited::SetProfileDuration(double pos1, double pos2, double newduration)
+	{
+		SetProfile(pos1, pos2);
+		const double duration = t[NR_OF_PHASES];
+		if (!(newduration > duration) || duration <= 0)
+			return;
+		// t -> k*t scales the velocity with 1/k, the acceleration with 1/k^2
+		// and the jerk with 1/k^3
+		const double k = newduration/duration;
+		for (int i = 0; i < NR_OF_PHASES; ++i) {
+			j[i] /= k*k*k;
+			d[i] *= k;
+		}
+		integrate();
+		p[NR_OF_PHASES] = pos2;
+		v[NR_OF_PHASES] = a[NR_OF_PHASES] = 0.0;
+	}
+
+	int VelocityProfile_JerkLimited::Lookup(double time, double& tau) const
+	{
+		if (time >= t[NR_OF_PHASES]) {
+			tau = 0.0;
+			return NR_OF_PHASES;
+		}
+		int k = 0;
+		while (time >= t[k+1])
+			++k;
+		tau = std::max(0.0, time - t[k]);
+		return k;
+	}
+
+	double VelocityProfile_JerkLimited::Duration() const
+	{
+		return t[NR_OF_PHASES];
+	}
+
+	double VelocityProfile_JerkLimited::Pos(double time) const
+	{
+		double tau;
+		const int k = Lookup(time, tau);
+		if (k == NR_OF_PHASES)
+			return p[k];
+		return p[k] + tau*(v[k] + tau*(0.5*a[k] + tau*j[k]/6.0));
+	}
+
+	double VelocityProfile_JerkLimited::Vel(double time) const
+	{
+		double tau;
+		const int k = Lookup(time, tau);
+		if (k == NR_OF_PHASES)
+			return v[k];
+		return v[k] + tau*(a[k] + 0.5*tau*j[k]);
+	}
+
+	double VelocityProfile_JerkLimited::Acc(double time) const
+	{
+		double tau;
+		const int k = Lookup(time, tau);
+		if (k == NR_OF_PHASES)
+			return a[k];
+		return a[k] + tau*j[k];
+	}
+
+	double VelocityProfile_JerkLimited::Jerk(double time) const
+	{
+		double tau;
+		const int k = Lookup(time, tau);
+		if (k == NR_OF_PHASES || time < 0)
+			return 0.0;
+		return j[k];
+	}
+
+	void VelocityProfile_JerkLimited::Write(std::ostream& os) const
+	{
+		os << "JERKLIMITED[" << maxvel << "," << maxacc << "," << maxjerk << "]";
+	}
+
+	VelocityProfile* VelocityProfile_JerkLimited::Clone() const
+	{
+		return new VelocityProfile_JerkLimited(*this);
+	}
+
+}
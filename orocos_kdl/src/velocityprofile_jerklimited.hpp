@@ -0,0 +1,107 @@
+// Version: 1.0
+// URL: http://www.orocos.org/kdl
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+
+#ifndef KDL_VELOCITYPROFILE_JERKLIMITED_HPP
+#define KDL_VELOCITYPROFILE_JERKLIMITED_HPP
+
+#include "velocityprofile.hpp"
+
+namespace KDL {
+
+	/**
+	 * \brief A time-optimal VelocityProfile with limited velocity,
+	 * acceleration and jerk, that can start from any state.
+	 *
+	 * The motion consists of seven phases of constant jerk: three that
+	 * change the initial velocity and acceleration into a peak velocity
+	 * with zero acceleration, a phase at that velocity, and three that
+	 * come to rest at the target. The peak velocity is +-maxvel when the
+	 * target is far enough for a phase at that velocity, otherwise the
+	 * one for which the target is reached without it, found by regula
+	 * falsi on closed form distances; a new profile takes about a
+	 * microsecond.
+	 *
+	 * This makes it suitable for online trajectory generation: starting a
+	 * new profile at every control cycle from the state of the previous
+	 * one towards a moving target gives a motion with continuous position,
+	 * velocity and acceleration, see SetProfile(double,double,double,double)
+	 * and Trajectory_JerkLimited.
+	 *
+	 * An initial velocity above maxvel is brought back within the limit,
+	 * an initial acceleration above maxacc is not.
+	 * @ingroup Motion
+	 */
+	class VelocityProfile_JerkLimited : public VelocityProfile
+	{
+	public:
+		/// The limits have to be > 0
+		VelocityProfile_JerkLimited(double _maxvel=0, double _maxacc=0, double _maxjerk=0);
+
+		void SetMax(double _maxvel, double _maxacc, double _maxjerk);
+
+		/// Time-optimal profile from pos1 to pos2, from rest to rest
+		virtual void SetProfile(double pos1, double pos2);
+
+		/**
+		 * Stretches the rest to rest profile from pos1 to pos2 in time, to
+		 * the given duration when it is longer than the time-optimal one.
+		 */
+		virtual void SetProfileDuration(double pos1, double pos2, double newduration);
+
+		/**
+		 * Time-optimal profile from the given state to rest at target.
+		 * @param pos, vel, acc the state at time 0
+		 * @param target position to come to rest at
+		 */
+		void SetProfile(double pos, double vel, double acc, double target);
+
+		virtual double Duration() const;
+		virtual double Pos(double time) const;
+		virtual double Vel(double time) const;
+		virtual double Acc(double time) const;
+		/// The jerk at the given time, the second derivative of Acc()
+		double Jerk(double time) const;
+		virtual void Write(std::ostream& os) const;
+		virtual VelocityProfile* Clone() const;
+		virtual ~VelocityProfile_JerkLimited() {}
+
+	private:
+		static const int NR_OF_PHASES = 7;
+
+		// The three phases that change (vel, acc) into (target_vel, 0)
+		// in minimum time, into jerk[0..2] and duration[0..2]
+		void velocityChange(double vel, double acc, double target_vel, double* jerk, double* duration) const;
+		// Sets up the phases for the given peak velocity and duration at
+		// it, returns the distance they travel from the initial state
+		double plan(double peak_vel, double cruise);
+		// The states at the start of the phases, from the initial one
+		void integrate();
+		// Phase, and time within it, active at the given time
+		int Lookup(double time, double& tau) const;
+
+		double maxvel, maxacc, maxjerk;
+		// jerk and duration of each phase, the state at its start
+		// and its start time; index NR_OF_PHASES is the end
+		double j[NR_OF_PHASES], d[NR_OF_PHASES];
+		double p[NR_OF_PHASES+1], v[NR_OF_PHASES+1], a[NR_OF_PHASES+1], t[NR_OF_PHASES+1];
+	};
+
+}
+
+#endif
@@ -181,6 +181,49 @@ double VelocityProfile_Spline::Acc(double time) const
   return acceleration;
 }
 
+void VelocityProfile_Spline::Evaluate(const double* time, unsigned int n,
+  double* pos, double* vel, double* acc) const
+{
+  // Same sums as Pos(), Vel() and Acc(), with the powers unrolled so that
+  // the loops vectorize.
+  if (pos)
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      const double t1 = time[i], t2 = t1*t1, t3 = t2*t1, t4 = t3*t1, t5 = t4*t1;
+      pos[i] = coeff_[0] +
+               t1*coeff_[1] +
+               t2*coeff_[2] +
+               t3*coeff_[3] +
+               t4*coeff_[4] +
+               t5*coeff_[5];
+    }
+  }
+  if (vel)
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      const double t1 = time[i], t2 = t1*t1, t3 = t2*t1, t4 = t3*t1;
+      vel[i] = coeff_[1] +
+               2.0*t1*coeff_[2] +
+               3.0*t2*coeff_[3] +
+               4.0*t3*coeff_[4] +
+               5.0*t4*coeff_[5];
+    }
+  }
+  if (acc)
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      const double t1 = time[i], t2 = t1*t1, t3 = t2*t1;
+      acc[i] = 2.0*coeff_[2] +
+               6.0*t1*coeff_[3] +
+               12.0*t2*coeff_[4] +
+               20.0*t3*coeff_[5];
+    }
+  }
+}
+
 void VelocityProfile_Spline::Write(std::ostream& os) const
 {
   os << "coefficients : [ " << coeff_[0] << " " << coeff_[1] << " " << coeff_[2] << " " << coeff_[3] << " " << coeff_[4] << " " << coeff_[5] << " ]";
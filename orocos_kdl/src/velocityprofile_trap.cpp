@@ -186,6 +186,20 @@ VelocityProfile* VelocityProfile_Trap::Clone() const {
 VelocityProfile_Trap::~VelocityProfile_Trap() {}
 
 
+void VelocityProfile_Trap::Evaluate(const double* time,unsigned int n,
+	double* pos,double* vel,double* acc) const {
+	const double a[3] = {a1,a2,a3};
+	const double b[3] = {b1,b2,b3};
+	const double c[3] = {c1,c2,c3};
+	if (EvaluatePhases(time,n,startpos,endpos,t1,t2,duration,a,b,c,pos,vel,acc))
+		return;
+	for (unsigned int i=0;i<n;++i) {
+		if (pos) pos[i] = VelocityProfile_Trap::Pos(time[i]);
+		if (vel) vel[i] = VelocityProfile_Trap::Vel(time[i]);
+		if (acc) acc[i] = VelocityProfile_Trap::Acc(time[i]);
+	}
+}
+
 void VelocityProfile_Trap::Write(std::ostream& os) const {
 	os << "TRAPEZOIDAL[" << maxvel << "," << maxacc <<"]";
 }
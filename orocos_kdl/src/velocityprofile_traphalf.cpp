@@ -182,6 +182,20 @@ double VelocityProfile_TrapHalf::Acc(double time) const {
 	}
 }
 
+void VelocityProfile_TrapHalf::Evaluate(const double* time,unsigned int n,
+	double* pos,double* vel,double* acc) const {
+	const double a[3] = {a1,a2,a3};
+	const double b[3] = {b1,b2,b3};
+	const double c[3] = {c1,c2,c3};
+	if (EvaluatePhases(time,n,startpos,endpos,t1,t2,duration,a,b,c,pos,vel,acc))
+		return;
+	for (unsigned int i=0;i<n;++i) {
+		if (pos) pos[i] = VelocityProfile_TrapHalf::Pos(time[i]);
+		if (vel) vel[i] = VelocityProfile_TrapHalf::Vel(time[i]);
+		if (acc) acc[i] = VelocityProfile_TrapHalf::Acc(time[i]);
+	}
+}
+
 VelocityProfile* VelocityProfile_TrapHalf::Clone() const {
 	VelocityProfile_TrapHalf* res =  new VelocityProfile_TrapHalf(maxvel,maxacc, starting);
 	res->SetProfileDuration( this->startpos, this->endpos, this->duration );
@@ -122,6 +122,8 @@ class VelocityProfile_TrapHalf : public VelocityProfile
 		virtual double Pos(double time) const;
 		virtual double Vel(double time) const;
 		virtual double Acc(double time) const;
+		virtual void Evaluate(const double* time,unsigned int n,
+			double* pos,double* vel,double* acc) const;
 		virtual void Write(std::ostream& os) const;
 		virtual VelocityProfile* Clone() const;
 
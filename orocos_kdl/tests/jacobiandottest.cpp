@@ -331,3 +331,48 @@ void JacobianDotTest::testD2Symbolic(){
     
     CPPUNIT_ASSERT(success);
 }
+
+void JacobianDotTest::testJdotQdotConsistency(){
+    // This test verifies, for every representation, that the Jdot.qdot
+    // overload matches the full Jdot times qdot and that each column of
+    // Jdot matches the central difference of the Jacobian along qdot
+    Chain chain=KukaLWR_DHnew();
+    chain.addSegment(Segment(Joint(Joint::None),Frame(Rotation::RPY(0.3,-0.2,0.1),Vector(0.05,0.02,0.1))));
+    chain.addSegment(Segment(Joint(Joint::TransZ),Frame(Vector(0.0,0.1,0.0))));
+    const unsigned int nj = chain.getNrOfJoints();
+    const double dt = 1e-6;
+
+    ChainJntToJacDotSolver jdot_solver(chain);
+    ChainJntToJacSolver j_solver(chain);
+    ChainFkSolverPos_recursive fk_solver(chain);
+
+    JntArray q(nj),qdot(nj);
+    Jacobian jdot(nj),jac_plus(nj),jac_minus(nj),jdot_by_diff(nj);
+    Frame F_plus,F_minus;
+    Twist jdot_qdot,jdot_qdot_by_mult;
+
+    for(int representation=0; representation<3; ++representation)
+    {
+        jdot_solver.setRepresentation(representation);
+        for(int i=0; i<20; ++i)
+        {
+            random(q);
+            random(qdot);
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jdot_solver.JntToJacDot(JntArrayVel(q,qdot),jdot));
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jdot_solver.JntToJacDot(JntArrayVel(q,qdot),jdot_qdot));
+            MultiplyJacobian(jdot,qdot,jdot_qdot_by_mult);
+            CPPUNIT_ASSERT(Equal(jdot_qdot,jdot_qdot_by_mult,1e-10));
+
+            JntArray q_plus = diff(q,qdot,dt);
+            JntArray q_minus = diff(q,qdot,-dt);
+            j_solver.JntToJac(q_plus,jac_plus);
+            j_solver.JntToJac(q_minus,jac_minus);
+            fk_solver.JntToCart(q_plus,F_plus);
+            fk_solver.JntToCart(q_minus,F_minus);
+            changeRepresentation(jac_plus,F_plus,representation);
+            changeRepresentation(jac_minus,F_minus,representation);
+            Jdot_diff(jac_minus,jac_plus,2.0*dt,jdot_by_diff);
+            CPPUNIT_ASSERT(Equal(jdot,jdot_by_diff,1e-5));
+        }
+    }
+}
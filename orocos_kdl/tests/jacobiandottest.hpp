@@ -23,6 +23,8 @@ class JacobianDotTest : public CppUnit::TestFixture
     
     CPPUNIT_TEST(testD2Symbolic);
 
+    CPPUNIT_TEST(testJdotQdotConsistency);
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -42,6 +44,8 @@ public:
     void testKukaDiffBodyFixed();
     
     void testD2Symbolic();
+
+    void testJdotQdotConsistency();
 };
 
 #endif
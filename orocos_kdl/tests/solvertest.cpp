@@ -2,12 +2,44 @@
 #include <frames_io.hpp>
 #include <framevel_io.hpp>
 #include <kinfam_io.hpp>
+#include <Eigen/Dense>
+#include <cstdio>
+#include <fstream>
 #include <random>
+#include <thread>
 #include <time.h>
 #include <utilities/utility.h>
 
 CPPUNIT_TEST_SUITE_REGISTRATION( SolverTest );
 
+#ifdef __GLIBC__
+// count the heap allocations of the calling code, for the real-time tests,
+// volatile since the compiler assumes malloc does not read user globals
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+static volatile bool malloc_counting = false;
+static volatile unsigned long malloc_count = 0;
+extern "C" void* malloc(size_t size)
+{
+    if (malloc_counting)
+        malloc_count = malloc_count + 1;
+    return __libc_malloc(size);
+}
+extern "C" void* calloc(size_t n, size_t size)
+{
+    if (malloc_counting)
+        malloc_count = malloc_count + 1;
+    return __libc_calloc(n, size);
+}
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    if (malloc_counting)
+        malloc_count = malloc_count + 1;
+    return __libc_realloc(ptr, size);
+}
+#endif
+
 using namespace KDL;
 
 void SolverTest::setUp()
@@ -1439,6 +1471,95 @@ void SolverTest::LDLdecompTest()
     return;
 }
 
+void SolverTest::LTLdecompTest()
+{
+    std::cout<<"LTL Solver Test"<<std::endl;
+    double eps=1.e-9;
+
+    // Random parent array and a factor L with its sparsity pattern, L(i,j)
+    // only nonzero for j an ancestor of i, then H = L^T*L has the
+    // pattern of a joint space inertia matrix
+    const int n=12;
+    std::vector<int> lambda(n);
+    std::vector<std::vector<bool> > ancestor(n, std::vector<bool>(n, false));
+    Eigen::MatrixXd L=Eigen::MatrixXd::Zero(n,n);
+    for(int i=0;i<n;i++){
+        lambda[i]=rand()%(i+1)-1;
+        for(int j=lambda[i];j!=-1;j=lambda[j]){
+            ancestor[i][j]=true;
+            L(i,j)=(double)rand()/RAND_MAX-0.5;
+        }
+        L(i,i)=1.0+(double)rand()/RAND_MAX;
+    }
+    Eigen::MatrixXd H=L.transpose()*L;
+    for(int i=0;i<n;i++){
+        for(int j=0;j<n;j++){
+            if(i!=j && !ancestor[i][j] && !ancestor[j][i])
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, H(i,j), eps);
+        }
+    }
+
+    // The factorization recovers L on the pattern
+    Eigen::MatrixXd Lout=H;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, ltl_factorize(Lout, lambda));
+    for(int i=0;i<n;i++){
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(L(i,i), Lout(i,i), eps);
+        for(int j=lambda[i];j!=-1;j=lambda[j])
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(L(i,j), Lout(i,j), eps);
+    }
+
+    // The solves agree with the dense ones
+    Eigen::MatrixXd B=Eigen::MatrixXd::Random(n,3);
+    Eigen::MatrixXd X=B;
+    ltl_solve(Lout, lambda, X);
+    CPPUNIT_ASSERT(X.isApprox(H.llt().solve(B), eps));
+    Eigen::VectorXd x=B.col(0);
+    ltl_solve(Lout, lambda, x);
+    CPPUNIT_ASSERT(x.isApprox(X.col(0), eps));
+    X=B;
+    ltl_solve_Lt(Lout, lambda, X);
+    CPPUNIT_ASSERT(X.isApprox(L.transpose().triangularView<Eigen::Upper>().solve(B), eps));
+    X=B;
+    ltl_solve_L(Lout, lambda, X);
+    CPPUNIT_ASSERT(X.isApprox(L.triangularView<Eigen::Lower>().solve(B), eps));
+
+    // Errors
+    std::vector<int> lambda_wrong=lambda;
+    lambda_wrong[1]=1;
+    Lout=H;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, ltl_factorize(Lout, lambda_wrong));
+    Lout=-H;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_UNDEFINED, ltl_factorize(Lout, lambda));
+
+    // Operational space inertia against (J*H^-1*J^T)^-1 with dense algebra
+    Vector gravity(0.0, 0.0, -9.81);
+    Chain* chains[] = {&motomansia10dyn, &kukaLWR};
+    for (unsigned int c=0; c<2; c++)
+    {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        ChainDynParam dynparam(chain, gravity);
+        ChainJntToJacSolver jacsolver(chain);
+        JntArray q(nj);
+        for (unsigned int i=0; i<nj; i++)
+            random(q(i));
+        JntSpaceInertiaMatrix Hq(nj);
+        Jacobian jac(nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToMass(q, Hq));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.JntToJac(q, jac));
+        Eigen::Matrix<double,6,6> Lambda, Lambda_inv;
+        Lambda_inv=jac.data*Hq.data.inverse()*jac.data.transpose();
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToOperationalSpaceInertia(q, Lambda));
+        CPPUNIT_ASSERT((Lambda*Lambda_inv).isApprox(Eigen::Matrix<double,6,6>::Identity(), 1.e-6));
+    }
+
+    // With two joints J*H^-1*J^T is singular
+    ChainDynParam dynparam(chaindyn, gravity);
+    JntArray q(chaindyn.getNrOfJoints());
+    Eigen::Matrix<double,6,6> Lambda;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_UNDEFINED, dynparam.JntToOperationalSpaceInertia(q, Lambda));
+}
+
 void SolverTest::FdAndVereshchaginSolversConsistencyTest()
 {
     int ret;
@@ -1827,3 +1948,1374 @@ void SolverTest::ExternalWrenchEstimatorTest()
 
     return;
 }
+
+void SolverTest::DynParamConsistencyTest()
+{
+    std::cout<<"KDL Dynamic Parameters Consistency Test"<<std::endl;
+    double eps=1.e-9;
+    Vector gravity(0.0, 0.0, -9.81);
+
+    // JntToDynamics has to match the separate JntToMass, JntToCoriolis and JntToGravity calls
+    Chain* chains[] = {&chaindyn, &motomansia10dyn, &kukaLWR};
+    for (unsigned int c=0; c<3; c++)
+    {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        ChainDynParam dynparam(chain, gravity);
+
+        JntArray q(nj), qd(nj);
+        for (unsigned int i=0; i<nj; i++)
+        {
+            random(q(i));
+            random(qd(i));
+        }
+
+        JntSpaceInertiaMatrix H(nj), H_fused(nj);
+        JntArray coriolis(nj), coriolis_fused(nj);
+        JntArray grav(nj), grav_fused(nj);
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToMass(q, H));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToCoriolis(q, qd, coriolis));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToGravity(q, grav));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToDynamics(q, qd, H_fused, coriolis_fused, grav_fused));
+
+        for (unsigned int i=0; i<nj; i++)
+        {
+            CPPUNIT_ASSERT(Equal(coriolis(i), coriolis_fused(i), eps));
+            CPPUNIT_ASSERT(Equal(grav(i), grav_fused(i), eps));
+            for (unsigned int j=0; j<nj; j++)
+                CPPUNIT_ASSERT(Equal(H(i,j), H_fused(i,j), eps));
+        }
+
+        JntArray q_wrong(nj+1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, dynparam.JntToDynamics(q_wrong, qd, H_fused, coriolis_fused, grav_fused));
+    }
+}
+
+void SolverTest::CoriolisMatrixTest()
+{
+    std::cout<<"KDL Coriolis Matrix Test"<<std::endl;
+    double eps=1.e-9;
+    Vector gravity(0.0, 0.0, -9.81);
+
+    // C*qdot has to match JntToCoriolis and dH/dt = C + C', with dH/dt
+    // from central differences along qdot
+    Chain* chains[] = {&chaindyn, &motomansia10dyn, &kukaLWR};
+    for (unsigned int c=0; c<3; c++)
+    {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        ChainDynParam dynparam(chain, gravity);
+
+        JntArray q(nj), qd(nj), q_plus(nj), q_minus(nj);
+        for (unsigned int i=0; i<nj; i++)
+        {
+            random(q(i));
+            random(qd(i));
+        }
+        const double h=1.e-6;
+        for (unsigned int i=0; i<nj; i++)
+        {
+            q_plus(i)=q(i)+h*qd(i);
+            q_minus(i)=q(i)-h*qd(i);
+        }
+
+        Eigen::MatrixXd C(nj,nj);
+        JntArray coriolis(nj);
+        JntSpaceInertiaMatrix H_plus(nj), H_minus(nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToCoriolisMatrix(q, qd, C));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToCoriolis(q, qd, coriolis));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToMass(q_plus, H_plus));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToMass(q_minus, H_minus));
+
+        Eigen::VectorXd Cqd = C*qd.data;
+        Eigen::MatrixXd Hdot = (H_plus.data-H_minus.data)/(2*h);
+        for (unsigned int i=0; i<nj; i++)
+        {
+            CPPUNIT_ASSERT(Equal(Cqd(i), coriolis(i), eps));
+            for (unsigned int j=0; j<nj; j++)
+                CPPUNIT_ASSERT(Equal(Hdot(i,j), C(i,j)+C(j,i), 1.e-6));
+        }
+
+        Eigen::MatrixXd C_wrong(nj+1,nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, dynparam.JntToCoriolisMatrix(q, qd, C_wrong));
+    }
+}
+
+// RNE with the Rall1d based forward mode types of framevel.hpp, the
+// derivative part of q, q_dot and q_dotdot seeds one direction
+static void RNEVel(const Chain& chain, const Vector& grav, const std::vector<doubleVel>& q, const std::vector<doubleVel>& q_dot,
+                   const std::vector<doubleVel>& q_dotdot, const Wrenches& f_ext, std::vector<doubleVel>& torques)
+{
+    const unsigned int ns = chain.getNrOfSegments();
+    std::vector<RotationVel> R(ns);
+    std::vector<VectorVel> p(ns), S_vel(ns), S_rot(ns), F(ns), T(ns);
+    VectorVel v_vel, v_rot, a_vel(-grav, Vector::Zero()), a_rot;
+    unsigned int j = 0;
+    for (unsigned int i=0; i<ns; i++)
+    {
+        const Segment& segment = chain.getSegment(i);
+        const Joint& joint = segment.getJoint();
+        doubleVel angle(0.0), qd(0.0), qdd(0.0);
+        if (joint.getType() != Joint::Fixed)
+        {
+            angle = joint.getScale()*q[j]+joint.getOffset();
+            qd = q_dot[j];
+            qdd = q_dotdot[j];
+            j++;
+        }
+        RotationVel Rj = RotationVel::Identity();
+        VectorVel pj, s_vel, s_rot;
+        switch (joint.getType())
+        {
+        case Joint::RotAxis: case Joint::RotX: case Joint::RotY: case Joint::RotZ:
+            Rj = RotationVel::Rot2(joint.JointAxis(), angle);
+            pj = VectorVel(joint.getType() == Joint::RotAxis ? joint.JointOrigin() : Vector::Zero());
+            s_rot = VectorVel(joint.JointAxis()*joint.getScale());
+            s_vel = s_rot*(Rj*segment.getFrameToTipZero().p);
+            break;
+        case Joint::TransAxis: case Joint::TransX: case Joint::TransY: case Joint::TransZ:
+            pj = (joint.getType() == Joint::TransAxis ? joint.JointOrigin() : Vector::Zero())+VectorVel(joint.JointAxis())*angle;
+            s_vel = VectorVel(joint.JointAxis()*joint.getScale());
+            break;
+        default:
+            break;
+        }
+        // segment pose and twist for q_dot=1 in the segment frame, scaled as in Joint::twist()
+        R[i] = Rj*segment.getFrameToTipZero().M;
+        p[i] = pj+Rj*segment.getFrameToTipZero().p;
+        S_vel[i] = R[i].Inverse(s_vel);
+        S_rot[i] = R[i].Inverse(s_rot);
+        const VectorVel vj_vel = S_vel[i]*qd, vj_rot = S_rot[i]*qd;
+        v_vel = R[i].Inverse(v_vel-p[i]*v_rot)+vj_vel;
+        v_rot = R[i].Inverse(v_rot)+vj_rot;
+        a_vel = R[i].Inverse(a_vel-p[i]*a_rot)+S_vel[i]*qdd+v_rot*vj_vel+v_vel*vj_rot;
+        a_rot = R[i].Inverse(a_rot)+S_rot[i]*qdd+v_rot*vj_rot;
+        // f = I*a + v x* (I*v) - f_ext
+        const RigidBodyInertia& I = segment.getInertia();
+        const double m = I.getMass();
+        const Vector h = m*I.getCOG();
+        const RotationalInertia Irot = I.getRotationalInertia();
+        const VectorVel Iv_F = m*v_vel-h*v_rot, Iv_T = VectorVel(Irot*v_rot.p, Irot*v_rot.v)+h*v_vel;
+        F[i] = m*a_vel-h*a_rot+v_rot*Iv_F-f_ext[i].force;
+        T[i] = VectorVel(Irot*a_rot.p, Irot*a_rot.v)+h*a_vel+v_rot*Iv_T+v_vel*Iv_F-f_ext[i].torque;
+    }
+    for (int i=ns-1; i>=0; i--)
+    {
+        const Joint& joint = chain.getSegment(i).getJoint();
+        if (joint.getType() != Joint::Fixed)
+        {
+            --j;
+            torques[j] = dot(S_vel[i], F[i])+dot(S_rot[i], T[i])+joint.getInertia()*q_dotdot[j];
+        }
+        if (i != 0)
+        {
+            const VectorVel RF = R[i]*F[i];
+            F[i-1] += RF;
+            T[i-1] += R[i]*T[i]+p[i]*RF;
+        }
+    }
+}
+
+void SolverTest::IdSolverRNEDerivativesTest()
+{
+    std::cout<<"KDL RNE Derivatives Test"<<std::endl;
+    double eps=1.e-9;
+    Vector gravity(0.0, 0.0, -9.81);
+
+    // all joint types, with scale, offset, joint inertia and a fixed segment
+    Chain chainall;
+    chainall.addSegment(Segment(Joint(Joint::RotZ, 2.0, 0.3, 0.1), Frame(Rotation::RPY(0.1,0.2,0.3), Vector(0.1,0.0,0.4)),
+                                RigidBodyInertia(2.0, Vector(0.0,0.1,0.2), RotationalInertia(0.1,0.2,0.3,0.01,0.0,0.02))));
+    chainall.addSegment(Segment(Joint(Joint::TransX), Frame(Vector(0.0,0.2,0.1)),
+                                RigidBodyInertia(1.0, Vector(0.1,0.0,0.0), RotationalInertia(0.1,0.1,0.1,0.0,0.0,0.0))));
+    chainall.addSegment(Segment(Joint(Joint::None), Frame(Rotation::RotY(0.5), Vector(0.1,0.0,0.0)),
+                                RigidBodyInertia(0.5, Vector(0.0,0.0,0.1))));
+    chainall.addSegment(Segment(Joint("a", Vector(0.1,0.0,0.2), Vector(0.3,-0.4,0.5), Joint::RotAxis, 1.0, -0.2, 0.05),
+                                Frame(Rotation::RotX(0.3), Vector(0.0,0.1,0.3)),
+                                RigidBodyInertia(1.5, Vector(0.0,0.05,0.1), RotationalInertia(0.2,0.1,0.1,0.0,0.01,0.0))));
+    chainall.addSegment(Segment(Joint("b", Vector(0.0,0.1,0.0), Vector(-0.2,0.6,0.3), Joint::TransAxis, 0.5, 0.1, 0.0),
+                                Frame(Vector(0.1,0.1,0.2)),
+                                RigidBodyInertia(0.8, Vector(0.02,0.0,0.05), RotationalInertia(0.05,0.05,0.05,0.0,0.0,0.0))));
+
+    // the derivatives have to match the ones of RNEVel, one direction at a time
+    Chain* chains[] = {&chainall, &chaindyn, &motomansia10dyn, &kukaLWR};
+    for (unsigned int c=0; c<4; c++)
+    {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        unsigned int ns = chain.getNrOfSegments();
+        ChainIdSolver_RNE_Derivatives idsolver(chain, gravity);
+        ChainIdSolver_RNE rne(chain, gravity);
+
+        JntArray q(nj), qd(nj), qdd(nj), torques(nj), torques_rne(nj);
+        for (unsigned int i=0; i<nj; i++)
+        {
+            random(q(i));
+            random(qd(i));
+            random(qdd(i));
+        }
+        Wrenches f_ext(ns);
+        for (unsigned int i=0; i<ns; i++)
+            f_ext[i] = Wrench(Vector(0.1*i,-0.2,0.3), Vector(0.0,0.05*i,-0.1));
+
+        Eigen::MatrixXd dtau_dq(nj,nj), dtau_dqd(nj,nj), dtau_dqdd(nj,nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qd, qdd, f_ext, torques, dtau_dq, dtau_dqd, dtau_dqdd));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, rne.CartToJnt(q, qd, qdd, f_ext, torques_rne));
+        for (unsigned int i=0; i<nj; i++)
+            CPPUNIT_ASSERT(Equal(torques(i), torques_rne(i), eps));
+
+        std::vector<doubleVel> q_vel(nj), qd_vel(nj), qdd_vel(nj), torques_vel(nj);
+        for (unsigned int k=0; k<nj; k++)
+        {
+            for (unsigned int d=0; d<3; d++)
+            {
+                for (unsigned int i=0; i<nj; i++)
+                {
+                    q_vel[i] = doubleVel(q(i), d==0 && i==k ? 1.0 : 0.0);
+                    qd_vel[i] = doubleVel(qd(i), d==1 && i==k ? 1.0 : 0.0);
+                    qdd_vel[i] = doubleVel(qdd(i), d==2 && i==k ? 1.0 : 0.0);
+                }
+                RNEVel(chain, gravity, q_vel, qd_vel, qdd_vel, f_ext, torques_vel);
+                const Eigen::MatrixXd& dtau = d==0 ? dtau_dq : (d==1 ? dtau_dqd : dtau_dqdd);
+                for (unsigned int i=0; i<nj; i++)
+                {
+                    CPPUNIT_ASSERT(Equal(torques_vel[i].t, torques(i), eps));
+                    CPPUNIT_ASSERT(Equal(torques_vel[i].grad, dtau(i,k), eps));
+                }
+            }
+        }
+
+        // the single output call is the plain RNE
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qd, qdd, f_ext, torques));
+        for (unsigned int i=0; i<nj; i++)
+            CPPUNIT_ASSERT(Equal(torques(i), torques_rne(i), eps));
+
+        Eigen::MatrixXd dtau_wrong(nj+1,nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, idsolver.CartToJnt(q, qd, qdd, f_ext, torques, dtau_wrong, dtau_dqd, dtau_dqdd));
+    }
+}
+
+void SolverTest::RallNFkDerivativesTest()
+{
+    std::cout<<"KDL RallN FK Derivatives Test"<<std::endl;
+    double eps=1.e-9;
+    const int N = 7;
+
+    // all joint types, with scale, offset and a fixed segment
+    Chain chainall;
+    chainall.addSegment(Segment(Joint(Joint::RotZ, 2.0, 0.3), Frame(Rotation::RPY(0.1,0.2,0.3), Vector(0.1,0.0,0.4))));
+    chainall.addSegment(Segment(Joint(Joint::TransX), Frame(Vector(0.0,0.2,0.1))));
+    chainall.addSegment(Segment(Joint(Joint::None), Frame(Rotation::RotY(0.5), Vector(0.1,0.0,0.0))));
+    chainall.addSegment(Segment(Joint("a", Vector(0.1,0.0,0.2), Vector(0.3,-0.4,0.5), Joint::RotAxis, 1.0, -0.2),
+                                Frame(Rotation::RotX(0.3), Vector(0.0,0.1,0.3))));
+    chainall.addSegment(Segment(Joint("b", Vector(0.0,0.1,0.0), Vector(-0.2,0.6,0.3), Joint::TransAxis, 0.5, 0.1),
+                                Frame(Vector(0.1,0.1,0.2))));
+
+    // chains with less joints than lanes leave the last lanes at zero
+    Chain* chains[] = {&chainall, &chain2, &motomansia10, &kukaLWR};
+    for (unsigned int c=0; c<4; c++)
+    {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        CPPUNIT_ASSERT(nj <= (unsigned int)N);
+        ChainFkSolverPos_recursive fksolver(chain);
+        ChainJntToJacSolver jacsolver(chain);
+        ChainJntToJacDotSolver jacdotsolver(chain);
+
+        JntArrayVel q(nj);
+        for (unsigned int i=0; i<nj; i++)
+        {
+            random(q.q(i));
+            random(q.qdot(i));
+        }
+        Frame F;
+        Jacobian jac(nj), jacdot(nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver.JntToCart(q.q, F));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.JntToJac(q.q, jac));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacdotsolver.JntToJacDot(q, jacdot));
+
+        // one pass gives the pose and the full jacobian
+        ChainJntToJacHessSolver_RallN<N> jachesssolver(chain);
+        Frame F_rall;
+        Jacobian jac_rall(nj), jac_rall2(nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jachesssolver.JntToJac(q.q, jac_rall, F_rall));
+        CPPUNIT_ASSERT(Equal(F, F_rall, eps));
+        CPPUNIT_ASSERT(Equal(jac, jac_rall, eps));
+        std::vector<RallN<N> > q_rall(nj);
+        for (unsigned int i=0; i<nj; i++)
+            q_rall[i] = RallNVariable<N>(q.q(i), i);
+        RallN<N> R[3][3], p[3];
+        ChainFkRall(chain, q_rall, R, p);
+        for (unsigned int k=nj; k<(unsigned int)N; k++)
+            CPPUNIT_ASSERT_EQUAL(0.0, p[0].grad[k]);
+
+        // one pass with second order derivatives gives the hessian, the
+        // jacobian derivative is the hessian times q_dot
+        std::vector<Jacobian> hess(nj, Jacobian(nj));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jachesssolver.JntToHess(q.q, jac_rall2, hess));
+        CPPUNIT_ASSERT(Equal(jac, jac_rall2, eps));
+        Jacobian jacdot_rall(nj);
+        SetToZero(jacdot_rall);
+        for (unsigned int l=0; l<nj; l++)
+        {
+            jacdot_rall.data += hess[l].data*q.qdot(l);
+            for (unsigned int k=0; k<nj; k++)
+                for (unsigned int a=0; a<3; a++)
+                    CPPUNIT_ASSERT(Equal(hess[l](a,k), hess[k](a,l), eps));
+        }
+        CPPUNIT_ASSERT(Equal(jacdot, jacdot_rall, eps));
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, jachesssolver.JntToJac(JntArray(nj+1), jac_rall, F_rall));
+        hess.pop_back();
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, jachesssolver.JntToHess(q.q, jac_rall2, hess));
+    }
+}
+
+void SolverTest::IdSolverRNEBatchTest()
+{
+    std::cout << "KDL batch RNE solver test" << std::endl;
+    Chain chain = kukaLWR;
+    Vector gravity(0.0, 0.0, -9.81);
+    const unsigned int nj = chain.getNrOfJoints();
+    const unsigned int ns = chain.getNrOfSegments();
+
+    // a number of samples that is not a multiple of the chunk size
+    const unsigned int nr_of_samples = 10 * ChainIdSolver_RNE_batch::CHUNK + 17;
+    Eigen::MatrixXd q(nr_of_samples, nj), qd(nr_of_samples, nj), qdd(nr_of_samples, nj);
+    std::vector<Wrenches> f_ext(nr_of_samples, Wrenches(ns));
+    for (unsigned int k = 0; k < nr_of_samples; k++) {
+        const double t = 0.01 * k;
+        for (unsigned int j = 0; j < nj; j++) {
+            q(k, j) = sin(0.7 * t + j);
+            qd(k, j) = 0.7 * cos(0.7 * t + j);
+            qdd(k, j) = -0.49 * sin(0.7 * t + j);
+        }
+        for (unsigned int i = 0; i < ns; i++)
+            f_ext[k][i] = Wrench(Vector(0.1 * i, -0.2 * t, 0.3), Vector(0.0, 0.05 * i, -0.1 * t));
+    }
+
+    // serial reference
+    ChainIdSolver_RNE idsolver(chain, gravity);
+    Eigen::MatrixXd tau_ref(nr_of_samples, nj), tau_ref_no_f(nr_of_samples, nj);
+    JntArray q_k(nj), qd_k(nj), qdd_k(nj), tau_k(nj);
+    Wrenches f_zero(ns, Wrench::Zero());
+    for (unsigned int k = 0; k < nr_of_samples; k++) {
+        q_k.data = q.row(k).transpose();
+        qd_k.data = qd.row(k).transpose();
+        qdd_k.data = qdd.row(k).transpose();
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q_k, qd_k, qdd_k, f_ext[k], tau_k));
+        tau_ref.row(k) = tau_k.data.transpose();
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q_k, qd_k, qdd_k, f_zero, tau_k));
+        tau_ref_no_f.row(k) = tau_k.data.transpose();
+    }
+    Eigen::VectorXd peak_ref(nj), rms_ref(nj);
+    for (unsigned int j = 0; j < nj; j++) {
+        peak_ref(j) = 0.0;
+        rms_ref(j) = 0.0;
+        for (unsigned int k = 0; k < nr_of_samples; k++) {
+            peak_ref(j) = std::max(peak_ref(j), std::fabs(tau_ref(k, j)));
+            rms_ref(j) += tau_ref(k, j) * tau_ref(k, j);
+        }
+        rms_ref(j) = std::sqrt(rms_ref(j) / nr_of_samples);
+    }
+
+    // the same results with any number of threads
+    unsigned int threads[] = {1, 4};
+    for (unsigned int t = 0; t < 2; t++) {
+        ChainIdSolver_RNE_batch batchsolver(chain, gravity, threads[t]);
+        CPPUNIT_ASSERT_EQUAL(threads[t], batchsolver.getNrOfThreads());
+        Eigen::MatrixXd tau;
+        for (unsigned int repeat = 0; repeat < 2; repeat++) {
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, batchsolver.CartToJnt(q, qd, qdd, f_ext, tau));
+            CPPUNIT_ASSERT(tau == tau_ref);
+            for (unsigned int j = 0; j < nj; j++) {
+                CPPUNIT_ASSERT_EQUAL(peak_ref(j), batchsolver.getPeakTorques()(j));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(rms_ref(j), batchsolver.getRmsTorques()(j), 1e-12);
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, batchsolver.CartToJnt(q, qd, qdd, tau));
+        CPPUNIT_ASSERT(tau == tau_ref_no_f);
+
+        // size errors
+        Eigen::MatrixXd q_wrong(nr_of_samples, nj + 1), qd_short(nr_of_samples - 1, nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, batchsolver.CartToJnt(q_wrong, qd, qdd, tau));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, batchsolver.CartToJnt(q, qd_short, qdd, tau));
+        std::vector<Wrenches> f_short(nr_of_samples - 1, Wrenches(ns));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, batchsolver.CartToJnt(q, qd, qdd, f_short, tau));
+        std::vector<Wrenches> f_wrong(f_ext);
+        f_wrong[nr_of_samples / 2].resize(ns + 1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, batchsolver.CartToJnt(q, qd, qdd, f_wrong, tau));
+
+        // no samples
+        Eigen::MatrixXd q_empty(0, nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, batchsolver.CartToJnt(q_empty, q_empty, q_empty, tau));
+        CPPUNIT_ASSERT_EQUAL(0, (int)tau.rows());
+        CPPUNIT_ASSERT_EQUAL(0.0, batchsolver.getPeakTorques().norm());
+    }
+}
+
+void SolverTest::SolverCloneAndPoolTest()
+{
+    std::cout << "KDL solver clone and pool test" << std::endl;
+    Chain chain = kukaLWR;
+    const unsigned int nj = chain.getNrOfJoints();
+    Vector gravity(0.0, 0.0, -9.81);
+    JntArray q(nj), qd(nj), qdd(nj);
+    for (unsigned int j = 0; j < nj; j++) {
+        q(j) = 0.3 * j - 0.5;
+        qd(j) = 0.1 * j;
+        qdd(j) = -0.2 * j;
+    }
+
+    // a clone gives the same results and has its own state
+    ChainJntToJacSolver jacsolver(chain);
+    SolverI* base = &jacsolver;
+    ChainJntToJacSolver* jacclone = dynamic_cast<ChainJntToJacSolver*>(base->clone());
+    CPPUNIT_ASSERT(jacclone != 0);
+    Jacobian jac(nj), jac_clone(nj);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.JntToJac(q, jac));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacclone->JntToJac(q, jac_clone));
+    CPPUNIT_ASSERT(jac.data == jac_clone.data);
+    std::vector<bool> locked(nj, false);
+    locked[0] = true;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacclone->setLockedJoints(locked));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacclone->JntToJac(q, jac_clone));
+    CPPUNIT_ASSERT(jac.data != jac_clone.data);
+    Jacobian jac_again(nj);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.JntToJac(q, jac_again));
+    CPPUNIT_ASSERT(jac.data == jac_again.data);
+    Jacobian jac_wrong(nj + 1);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, jacclone->JntToJac(q, jac_wrong));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, jacclone->getError());
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.getError());
+    delete jacclone;
+
+    ChainDynParam dynparam(chain, gravity);
+    ChainDynParam* dynclone = dynparam.clone();
+    JntSpaceInertiaMatrix H(nj), H_clone(nj);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToMass(q, H));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynclone->JntToMass(q, H_clone));
+    CPPUNIT_ASSERT(H.data == H_clone.data);
+    delete dynclone;
+
+    ChainIkSolverPos_LMA lma(chain);
+    ChainIkSolverPos_LMA* lmaclone = lma.clone();
+    Frame p_in;
+    ChainFkSolverPos_recursive(chain).JntToCart(q, p_in);
+    JntArray q_init(nj), q_sol(nj), q_sol_clone(nj);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, lma.CartToJnt(q_init, p_in, q_sol));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, lmaclone->CartToJnt(q_init, p_in, q_sol_clone));
+    CPPUNIT_ASSERT(q_sol.data == q_sol_clone.data);
+    delete lmaclone;
+
+    // solvers referring to other solvers can not be cloned
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainIkSolverVel_pinv iksolvervel(chain);
+    ChainIkSolverPos_NR iksolverpos(chain, fksolver, iksolvervel);
+    base = &iksolverpos;
+    CPPUNIT_ASSERT(base->clone() == 0);
+
+    // check out and in
+    {
+        SolverPool<ChainJntToJacSolver> pool(jacsolver, 2);
+        CPPUNIT_ASSERT_EQUAL(2u, pool.size());
+        ChainJntToJacSolver* first = 0;
+        {
+            SolverPool<ChainJntToJacSolver>::Handle h1 = pool.checkout();
+            SolverPool<ChainJntToJacSolver>::Handle h2 = pool.checkout();
+            CPPUNIT_ASSERT(h1.get() != h2.get());
+            first = h1.get();
+            // all busy, an extra solver
+            SolverPool<ChainJntToJacSolver>::Handle h3 = pool.checkout();
+            CPPUNIT_ASSERT(h3.get() != h1.get() && h3.get() != h2.get());
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, h3->JntToJac(q, jac_clone));
+            CPPUNIT_ASSERT(jac.data == jac_clone.data);
+            // moving keeps the solver checked out
+            SolverPool<ChainJntToJacSolver>::Handle h4(std::move(h2));
+            CPPUNIT_ASSERT(h4.get() != 0 && h2.get() == 0);
+        }
+        // the same thread gets the same solver back
+        SolverPool<ChainJntToJacSolver>::Handle h = pool.checkout();
+        CPPUNIT_ASSERT(h.get() == first);
+    }
+
+    // concurrent use
+    const unsigned int nr_of_threads = 4, nr_of_samples = 200;
+    std::vector<JntArray> q_samples(nr_of_samples, JntArray(nj));
+    std::vector<Jacobian> jac_ref(nr_of_samples, Jacobian(nj)), jac_pool(nr_of_samples, Jacobian(nj));
+    std::vector<JntArray> tau_ref(nr_of_samples, JntArray(nj)), tau_pool(nr_of_samples, JntArray(nj));
+    ChainIdSolver_RNE idsolver(chain, gravity);
+    Wrenches f_ext(chain.getNrOfSegments(), Wrench::Zero());
+    for (unsigned int k = 0; k < nr_of_samples; k++) {
+        for (unsigned int j = 0; j < nj; j++)
+            q_samples[k](j) = sin(0.1 * k + j);
+        jacsolver.JntToJac(q_samples[k], jac_ref[k]);
+        idsolver.CartToJnt(q_samples[k], qd, qdd, f_ext, tau_ref[k]);
+    }
+    SolverPool<ChainJntToJacSolver> jacpool(ChainJntToJacSolver(chain), nr_of_threads);
+    SolverPool<ChainIdSolver_RNE> idpool(idsolver, nr_of_threads);
+    std::vector<std::thread> threads;
+    std::vector<int> errors(nr_of_threads, 0);
+    for (unsigned int t = 0; t < nr_of_threads; t++)
+        threads.push_back(std::thread([&, t] {
+            for (unsigned int k = t; k < nr_of_samples; k += nr_of_threads) {
+                SolverPool<ChainJntToJacSolver>::Handle jacsolver_t = jacpool.checkout();
+                SolverPool<ChainIdSolver_RNE>::Handle idsolver_t = idpool.checkout();
+                errors[t] += jacsolver_t->JntToJac(q_samples[k], jac_pool[k]) != SolverI::E_NOERROR;
+                errors[t] += idsolver_t->CartToJnt(q_samples[k], qd, qdd, f_ext, tau_pool[k]) != SolverI::E_NOERROR;
+            }
+        }));
+    for (unsigned int t = 0; t < nr_of_threads; t++) {
+        threads[t].join();
+        CPPUNIT_ASSERT_EQUAL(0, errors[t]);
+    }
+    for (unsigned int k = 0; k < nr_of_samples; k++) {
+        CPPUNIT_ASSERT(jac_ref[k].data == jac_pool[k].data);
+        CPPUNIT_ASSERT(tau_ref[k].data == tau_pool[k].data);
+    }
+}
+
+void SolverTest::FixedChainConsistencyTest()
+{
+    std::cout<<"KDL FixedChain Solvers Consistency Test"<<std::endl;
+    double eps=1.e-9;
+    Vector gravity(0.0, 0.0, -9.81);
+
+    // Motoman SIA10 with a fixed base offset and a fixed payload in the middle and at the tip,
+    // these have to be folded into the neighbouring bodies
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::None), Frame(Rotation::RPY(0.1,0.2,0.3), Vector(0.1,0.0,0.2)),
+                             RigidBodyInertia(4.0, Vector(0.0,0.1,0.0), RotationalInertia(0.1,0.1,0.1,0.0,0.0,0.0))));
+    for (unsigned int i=0; i<motomansia10dyn.getNrOfSegments(); i++)
+    {
+        chain.addSegment(motomansia10dyn.getSegment(i));
+        if (i==2)
+            chain.addSegment(Segment(Joint(Joint::None), Frame(Rotation::RotX(0.4), Vector(0.0,0.05,0.1)),
+                                     RigidBodyInertia(1.5, Vector(0.02,0.0,0.03), RotationalInertia(0.01,0.02,0.03,0.0,0.0,0.0))));
+    }
+    chain.addSegment(Segment(Joint(Joint::None), Frame(Vector(0.0,0.0,0.1)),
+                             RigidBodyInertia(0.5, Vector(0.0,0.0,0.05), RotationalInertia(0.01,0.01,0.01,0.0,0.0,0.0))));
+
+    const unsigned int N = 7;
+    CPPUNIT_ASSERT_EQUAL(N, chain.getNrOfJoints());
+    FixedChain<N> fixedchain(chain);
+    CPPUNIT_ASSERT(fixedchain.isValid());
+    CPPUNIT_ASSERT(!FixedChain<N>(chain2).isValid());
+
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainJntToJacSolver jacsolver(chain);
+    ChainIdSolver_RNE idsolver(chain, gravity);
+    ChainDynParam dynparam(chain, gravity);
+
+    FixedChainFkSolverPos<N> fixedfksolver(fixedchain);
+    FixedChainJntToJacSolver<N> fixedjacsolver(fixedchain);
+    FixedChainIdSolver_RNE<N> fixedidsolver(fixedchain, gravity);
+    FixedChainDynParam<N> fixeddynparam(fixedchain, gravity);
+
+    JntArray q(N), qd(N), qdd(N), tau(N), coriolis(N), grav(N);
+    FixedChain<N>::JntVector q_f, qd_f, qdd_f, tau_f, coriolis_f, grav_f;
+    for (unsigned int i=0; i<N; i++)
+    {
+        random(q(i));
+        random(qd(i));
+        random(qdd(i));
+    }
+    q_f = q.data;
+    qd_f = qd.data;
+    qdd_f = qdd.data;
+
+    Frame F, F_f, F_jac_f;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver.JntToCart(q, F));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixedfksolver.JntToCart(q_f, F_f));
+    CPPUNIT_ASSERT(Equal(F, F_f, eps));
+
+    Jacobian jac(N);
+    FixedChain<N>::JacobianMatrix jac_f;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.JntToJac(q, jac));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixedjacsolver.JntToJac(q_f, jac_f, F_jac_f));
+    CPPUNIT_ASSERT(Equal(F, F_jac_f, eps));
+    CPPUNIT_ASSERT(jac.data.isApprox(jac_f, eps));
+
+    Wrenches f_ext(chain.getNrOfSegments(), Wrench::Zero());
+    FixedChainIdSolver_RNE<N>::FixedWrenches f_ext_f;
+    f_ext_f.fill(Wrench::Zero());
+    f_ext[chain.getNrOfSegments()-3] = Wrench(Vector(10,-20,30), Vector(3,-4,5));
+    f_ext_f[N-1] = f_ext[chain.getNrOfSegments()-3];
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qd, qdd, f_ext, tau));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixedidsolver.CartToJnt(q_f, qd_f, qdd_f, f_ext_f, tau_f));
+
+    JntSpaceInertiaMatrix H(N);
+    FixedChain<N>::InertiaMatrix H_f;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToDynamics(q, qd, H, coriolis, grav));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixeddynparam.JntToMass(q_f, H_f));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixeddynparam.JntToCoriolis(q_f, qd_f, coriolis_f));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixeddynparam.JntToGravity(q_f, grav_f));
+
+    for (unsigned int i=0; i<N; i++)
+    {
+        CPPUNIT_ASSERT(Equal(tau(i), tau_f(i), eps));
+        CPPUNIT_ASSERT(Equal(coriolis(i), coriolis_f(i), eps));
+        CPPUNIT_ASSERT(Equal(grav(i), grav_f(i), eps));
+        for (unsigned int j=0; j<N; j++)
+            CPPUNIT_ASSERT(Equal(H(i,j), H_f(i,j), eps));
+    }
+
+    // joints along arbitrary axes, prismatic joints, scales and offsets
+    Chain chain_axes;
+    const RigidBodyInertia body(1.0, Vector(0.1,0.0,0.05), RotationalInertia(0.02,0.03,0.04,0.001,0.0,0.002));
+    chain_axes.addSegment(Segment(Joint(Vector(0.1,0.2,0.0), Vector(1.0,1.0,0.5), Joint::RotAxis, 1.5, 0.2, 0.1),
+                                  Frame(Rotation::RPY(0.3,-0.2,0.1), Vector(0.0,0.1,0.3)), body));
+    chain_axes.addSegment(Segment(Joint(Vector(0.0,0.0,0.1), Vector(0.0,-1.0,0.2), Joint::TransAxis, 0.5, 0.1),
+                                  Frame(Vector(0.2,0.0,0.0)), body));
+    chain_axes.addSegment(Segment(Joint(Joint::RotX, -1.0, 0.3), Frame(Rotation::RotZ(0.5), Vector(0.0,0.0,0.2)), body));
+    chain_axes.addSegment(Segment(Joint(Joint::TransY), Frame(Vector(0.1,0.1,0.1)), body));
+
+    const unsigned int M = 4;
+    FixedChain<M> fixedchain_axes(chain_axes);
+    CPPUNIT_ASSERT(fixedchain_axes.isValid());
+    ChainFkSolverPos_recursive fksolver_axes(chain_axes);
+    ChainJntToJacSolver jacsolver_axes(chain_axes);
+    ChainDynParam dynparam_axes(chain_axes, gravity);
+    FixedChainJntToJacSolver<M> fixedjacsolver_axes(fixedchain_axes);
+    FixedChainDynParam<M> fixeddynparam_axes(fixedchain_axes, gravity);
+
+    JntArray q_axes(M), qd_axes(M), coriolis_axes(M), grav_axes(M);
+    FixedChain<M>::JntVector q_axes_f, qd_axes_f, coriolis_axes_f, grav_axes_f;
+    for (unsigned int i=0; i<M; i++)
+    {
+        random(q_axes(i));
+        random(qd_axes(i));
+    }
+    q_axes_f = q_axes.data;
+    qd_axes_f = qd_axes.data;
+
+    Jacobian jac_axes(M);
+    FixedChain<M>::JacobianMatrix jac_axes_f;
+    JntSpaceInertiaMatrix H_axes(M);
+    FixedChain<M>::InertiaMatrix H_axes_f;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver_axes.JntToCart(q_axes, F));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver_axes.JntToJac(q_axes, jac_axes));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixedjacsolver_axes.JntToJac(q_axes_f, jac_axes_f, F_f));
+    CPPUNIT_ASSERT(Equal(F, F_f, eps));
+    CPPUNIT_ASSERT(jac_axes.data.isApprox(jac_axes_f, eps));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam_axes.JntToDynamics(q_axes, qd_axes, H_axes, coriolis_axes, grav_axes));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixeddynparam_axes.JntToMass(q_axes_f, H_axes_f));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixeddynparam_axes.JntToCoriolis(q_axes_f, qd_axes_f, coriolis_axes_f));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fixeddynparam_axes.JntToGravity(q_axes_f, grav_axes_f));
+    CPPUNIT_ASSERT(H_axes.data.isApprox(H_axes_f, eps));
+    for (unsigned int i=0; i<M; i++)
+    {
+        CPPUNIT_ASSERT(Equal(coriolis_axes(i), coriolis_axes_f(i), eps));
+        CPPUNIT_ASSERT(Equal(grav_axes(i), grav_axes_f(i), eps));
+    }
+}
+
+void SolverTest::FdABAConsistencyTest()
+{
+    std::cout<<"KDL FD ABA Solver Consistency Test"<<std::endl;
+    double eps=1.e-9;
+    Vector gravity(0.0, 0.0, -9.81);
+
+    // The articulated body algorithm has to agree with the inertia-matrix based solver
+    Chain* chains[] = {&chaindyn, &motomansia10dyn, &kukaLWR};
+    for (unsigned int c=0; c<3; c++)
+    {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        unsigned int ns = chain.getNrOfSegments();
+        ChainFdSolver_ABA abasolver(chain, gravity);
+        ChainFdSolver_RNE fdsolver(chain, gravity);
+        ChainIdSolver_RNE idsolver(chain, gravity);
+
+        JntArray q(nj), qd(nj), tau(nj), qdd(nj), qdd_aba(nj), tau_id(nj);
+        for (unsigned int i=0; i<nj; i++)
+        {
+            random(q(i));
+            random(qd(i));
+            random(tau(i));
+        }
+        Wrenches f_ext(ns, Wrench::Zero());
+        f_ext[ns-1] = Wrench(Vector(10,-20,30), Vector(3,-4,5));
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, abasolver.CartToJnt(q, qd, tau, f_ext, qdd_aba));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fdsolver.CartToJnt(q, qd, tau, f_ext, qdd));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qd, qdd_aba, f_ext, tau_id));
+        for (unsigned int i=0; i<nj; i++)
+        {
+            CPPUNIT_ASSERT(Equal(qdd(i), qdd_aba(i), 1e-6));
+            CPPUNIT_ASSERT(Equal(tau(i), tau_id(i), eps));
+        }
+
+        Wrenches f_ext_wrong(ns+1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, abasolver.CartToJnt(q, qd, tau, f_ext_wrong, qdd_aba));
+    }
+}
+
+void SolverTest::FkPosBatchTest()
+{
+    std::cout << "KDL FK batch solver test" << std::endl;
+    // Compare the batch solver against the recursive one, 37 configurations
+    // so that the last block is only partially filled
+    const unsigned int nr_of_configs = 37;
+    Chain mixed;
+    mixed.addSegment(Segment(Joint(Joint::TransZ, 0.5, 0.1), Frame(Rotation::RPY(0.1, 0.2, 0.3), Vector(0.0, 0.0, 0.3))));
+    mixed.addSegment(Segment(Joint(Joint::RotY, 2.0, -0.4), Frame(Vector(0.0, 0.1, 0.4))));
+    mixed.addSegment(Segment(Joint(Vector(0.1, 0.2, 0.3), Vector(1.0, -2.0, 3.0), Joint::TransAxis, -1.0, 0.2),
+                             Frame(Rotation::RotX(0.3), Vector(0.0, 0.2, 0.1))));
+    mixed.addSegment(Segment(Joint(Joint::TransX), Frame(Vector(0.1, 0.0, 0.0))));
+    mixed.addSegment(Segment(Joint(Vector(0.3, 0.0, 0.1), Vector(0.0, 1.0, 1.0), Joint::RotAxis, 1.0, 0.5),
+                             Frame(Vector(0.0, 0.0, 0.2))));
+    Chain* chains[] = {&chain1, &chain2, &chain3, &chain4, &motomansia10, &kukaLWR, &mixed};
+    for (unsigned int c = 0; c < sizeof(chains) / sizeof(chains[0]); c++) {
+        Chain& chain = *chains[c];
+        const unsigned int nj = chain.getNrOfJoints();
+        ChainFkSolverPos_batch fksolver_batch(chain);
+        ChainFkSolverPos_recursive fksolver(chain);
+
+        Eigen::MatrixXd q_soa(nr_of_configs, nj);
+        std::vector<JntArray> q_aos(nr_of_configs, JntArray(nj));
+        for (unsigned int k = 0; k < nr_of_configs; k++)
+            for (unsigned int j = 0; j < nj; j++) {
+                random(q_aos[k](j));
+                q_aos[k](j) *= 10.0;
+                q_soa(k, j) = q_aos[k](j);
+            }
+        // angles outside the range of the polynomial sine/cosine
+        q_soa(3, 0) = q_aos[3](0) = 2.0e9;
+        q_soa(36, nj - 1) = q_aos[36](nj - 1) = -3.0e8;
+
+        std::vector<Frame> f_soa, f_aos;
+        Frame f_out;
+        for (int seg_nr = -1; seg_nr <= (int)chain.getNrOfSegments(); seg_nr++) {
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver_batch.JntToCart(q_soa, f_soa, seg_nr));
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver_batch.JntToCart(q_aos, f_aos, seg_nr));
+            CPPUNIT_ASSERT_EQUAL((size_t)nr_of_configs, f_soa.size());
+            for (unsigned int k = 0; k < nr_of_configs; k++) {
+                fksolver.JntToCart(q_aos[k], f_out, seg_nr);
+                CPPUNIT_ASSERT(Equal(f_soa[k], f_out, 1e-10));
+                CPPUNIT_ASSERT(Equal(f_aos[k], f_out, 1e-10));
+            }
+        }
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_OUT_OF_RANGE, fksolver_batch.JntToCart(q_soa, f_soa, chain.getNrOfSegments() + 1));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, fksolver_batch.JntToCart(Eigen::MatrixXd(nr_of_configs, nj + 1), f_soa));
+    }
+
+    // sine and cosine of the lanes against the standard library
+    double x[ChainFkSolverPos_batch::LANES], s[ChainFkSolverPos_batch::LANES], c[ChainFkSolverPos_batch::LANES];
+    for (unsigned int i = 0; i < 1000; i++) {
+        for (unsigned int l = 0; l < ChainFkSolverPos_batch::LANES; l++) {
+            random(x[l]);
+            x[l] *= (i % 10 + 1) * 100.0;
+        }
+        ChainFkSolverPos_batch::sinCos(x, s, c);
+        for (unsigned int l = 0; l < ChainFkSolverPos_batch::LANES; l++) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sin(x[l]), s[l], 1e-15);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(std::cos(x[l]), c[l], 1e-15);
+        }
+    }
+}
+
+void SolverTest::FkPosIncrementalTest()
+{
+    std::cout << "KDL incremental FK and Jacobian solvers test" << std::endl;
+    // chain1 has fixed segments in between and at the tip
+    Chain chain = chain1;
+    const unsigned int nj = chain.getNrOfJoints();
+    const unsigned int ns = chain.getNrOfSegments();
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainJntToJacSolver jacsolver(chain);
+    ChainFkSolverPos_incremental fksolver_inc(chain);
+    ChainJntToJacSolver_incremental jacsolver_inc(chain);
+    ChainIkSolverPos_LMA lma(chain);
+
+    JntArray q(nj);
+    Frame f, f_inc;
+    std::vector<Frame> v(ns), v_inc(ns);
+    Jacobian jac(nj), jac_inc(nj);
+    Eigen::VectorXd q_lma(nj);
+    for (unsigned int j = 0; j < nj; j++)
+        random(q(j));
+
+    for (unsigned int i = 0; i < 100; i++) {
+        // change all joints from a random one onward, sometimes none
+        const unsigned int first = i % (nj + 1);
+        for (unsigned int j = first; j < nj; j++)
+            random(q(j));
+        const int seg_nr = (i % 7 == 0) ? (int)(i % ns) : -1;
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver_inc.JntToCart(q, f_inc, seg_nr));
+        fksolver.JntToCart(q, f, seg_nr);
+        CPPUNIT_ASSERT(Equal(f, f_inc, 1e-12));
+        if (i > 0 && seg_nr < 0)
+            CPPUNIT_ASSERT(fksolver_inc.getNrOfRecomputedSegments() < ns || first == 0);
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver_inc.JntToCart(q, v_inc));
+        fksolver.JntToCart(q, v);
+        for (unsigned int s = 0; s < ns; s++)
+            CPPUNIT_ASSERT(Equal(v[s], v_inc[s], 1e-12));
+        // nothing changed since the previous call
+        fksolver_inc.JntToCart(q, f_inc);
+        CPPUNIT_ASSERT_EQUAL(0u, fksolver_inc.getNrOfRecomputedSegments());
+
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver_inc.JntToJac(q, jac_inc, seg_nr));
+        jacsolver.JntToJac(q, jac, seg_nr);
+        CPPUNIT_ASSERT(Equal(jac, jac_inc, 1e-12));
+
+        q_lma = q.data;
+        lma.compute_fwdpos(q_lma);
+        lma.compute_jacobian(q_lma);
+        fksolver.JntToCart(q, f);
+        jacsolver.JntToJac(q, jac);
+        CPPUNIT_ASSERT(Equal(f, lma.T_base_head, 1e-12));
+        CPPUNIT_ASSERT(jac.data.isApprox(lma.jac, 1e-12));
+    }
+
+    // only the last joint changes: only the segments from its one are recomputed
+    q(nj - 1) += 0.1;
+    fksolver_inc.JntToCart(q, f_inc);
+    CPPUNIT_ASSERT_EQUAL(2u, fksolver_inc.getNrOfRecomputedSegments());
+
+    // modified segments are only picked up after an invalidation
+    chain.addSegment(Segment(Joint(Joint::None), Frame(Vector(0.0, 0.0, 0.1))));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOT_UP_TO_DATE, fksolver_inc.JntToCart(q, f_inc));
+    fksolver.updateInternalDataStructures();
+    fksolver_inc.updateInternalDataStructures();
+    jacsolver_inc.updateInternalDataStructures();
+    jacsolver.updateInternalDataStructures();
+    fksolver_inc.JntToCart(q, f_inc);
+    fksolver.JntToCart(q, f);
+    CPPUNIT_ASSERT(Equal(f, f_inc, 1e-12));
+    CPPUNIT_ASSERT_EQUAL(ns + 1, fksolver_inc.getNrOfRecomputedSegments());
+    jacsolver_inc.invalidate();
+    jacsolver_inc.JntToJac(q, jac_inc);
+    jacsolver.JntToJac(q, jac);
+    CPPUNIT_ASSERT(Equal(jac, jac_inc, 1e-12));
+}
+
+void SolverTest::IkPosMultiStartTest()
+{
+    std::cout << "KDL multi-start IK solver test" << std::endl;
+    Chain chain = motomansia10;
+    const unsigned int nj = chain.getNrOfJoints();
+    ChainFkSolverPos_recursive fksolver(chain);
+    JntArray q_min(nj), q_max(nj), q(nj), q_init(nj), q_sol(nj), q_wrong(nj + 1);
+    for (unsigned int j = 0; j < nj; j++) {
+        q_min(j) = -2.9;
+        q_max(j) = 2.9;
+    }
+
+    ChainIkSolverPos_MultiStart::SolverType types[] = {ChainIkSolverPos_MultiStart::NR_JL, ChainIkSolverPos_MultiStart::LMA};
+    for (unsigned int t = 0; t < 2; t++) {
+        ChainIkSolverPos_MultiStart iksolver(chain, q_min, q_max, types[t], 4, 32, 500, 1e-6);
+        iksolver.setRandomSeed(42);
+        CPPUNIT_ASSERT_EQUAL(4u, iksolver.getNrOfThreads());
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, iksolver.CartToJnt(q_wrong, Frame::Identity(), q_sol));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, iksolver.addSeed(q_wrong));
+
+        Frame p_in, p_sol;
+        for (unsigned int i = 0; i < 10; i++) {
+            // reachable goal, starting far away from the joints that reach it
+            for (unsigned int j = 0; j < nj; j++) {
+                q(j) = 1.5 * sin(3.7 * i + 1.3 * j + t);
+                q_init(j) = -q(j);
+            }
+            fksolver.JntToCart(q, p_in);
+            iksolver.setStopAtFirstSolution(i % 2 == 0);
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(q_init, p_in, q_sol));
+            fksolver.JntToCart(q_sol, p_sol);
+            CPPUNIT_ASSERT(Equal(p_in, p_sol, 1e-4));
+            for (unsigned int j = 0; j < nj; j++)
+                CPPUNIT_ASSERT(q_sol(j) >= q_min(j) && q_sol(j) <= q_max(j));
+            CPPUNIT_ASSERT(iksolver.getNrOfSolutions() >= 1);
+            CPPUNIT_ASSERT(iksolver.getNrOfSolutions() <= iksolver.getNrOfStartedSeeds());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL((q_sol.data - q_init.data).squaredNorm(), iksolver.getBestCost(), 1e-12);
+            if (i % 2 == 1)
+                CPPUNIT_ASSERT_EQUAL(33u, iksolver.getNrOfStartedSeeds());
+        }
+
+        // an added seed at the solution converges at once and wins the cost
+        iksolver.setStopAtFirstSolution(false);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.addSeed(q));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(q, p_in, q_sol));
+        CPPUNIT_ASSERT(iksolver.getBestSeed() == 0 || iksolver.getBestSeed() == 1);
+        CPPUNIT_ASSERT(Equal(q, q_sol, 1e-5));
+        iksolver.clearSeeds();
+
+        // a custom cost selects among all solutions
+        iksolver.setCostFunction([](const JntArray& q_s, const JntArray&) { return -q_s(0); });
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(q_init, p_in, q_sol));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(-q_sol(0), iksolver.getBestCost(), 1e-12);
+
+        // unreachable goal, all seeds are tried unless the time budget runs out
+        p_in = Frame(Vector(10.0, 0.0, 0.0));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NO_CONVERGE, iksolver.CartToJnt(q_init, p_in, q_sol));
+        CPPUNIT_ASSERT_EQUAL(33u, iksolver.getNrOfStartedSeeds());
+        CPPUNIT_ASSERT_EQUAL(-1, iksolver.getBestSeed());
+        CPPUNIT_ASSERT_EQUAL(q_init, q_sol);
+        iksolver.setTimeBudget(1e-9);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NO_CONVERGE, iksolver.CartToJnt(q_init, p_in, q_sol));
+        CPPUNIT_ASSERT(iksolver.getNrOfStartedSeeds() < 33u);
+    }
+
+    // a single threaded solver stops after the first seed if it converges
+    ChainIkSolverPos_MultiStart iksolver(chain, q_min, q_max, ChainIkSolverPos_MultiStart::NR_JL, 1);
+    Frame p_in;
+    fksolver.JntToCart(q, p_in);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(q, p_in, q_sol));
+    CPPUNIT_ASSERT_EQUAL(1u, iksolver.getNrOfStartedSeeds());
+    CPPUNIT_ASSERT_EQUAL(0, iksolver.getBestSeed());
+}
+
+void SolverTest::IkSeedCacheTest()
+{
+    std::cout << "KDL IK seed cache test" << std::endl;
+    Chain chain = motomansia10;
+    const unsigned int nj = chain.getNrOfJoints();
+    ChainFkSolverPos_recursive fksolver(chain);
+    JntArray q(nj), q_seed(nj), q_sol(nj), q_wrong(nj + 1);
+    Frame p;
+    double d;
+
+    ChainIkSeedCache cache(nj, 0.05, 0.1, 0.1, 50);
+    CPPUNIT_ASSERT(!cache.insert(p, q_wrong));
+    CPPUNIT_ASSERT(!cache.nearest(p, q_seed));
+    std::vector<Frame> poses;
+    std::vector<JntArray> solutions;
+    for (unsigned int i = 0; i < 80; i++) {
+        for (unsigned int j = 0; j < nj; j++)
+            q(j) = 1.5 * sin(2.1 * i + 0.7 * j);
+        fksolver.JntToCart(q, p);
+        poses.push_back(p);
+        solutions.push_back(q);
+        CPPUNIT_ASSERT(cache.insert(p, q));
+    }
+    // only the newest 50 are kept
+    CPPUNIT_ASSERT_EQUAL(50u, cache.size());
+    for (unsigned int i = 30; i < 80; i++) {
+        CPPUNIT_ASSERT(cache.nearest(poses[i], q_seed, d));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, d, 1e-12);
+        CPPUNIT_ASSERT_EQUAL(solutions[i], q_seed);
+    }
+    // a slightly displaced pose finds the nearest entry, like a brute force search
+    for (unsigned int i = 0; i < 80; i++) {
+        p = poses[i] * Frame(Rotation::RotX(0.05), Vector(0.01, -0.02, 0.015));
+        double d_min = 1e10;
+        for (unsigned int n = 30; n < 80; n++)
+            d_min = std::min(d_min, cache.distance(p, poses[n]));
+        if (d_min <= cache.getMaxDistance()) {
+            CPPUNIT_ASSERT(cache.nearest(p, q_seed, d));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(d_min, d, 1e-12);
+        } else
+            CPPUNIT_ASSERT(!cache.nearest(p, q_seed));
+    }
+    CPPUNIT_ASSERT(!cache.nearest(Frame(Vector(10.0, 0.0, 0.0)), q_seed));
+    CPPUNIT_ASSERT_EQUAL(1u + 50u + 80u + 1u, cache.getNrOfQueries());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(double(cache.getNrOfHits()) / cache.getNrOfQueries(), cache.getHitRate(), 1e-15);
+    cache.resetStatistics();
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.getHitRate());
+
+    // binary round trip, a smaller cache keeps the newest entries
+    const std::string filename = "ikseedcache-test.bin";
+    CPPUNIT_ASSERT(cache.save(filename));
+    ChainIkSeedCache loaded(nj, 0.05, 0.1, 0.1, 20), wrong(nj + 1);
+    CPPUNIT_ASSERT(!wrong.load(filename));
+    CPPUNIT_ASSERT(!loaded.load("no-such-file.bin"));
+    CPPUNIT_ASSERT(loaded.load(filename));
+    CPPUNIT_ASSERT_EQUAL(20u, loaded.size());
+
+    // a count that does not match the size of the file is rejected
+    // before anything is allocated, the loaded entries are kept
+    {
+        std::fstream file(filename.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+        const unsigned int huge_count = 4000000000u;
+        file.seekp(8 + sizeof(unsigned int));
+        file.write(reinterpret_cast<const char*>(&huge_count), sizeof(huge_count));
+    }
+    CPPUNIT_ASSERT(!loaded.load(filename));
+    std::remove(filename.c_str());
+    CPPUNIT_ASSERT_EQUAL(20u, loaded.size());
+    for (unsigned int i = 60; i < 80; i++) {
+        CPPUNIT_ASSERT(loaded.nearest(poses[i], q_seed, d));
+        CPPUNIT_ASSERT_EQUAL(solutions[i], q_seed);
+    }
+
+    // seeding NR_JL from the cache
+    JntArray q_min(nj), q_max(nj);
+    for (unsigned int j = 0; j < nj; j++) {
+        q_min(j) = -2.9;
+        q_max(j) = 2.9;
+    }
+    ChainIkSolverVel_pinv ikvelsolver(chain);
+    ChainIkSolverPos_NR_JL nrjl(chain, q_min, q_max, fksolver, ikvelsolver, 100, 1e-6);
+    ChainIkSeedCache seeds(nj);
+    ChainIkSolverPos_cached iksolver(nrjl, seeds);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, iksolver.CartToJnt(q_wrong, p, q_sol));
+    JntArray q_init(nj);
+    fksolver.JntToCart(solutions[0], p);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(solutions[0], p, q_sol));
+    CPPUNIT_ASSERT(!iksolver.getUsedCachedSeed());
+    CPPUNIT_ASSERT_EQUAL(1u, seeds.size());
+    // a nearby pose from far away joints converges from the cached seed
+    p = p * Frame(Vector(0.0, 0.0, 0.02));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(q_init, p, q_sol));
+    CPPUNIT_ASSERT(iksolver.getUsedCachedSeed());
+    CPPUNIT_ASSERT_EQUAL(2u, seeds.size());
+    Frame p_sol;
+    fksolver.JntToCart(q_sol, p_sol);
+    CPPUNIT_ASSERT(Equal(p, p_sol, 1e-5));
+}
+
+void SolverTest::IkPosSRSTest()
+{
+    std::cout << "KDL SRS IK test" << std::endl;
+    // iiwa like arm, with a reversed joint, a joint offset and a rotated tip
+    Chain chain;
+    chain.addSegment(Segment(Joint(Joint::Fixed), Frame(Vector(0.0, 0.0, 0.36))));
+    chain.addSegment(Segment(Joint(Joint::RotZ)));
+    chain.addSegment(Segment(Joint(Joint::RotY)));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Vector(0.0, 0.0, 0.42))));
+    chain.addSegment(Segment(Joint(Joint::RotY, -1.0)));
+    chain.addSegment(Segment(Joint(Joint::RotZ, 1.0, 0.3), Frame(Vector(0.0, 0.0, 0.4))));
+    chain.addSegment(Segment(Joint(Joint::RotY)));
+    chain.addSegment(Segment(Joint(Joint::RotZ), Frame(Rotation::RPY(0.1, 0.2, 0.3), Vector(0.01, 0.0, 0.126))));
+    const unsigned int nj = chain.getNrOfJoints();
+    JntArray q_min(nj), q_max(nj), q(nj), q_init(nj), q_sol(nj);
+    for (unsigned int j = 0; j < nj; j++) {
+        q_min(j) = -2.9;
+        q_max(j) = 2.9;
+    }
+
+    // not an SRS chain
+    JntArray q_min1(chain1.getNrOfJoints()), q_max1(chain1.getNrOfJoints());
+    ChainIkSolverPos_SRS iksolver1(chain1, q_min1, q_max1);
+    CPPUNIT_ASSERT(!iksolver1.isSRS());
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_SRS::E_NOT_SRS, iksolver1.CartToJnt(q_min1, Frame::Identity(), q_max1));
+
+    Chain chains[2] = {chain, motomansia10};
+    for (unsigned int c = 0; c < 2; c++) {
+        ChainIkSolverPos_SRS iksolver(chains[c], q_min, q_max);
+        ChainFkSolverPos_recursive fksolver(chains[c]);
+        CPPUNIT_ASSERT(iksolver.isSRS());
+        for (unsigned int i = 0; i < 100; i++) {
+            for (unsigned int j = 0; j < nj; j++)
+                q(j) = 2.5 * sin(3.7 * i + 1.3 * j + c);
+            Frame p, p_sol;
+            fksolver.JntToCart(q, p);
+
+            // all solutions at the arm angle of q reach p, one of them is q
+            double arm_angle;
+            unsigned int config;
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.getArmAngle(q, arm_angle, config));
+            std::vector<JntArray> solutions;
+            std::vector<unsigned int> configs;
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(arm_angle, p, solutions, &configs));
+            CPPUNIT_ASSERT_EQUAL(solutions.size(), configs.size());
+            bool found = false;
+            for (unsigned int n = 0; n < solutions.size(); n++) {
+                fksolver.JntToCart(solutions[n], p_sol);
+                CPPUNIT_ASSERT(Equal(p, p_sol, 1e-9));
+                bool same = configs[n] == config;
+                for (unsigned int j = 0; j < nj; j++)
+                    same = same && std::abs(remainder(solutions[n](j) - q(j), 2 * PI)) < 1e-7;
+                found = found || same;
+            }
+            CPPUNIT_ASSERT(found);
+
+            // the sweep finds a solution within the limits
+            for (unsigned int j = 0; j < nj; j++)
+                q_init(j) = q(j) + 0.1 * sin(1.9 * i + j);
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, iksolver.CartToJnt(q_init, p, q_sol));
+            fksolver.JntToCart(q_sol, p_sol);
+            CPPUNIT_ASSERT(Equal(p, p_sol, 1e-9));
+            for (unsigned int j = 0; j < nj; j++)
+                CPPUNIT_ASSERT(q_sol(j) >= q_min(j) && q_sol(j) <= q_max(j));
+
+#ifdef __GLIBC__
+            // neither the sweep nor a reused solution vector touch the heap
+            malloc_count = 0;
+            malloc_counting = true;
+            iksolver.CartToJnt(q_init, p, q_sol);
+            iksolver.CartToJnt(arm_angle + 0.1, p, solutions, &configs);
+            malloc_counting = false;
+            CPPUNIT_ASSERT_EQUAL(0ul, (unsigned long)malloc_count);
+#endif
+        }
+        std::vector<JntArray> solutions;
+        CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_SRS::E_NO_SOLUTION,
+                             iksolver.CartToJnt(0.0, Frame(Vector(10.0, 0.0, 0.0)), solutions));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, iksolver.CartToJnt(JntArray(nj + 1), Frame::Identity(), q_sol));
+    }
+}
+
+void SolverTest::IkVelSVDJacobiTest()
+{
+    std::cout << "KDL 6xN Jacobi SVD test" << std::endl;
+    // the decomposition itself, square, wide, narrow and rank deficient
+    for (unsigned int n = 3; n <= 8; n++) {
+        Eigen::MatrixXd A = Eigen::MatrixXd::Random(6, n), U(6, n), V(n, n);
+        Eigen::VectorXd S(n);
+        if (n == 8)
+            A.row(4) = 2.0 * A.row(1) - A.row(2);
+        SVD_Jacobi_6xN svd(n);
+        CPPUNIT_ASSERT_EQUAL(0, svd.calculate(A, U, S, V));
+        CPPUNIT_ASSERT((U * S.asDiagonal() * V.transpose() - A).norm() < 1e-12);
+        const unsigned int rank = n < 6 ? n : 6;
+        for (unsigned int i = 0; i + 1 < n; i++)
+            CPPUNIT_ASSERT(S(i) >= S(i + 1));
+        const unsigned int nz = n == 8 ? rank - 1 : rank;
+        CPPUNIT_ASSERT((U.leftCols(nz).transpose() * U.leftCols(nz) - Eigen::MatrixXd::Identity(nz, nz)).norm() < 1e-12);
+        CPPUNIT_ASSERT((V.leftCols(nz).transpose() * V.leftCols(nz) - Eigen::MatrixXd::Identity(nz, nz)).norm() < 1e-12);
+        Eigen::MatrixXd U_wrong(5, n);
+        CPPUNIT_ASSERT_EQUAL(-1, svd.calculate(A, U_wrong, S, V));
+    }
+
+    // the velocity solvers give the same results with both methods,
+    // also in and near singular configurations
+    Chain chains[6] = {chain1, chain2, chain3, chain4, motomansia10, kukaLWR};
+    Twist v(Vector(0.05, -0.1, 0.02), Vector(0.1, 0.05, -0.2));
+    for (unsigned int c = 0; c < 6; c++) {
+        const unsigned int nj = chains[c].getNrOfJoints();
+        ChainIkSolverVel_pinv pinv(chains[c]), pinv_jacobi(chains[c]);
+        ChainIkSolverVel_wdls wdls(chains[c], 0.1), wdls_jacobi(chains[c], 0.1);
+        ChainIkSolverVel_pinv_nso nso(chains[c]), nso_jacobi(chains[c]);
+        pinv_jacobi.setSVDMethod(SVD_JACOBI_6XN);
+        wdls_jacobi.setSVDMethod(SVD_JACOBI_6XN);
+        nso_jacobi.setSVDMethod(SVD_JACOBI_6XN);
+        CPPUNIT_ASSERT_EQUAL(SVD_HOUSEHOLDER, pinv.getSVDMethod());
+        CPPUNIT_ASSERT_EQUAL(SVD_JACOBI_6XN, pinv_jacobi.getSVDMethod());
+        if (nj >= 6) {
+            wdls.setLambda(0.1);
+            wdls_jacobi.setLambda(0.1);
+        }
+        JntArray q(nj), qdot(nj), qdot_jacobi(nj);
+        for (unsigned int i = 0; i < 20; i++) {
+            for (unsigned int j = 0; j < nj; j++)
+                q(j) = i < 2 ? 0.0 : 1.5 * sin(2.3 * i + 0.9 * j + c);
+            if (i == 1 && nj > 3)
+                q(3) = 1e-6;
+
+            CPPUNIT_ASSERT_EQUAL(pinv.CartToJnt(q, v, qdot), pinv_jacobi.CartToJnt(q, v, qdot_jacobi));
+            CPPUNIT_ASSERT_EQUAL(pinv.getNrZeroSigmas(), pinv_jacobi.getNrZeroSigmas());
+            CPPUNIT_ASSERT(Equal(qdot, qdot_jacobi, 1e-8));
+
+            if (nj >= 6) {
+                CPPUNIT_ASSERT_EQUAL(wdls.CartToJnt(q, v, qdot), wdls_jacobi.CartToJnt(q, v, qdot_jacobi));
+                CPPUNIT_ASSERT_EQUAL(wdls.getNrZeroSigmas(), wdls_jacobi.getNrZeroSigmas());
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(wdls.getSigmaMin(), wdls_jacobi.getSigmaMin(), 1e-12);
+                CPPUNIT_ASSERT(Equal(qdot, qdot_jacobi, 1e-8));
+            }
+
+            CPPUNIT_ASSERT_EQUAL(nso.CartToJnt(q, v, qdot), nso_jacobi.CartToJnt(q, v, qdot_jacobi));
+            CPPUNIT_ASSERT(Equal(qdot, qdot_jacobi, 1e-8));
+        }
+    }
+}
+
+void SolverTest::IkVelSVDWarmStartTest()
+{
+    std::cout << "KDL warm started 6xN Jacobi SVD test" << std::endl;
+    const unsigned int nj = kukaLWR.getNrOfJoints();
+    ChainJntToJacSolver jacsolver(kukaLWR);
+    Jacobian jac(nj);
+    JntArray q(nj);
+    Eigen::MatrixXd U(6, nj), V(nj, nj), U_cold(6, nj), V_cold(nj, nj);
+    Eigen::VectorXd S(nj), S_cold(nj);
+    SVD_Jacobi_6xN svd(nj), svd_cold(nj);
+    svd.setWarmStart(true);
+    CPPUNIT_ASSERT(svd.getWarmStart());
+    CPPUNIT_ASSERT(!svd_cold.getWarmStart());
+
+    // the same matrix twice needs at most a sweep to clean up the rounding
+    // errors of the initial guess and the sweep that checks convergence
+    for (unsigned int j = 0; j < nj; j++)
+        q(j) = 0.3 * j - 0.8;
+    jacsolver.JntToJac(q, jac);
+    CPPUNIT_ASSERT_EQUAL(0, svd.calculate(jac.data, U, S, V));
+    CPPUNIT_ASSERT(svd.getNrOfSweeps() > 1);
+    CPPUNIT_ASSERT_EQUAL(0, svd.calculate(jac.data, U, S, V));
+    CPPUNIT_ASSERT(svd.getNrOfSweeps() <= 2);
+
+    // along a 1 kHz trajectory less sweeps are needed than from scratch,
+    // with the same result
+    int warm_sweeps = 0, total_cold_sweeps = 0;
+    for (unsigned int i = 0; i < 1000; i++) {
+        for (unsigned int j = 0; j < nj; j++)
+            q(j) = 0.3 * j - 0.8 + 0.5 * sin(1e-3 * i * (j + 1));
+        jacsolver.JntToJac(q, jac);
+        CPPUNIT_ASSERT_EQUAL(0, svd.calculate(jac.data, U, S, V));
+        CPPUNIT_ASSERT_EQUAL(0, svd_cold.calculate(jac.data, U_cold, S_cold, V_cold));
+        warm_sweeps += svd.getNrOfSweeps();
+        total_cold_sweeps += svd_cold.getNrOfSweeps();
+        CPPUNIT_ASSERT((S - S_cold).norm() < 1e-12);
+        CPPUNIT_ASSERT((U * S.asDiagonal() * V.transpose() - jac.data).norm() < 1e-12);
+        CPPUNIT_ASSERT((U.leftCols(6).transpose() * U.leftCols(6) - Eigen::MatrixXd::Identity(6, 6)).norm() < 1e-12);
+    }
+    CPPUNIT_ASSERT(warm_sweeps < total_cold_sweeps);
+    CPPUNIT_ASSERT_EQUAL(0u, svd.getNrOfRestarts());
+
+    // a jump is still decomposed, from scratch if needed
+    for (unsigned int j = 0; j < nj; j++)
+        q(j) = 2.0 - 0.6 * j;
+    jacsolver.JntToJac(q, jac);
+    CPPUNIT_ASSERT_EQUAL(0, svd.calculate(jac.data, U, S, V));
+    CPPUNIT_ASSERT_EQUAL(0, svd_cold.calculate(jac.data, U_cold, S_cold, V_cold));
+    CPPUNIT_ASSERT((S - S_cold).norm() < 1e-12);
+    CPPUNIT_ASSERT((U * S.asDiagonal() * V.transpose() - jac.data).norm() < 1e-12);
+    CPPUNIT_ASSERT(svd.getNrOfSweeps() <= 5 + svd_cold.getNrOfSweeps());
+
+    // the velocity solvers with warm start follow the trajectory like the householder svd
+    ChainIkSolverVel_wdls wdls(kukaLWR, 0.1), wdls_warm(kukaLWR, 0.1);
+    ChainIkSolverVel_pinv pinv(kukaLWR), pinv_warm(kukaLWR);
+    wdls_warm.setSVDMethod(SVD_JACOBI_6XN_WARM);
+    pinv_warm.setSVDMethod(SVD_JACOBI_6XN_WARM);
+    CPPUNIT_ASSERT_EQUAL(SVD_JACOBI_6XN_WARM, wdls_warm.getSVDMethod());
+    wdls.setLambda(0.1);
+    wdls_warm.setLambda(0.1);
+    Twist v(Vector(0.05, -0.1, 0.02), Vector(0.1, 0.05, -0.2));
+    JntArray qdot(nj), qdot_warm(nj);
+    for (unsigned int i = 0; i < 200; i++) {
+        for (unsigned int j = 0; j < nj; j++)
+            q(j) = 0.2 * j + 0.8 * sin(1e-2 * i * (j + 1));
+        CPPUNIT_ASSERT_EQUAL(wdls.CartToJnt(q, v, qdot), wdls_warm.CartToJnt(q, v, qdot_warm));
+        CPPUNIT_ASSERT(Equal(qdot, qdot_warm, 1e-8));
+        CPPUNIT_ASSERT_EQUAL(pinv.CartToJnt(q, v, qdot), pinv_warm.CartToJnt(q, v, qdot_warm));
+        CPPUNIT_ASSERT(Equal(qdot, qdot_warm, 1e-8));
+    }
+}
+
+void SolverTest::RealTimeAllocationTest()
+{
+#ifdef __GLIBC__
+    std::cout << "KDL real-time allocation test" << std::endl;
+    // the solvers a control loop calls every cycle, e.g. ros2_kdl_package's
+    // KDLRobot and KDLController, must not touch the heap once constructed
+    const unsigned int nj = kukaLWR.getNrOfJoints();
+    ChainDynParam dynparam(kukaLWR, Vector(0.0, 0.0, -9.81));
+    ChainFkSolverPos_recursive fksolver(kukaLWR);
+    ChainFkSolverVel_recursive fkvelsolver(kukaLWR);
+    ChainJntToJacSolver jacsolver(kukaLWR);
+    ChainJntToJacDotSolver jacdotsolver(kukaLWR);
+    ChainIdSolver_RNE idsolver(kukaLWR, Vector(0.0, 0.0, -9.81));
+    JntArray q(nj), qdot(nj), qdotdot(nj), coriolis(nj), gravity(nj), torque(nj);
+    JntArrayVel q_qdot(nj);
+    JntSpaceInertiaMatrix H(nj);
+    Wrenches f_ext(kukaLWR.getNrOfSegments(), Wrench::Zero());
+    Frame F;
+    FrameVel F_vel;
+    Jacobian jac(nj), jac_ee(nj), jac_body(nj);
+    Twist jac_dot_q_dot;
+    Eigen::VectorXd tau(nj), y(nj);
+
+    for (unsigned int i = 0; i < 10; i++) {
+        for (unsigned int j = 0; j < nj; j++) {
+            q(j) = q_qdot.q(j) = 0.1 * i - 0.2 * j;
+            qdot(j) = q_qdot.qdot(j) = 0.3 - 0.1 * j;
+        }
+
+        malloc_count = 0;
+        malloc_counting = true;
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToDynamics(q, qdot, H, coriolis, gravity));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, dynparam.JntToGravity(q, gravity));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fksolver.JntToCart(q, F));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fkvelsolver.JntToCart(q_qdot, F_vel));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacsolver.JntToJac(q, jac));
+        CPPUNIT_ASSERT(changeRefPoint(jac, Vector(0.0, 0.0, 0.1), jac_ee));
+        CPPUNIT_ASSERT(changeBase(jac_ee, F.M.Inverse(), jac_body));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, jacdotsolver.JntToJacDot(q_qdot, jac_dot_q_dot));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qdot, qdotdot, f_ext, torque));
+        y = qdot.data - q.data;
+        tau.noalias() = H.data * y;
+        tau += coriolis.data + gravity.data;
+        malloc_counting = false;
+        CPPUNIT_ASSERT_EQUAL(0ul, (unsigned long)malloc_count);
+    }
+#endif
+}
+
+void SolverTest::PathParamTOPPRATest()
+{
+    std::cout << "KDL TOPP-RA path parameterization test" << std::endl;
+    const unsigned int nj = kukaLWR.getNrOfJoints();
+    const Vector grav(0.0, 0.0, -9.81);
+    JntArray q_init(nj), q_dot_max(nj), q_dotdot_max(nj), torque_max(nj);
+    for (unsigned int j = 0; j < nj; j++) {
+        q_init(j) = 0.3 + 0.1 * j;
+        q_dot_max(j) = 1.5;
+        q_dotdot_max(j) = 5.0;
+        torque_max(j) = j < 4 ? 40.0 : 10.0;
+    }
+    q_init(3) = -1.2;
+
+    Frame F_start;
+    ChainFkSolverPos_recursive fksolver(kukaLWR);
+    fksolver.JntToCart(q_init, F_start);
+    Frame F_end(F_start.M * Rotation::RPY(0.3, -0.2, 0.4), F_start.p + Vector(0.1, -0.2, -0.15));
+    // the solver only needs a const path
+    const Path_Line path(F_start, F_end, new RotationalInterpolation_SingleAxis(), 0.1);
+
+    const unsigned int n = 200;
+    ChainPathParamSolver_TOPPRA solver(kukaLWR, q_dot_max, q_dotdot_max, torque_max, grav, n);
+    VelocityProfile_Grid profile;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, solver.Solve(path, q_init, profile));
+
+    // the profile goes from rest to rest over the whole path
+    const std::vector<double>& s = solver.getGrid();
+    CPPUNIT_ASSERT_EQUAL((size_t)n, s.size());
+    CPPUNIT_ASSERT_EQUAL(n, profile.NrOfPoints());
+    CPPUNIT_ASSERT(profile.Duration() > 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, profile.Pos(0.0), 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(path.PathLength(), profile.Pos(profile.Duration()), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, profile.Vel(0.0), 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, profile.Vel(profile.Duration()), 1e-12);
+
+    // the joints follow the path and respect the limits at every grid point
+    ChainIdSolver_RNE idsolver(kukaLWR, grav);
+    Wrenches f_ext(kukaLWR.getNrOfSegments(), Wrench::Zero());
+    JntArray qdot(nj), qdotdot(nj), torque(nj);
+    Frame F;
+    double saturation = 0.0;
+    for (unsigned int i = 0; i + 1 < n; i++) {
+        const JntArray& q = solver.getJointPath()[i];
+        fksolver.JntToCart(q, F);
+        CPPUNIT_ASSERT(Equal(path.Pos(s[i]), F, 1e-8));
+        // path velocity at the grid point, path acceleration of the interval after it
+        const double t_mid = 0.5 * (profile.Time(i) + profile.Time(i + 1));
+        const double sd = profile.Vel(profile.Time(i));
+        const double sdd = profile.Acc(t_mid);
+        qdot.data = solver.getJointPathVel()[i].data * sd;
+        qdotdot.data = solver.getJointPathVel()[i].data * sdd + solver.getJointPathAcc()[i].data * sd * sd;
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qdot, qdotdot, f_ext, torque));
+        double ratio = 0.0;
+        for (unsigned int j = 0; j < nj; j++) {
+            CPPUNIT_ASSERT(std::abs(qdot(j)) <= q_dot_max(j) * (1 + 1e-6));
+            CPPUNIT_ASSERT(std::abs(qdotdot(j)) <= q_dotdot_max(j) * (1 + 1e-6));
+            CPPUNIT_ASSERT(std::abs(torque(j)) <= torque_max(j) * (1 + 1e-6));
+            ratio = std::max(ratio, std::max(std::abs(qdot(j)) / q_dot_max(j),
+                             std::max(std::abs(qdotdot(j)) / q_dotdot_max(j), std::abs(torque(j)) / torque_max(j))));
+        }
+        saturation += ratio / (n - 1);
+    }
+    // time-optimal: on average some limit is (nearly) active
+    CPPUNIT_ASSERT(saturation > 0.95);
+
+    // a finer grid converges to the same duration
+    ChainPathParamSolver_TOPPRA solver_fine(kukaLWR, q_dot_max, q_dotdot_max, torque_max, grav, 4 * n);
+    VelocityProfile_Grid profile_fine;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, solver_fine.Solve(path, q_init, profile_fine));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(profile.Duration(), profile_fine.Duration(), 1e-2 * profile.Duration());
+
+    // limits that are left out are not enforced
+    ChainPathParamSolver_TOPPRA solver_kin(kukaLWR, q_dot_max, q_dotdot_max, JntArray(), grav, n);
+    VelocityProfile_Grid profile_kin;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, solver_kin.Solve(path, q_init, profile_kin));
+    CPPUNIT_ASSERT(profile_kin.Duration() <= profile.Duration() * (1 + 1e-9));
+
+    // a torque limit below gravity cannot be respected
+    JntArray torque_low(nj);
+    SetToZero(torque_low);
+    ChainPathParamSolver_TOPPRA solver_low(kukaLWR, q_dot_max, q_dotdot_max, torque_low, grav, n);
+    CPPUNIT_ASSERT_EQUAL((int)ChainPathParamSolver_TOPPRA::E_INFEASIBLE, solver_low.Solve(path, q_init, profile));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, solver.Solve(path, JntArray(nj - 1), profile));
+}
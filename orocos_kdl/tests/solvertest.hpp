@@ -17,11 +17,29 @@
 #include <chainjnttojacdotsolver.hpp>
 #include <chainhdsolver_vereshchagin.hpp>
 #include <chainidsolver_recursive_newton_euler.hpp>
+#include <chainidsolver_recursive_newton_euler_derivatives.hpp>
+#include <chainidsolver_recursive_newton_euler_batch.hpp>
 #include <chaindynparam.hpp>
 #include <chainidsolver_recursive_newton_euler.hpp>
 #include <chainfdsolver_recursive_newton_euler.hpp>
+#include <chainfdsolver_aba.hpp>
 #include <chainexternalwrenchestimator.hpp>
+#include <fixedchainfksolverpos.hpp>
+#include <chainfksolverpos_batch.hpp>
+#include <chainfksolverpos_incremental.hpp>
+#include <chainjnttojacsolver_incremental.hpp>
+#include <chainiksolverpos_multistart.hpp>
+#include <chainiksolverpos_cached.hpp>
+#include <chainiksolverpos_srs.hpp>
+#include <chainpathparamsolver_toppra.hpp>
+#include <path_line.hpp>
+#include <rotational_interpolation_sa.hpp>
+#include <fixedchainjnttojacsolver.hpp>
+#include <fixedchaindynparam.hpp>
+#include <solverpool.hpp>
 #include <utilities/ldl_solver_eigen.hpp>
+#include <utilities/ltl_solver_eigen.hpp>
+#include <chainjnttojachesssolver_rallN.hpp>
 
 
 using namespace KDL;
@@ -42,8 +60,26 @@ class SolverTest : public CppUnit::TestFixture
     CPPUNIT_TEST(FdSolverDevelopmentTest );
     CPPUNIT_TEST(FdSolverConsistencyTest );
     CPPUNIT_TEST(LDLdecompTest);
+    CPPUNIT_TEST(LTLdecompTest);
     CPPUNIT_TEST(FdAndVereshchaginSolversConsistencyTest );
     CPPUNIT_TEST(UpdateChainTest );
+    CPPUNIT_TEST(DynParamConsistencyTest );
+    CPPUNIT_TEST(CoriolisMatrixTest );
+    CPPUNIT_TEST(IdSolverRNEDerivativesTest );
+    CPPUNIT_TEST(RallNFkDerivativesTest );
+    CPPUNIT_TEST(IdSolverRNEBatchTest );
+    CPPUNIT_TEST(SolverCloneAndPoolTest );
+    CPPUNIT_TEST(FixedChainConsistencyTest );
+    CPPUNIT_TEST(FdABAConsistencyTest );
+    CPPUNIT_TEST(FkPosBatchTest );
+    CPPUNIT_TEST(FkPosIncrementalTest );
+    CPPUNIT_TEST(IkPosMultiStartTest );
+    CPPUNIT_TEST(IkSeedCacheTest );
+    CPPUNIT_TEST(IkPosSRSTest );
+    CPPUNIT_TEST(IkVelSVDJacobiTest );
+    CPPUNIT_TEST(IkVelSVDWarmStartTest );
+    CPPUNIT_TEST(RealTimeAllocationTest );
+    CPPUNIT_TEST(PathParamTOPPRATest );
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -63,8 +99,26 @@ public:
     void FdSolverDevelopmentTest();
     void FdSolverConsistencyTest();
     void LDLdecompTest();
+    void LTLdecompTest();
     void FdAndVereshchaginSolversConsistencyTest();
     void UpdateChainTest();
+    void DynParamConsistencyTest();
+    void CoriolisMatrixTest();
+    void IdSolverRNEDerivativesTest();
+    void RallNFkDerivativesTest();
+    void IdSolverRNEBatchTest();
+    void SolverCloneAndPoolTest();
+    void FixedChainConsistencyTest();
+    void FdABAConsistencyTest();
+    void FkPosBatchTest();
+    void FkPosIncrementalTest();
+    void IkPosMultiStartTest();
+    void IkSeedCacheTest();
+    void IkPosSRSTest();
+    void IkVelSVDJacobiTest();
+    void IkVelSVDWarmStartTest();
+    void RealTimeAllocationTest();
+    void PathParamTOPPRATest();
 
 private:
 
@@ -3,6 +3,14 @@
 #include <frames_io.hpp>
 #include <chainidsolver_recursive_newton_euler.hpp>
 #include <treeidsolver_recursive_newton_euler.hpp>
+#include <treefdsolver_aba.hpp>
+#include <treefdsolver_recursive_newton_euler.hpp>
+#include <flattree.hpp>
+#include <chainfksolverpos_recursive.hpp>
+#include <treefksolverpos_recursive.hpp>
+#include <treejnttojacsolver.hpp>
+#include <treeiksolvervel_wdls.hpp>
+#include <treeiksolverpos_nr_jl.hpp>
 #include <time.h>
 #include <cmath>
 
@@ -175,3 +183,150 @@ void TreeInvDynTest::YTreeTest() {
   }
 
 }
+
+
+void TreeInvDynTest::FdABAConsistencyTest() {
+  Vector gravity(0,0,-9.8);
+  Tree* trees[] = {&tree, &ytree};
+  for(unsigned int t=0; t<2; t++) {
+    TreeFdSolver_ABA fdsolver(*trees[t], gravity);
+    TreeFdSolver_RNE fdsolver_rne(*trees[t], gravity);
+    TreeIdSolver_RNE idsolver(*trees[t], gravity);
+
+    unsigned int nt = trees[t]->getNrOfJoints();
+    JntArray q(nt), qd(nt), qdd(nt), qdd_rne(nt), tau(nt), tau_id(nt), qdd_wrong;
+    WrenchMap f_ext;
+    f_ext[t==0 ? "Segment 17" : "S3"] = Wrench(Vector(1.0,-2.0,3.0), Vector(0.3,-0.4,0.5));
+
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, fdsolver.CartToJnt(q, qd, tau, f_ext, qdd_wrong));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH, fdsolver_rne.CartToJnt(q, qd, tau, f_ext, qdd_wrong));
+
+    unsigned int iterations = 100;
+    while(iterations-- > 0) {
+      //Randomize joint vectors
+      for(unsigned int i=0; i<nt; i++) random(q(i)), random(qd(i)), random(tau(i));
+
+      //The accelerations of the forward dynamics have to reproduce the applied efforts
+      CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fdsolver.CartToJnt(q, qd, tau, f_ext, qdd));
+      CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, idsolver.CartToJnt(q, qd, qdd, f_ext, tau_id));
+      CPPUNIT_ASSERT_EQUAL(tau, tau_id);
+
+      //The sparse L^T*L factorization of the composite inertias agrees with ABA
+      CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR, fdsolver_rne.CartToJnt(q, qd, tau, f_ext, qdd_rne));
+      CPPUNIT_ASSERT_EQUAL(qdd, qdd_rne);
+    }
+  }
+}
+
+
+void TreeInvDynTest::FlatTreeTest() {
+  //The flattened tree has the root at index 0, every parent before its
+  //children and every subtree in a contiguous range
+  FlatTree flat(tree);
+  CPPUNIT_ASSERT_EQUAL(tree.getNrOfSegments() + 1, flat.getNrOfElements());
+  CPPUNIT_ASSERT_EQUAL(tree.getNrOfJoints(), flat.getNrOfJoints());
+  CPPUNIT_ASSERT_EQUAL(-1, flat.getParent(0));
+  CPPUNIT_ASSERT_EQUAL(tree.getRootSegment()->first, flat.getName(0));
+  CPPUNIT_ASSERT_EQUAL(-1, flat.getIndex("no such segment"));
+  for(unsigned int i=1; i<flat.getNrOfElements(); i++) {
+    const int parent = flat.getParent(i);
+    CPPUNIT_ASSERT(parent >= 0 && (unsigned int)parent < i);
+    CPPUNIT_ASSERT(i < flat.getSubtreeEnd(parent));
+    CPPUNIT_ASSERT(flat.getSubtreeEnd(i) <= flat.getSubtreeEnd(parent));
+    CPPUNIT_ASSERT_EQUAL((int)i, flat.getIndex(flat.getName(i)));
+    SegmentMap::const_iterator it = tree.getSegments().find(flat.getName(i));
+    CPPUNIT_ASSERT_EQUAL(GetTreeElementParent(it->second)->first, flat.getName(parent));
+    if(flat.getSegment(i).getJoint().getType() == Joint::Fixed)
+      CPPUNIT_ASSERT_EQUAL(-1, flat.getQNr(i));
+    else
+      CPPUNIT_ASSERT_EQUAL((int)GetTreeElementQNr(it->second), flat.getQNr(i));
+  }
+
+  //The joint parents follow the moving ancestors: the two chains hang
+  //from the root, and the fixed joints of chain1 are skipped
+  const std::vector<int>& joint_parents = flat.getJointParents();
+  const int expected_parents[] = {-1, 0, 1, 2, 3, 4, -1, 6, 7, 8, 9};
+  CPPUNIT_ASSERT_EQUAL((size_t)tree.getNrOfJoints(), joint_parents.size());
+  for(unsigned int j=0; j<joint_parents.size(); j++)
+    CPPUNIT_ASSERT_EQUAL(expected_parents[j], joint_parents[j]);
+  CPPUNIT_ASSERT_EQUAL(-1, FlatTree(ytree).getJointParents()[0]);
+  CPPUNIT_ASSERT_EQUAL(0, FlatTree(ytree).getJointParents()[1]);
+  CPPUNIT_ASSERT_EQUAL(0, FlatTree(ytree).getJointParents()[2]);
+
+  //The index based solvers agree with the name based ones and with the chain solvers
+  TreeFkSolverPos_recursive fksolver(tree);
+  TreeJntToJacSolver jacsolver(tree);
+  ChainFkSolverPos_recursive chainfksolver(chain1);
+  const unsigned int nt = tree.getNrOfJoints();
+  JntArray q(nt), q1(chain1.getNrOfJoints());
+  Jacobian jac_name(nt), jac_index(nt);
+  std::vector<Frame> frames;
+  Frame f_name, f_index, f_chain;
+  for(unsigned int iterations=0; iterations<10; iterations++) {
+    for(unsigned int i=0; i<nt; i++) random(q(i));
+    CPPUNIT_ASSERT_EQUAL(0, fksolver.JntToCart(q, frames));
+    CPPUNIT_ASSERT_EQUAL((size_t)flat.getNrOfElements(), frames.size());
+    for(unsigned int i=0; i<flat.getNrOfElements(); i++) {
+      CPPUNIT_ASSERT_EQUAL(0, fksolver.JntToCart(q, f_name, flat.getName(i)));
+      CPPUNIT_ASSERT_EQUAL(0, fksolver.JntToCart(q, f_index, i));
+      CPPUNIT_ASSERT_EQUAL(f_name, f_index);
+      CPPUNIT_ASSERT_EQUAL(f_name, frames[i]);
+      CPPUNIT_ASSERT_EQUAL(0, jacsolver.JntToJac(q, jac_name, flat.getName(i)));
+      CPPUNIT_ASSERT_EQUAL(0, jacsolver.JntToJac(q, jac_index, i));
+      CPPUNIT_ASSERT_EQUAL(jac_name, jac_index);
+    }
+    //chain1 was added first, so it owns the first joints of the tree
+    for(unsigned int i=0; i<q1.rows(); i++) q1(i) = q(i);
+    chainfksolver.JntToCart(q1, f_chain);
+    fksolver.JntToCart(q, f_name, "Segment 19");
+    CPPUNIT_ASSERT_EQUAL(f_chain, f_name);
+  }
+  CPPUNIT_ASSERT_EQUAL(-2, fksolver.JntToCart(q, f_index, flat.getNrOfElements()));
+  CPPUNIT_ASSERT_EQUAL(-2, jacsolver.JntToJac(q, jac_index, flat.getNrOfElements()));
+
+  //Position ik on both endpoints of the tree
+  std::vector<std::string> endpoints;
+  endpoints.push_back("Segment 19");
+  endpoints.push_back("Segment 25");
+  TreeIkSolverVel_wdls ikvelsolver(tree, endpoints);
+  JntArray q_min(nt), q_max(nt), q_init(nt), q_sol(nt);
+  for(unsigned int i=0; i<nt; i++) q_min(i) = -PI, q_max(i) = PI;
+  TreeIkSolverPos_NR_JL iksolver(tree, endpoints, q_min, q_max, fksolver, ikvelsolver, 1000, 1e-9);
+  for(unsigned int i=0; i<nt; i++) q(i) = 0.5*sin(1.0+i), q_init(i) = q(i) + 0.1;
+  Frames p_in;
+  fksolver.JntToCart(q, p_in["Segment 19"], "Segment 19");
+  fksolver.JntToCart(q, p_in["Segment 25"], "Segment 25");
+  CPPUNIT_ASSERT(iksolver.CartToJnt(q_init, p_in, q_sol) >= 0);
+  for(Frames::const_iterator it=p_in.begin(); it!=p_in.end(); ++it) {
+    fksolver.JntToCart(q_sol, f_name, it->first);
+    CPPUNIT_ASSERT(Equal(it->second, f_name, 1e-6));
+  }
+  p_in["no such segment"] = Frame::Identity();
+  CPPUNIT_ASSERT_EQUAL(-2.0, iksolver.CartToJnt(q_init, p_in, q_sol));
+
+  //The twists in the order of the endpoints give the same joint velocities
+  Twists v_in;
+  v_in["Segment 19"] = Twist(Vector(0.1,-0.2,0.3), Vector(0.0,0.1,-0.1));
+  v_in["Segment 25"] = Twist(Vector(-0.1,0.0,0.2), Vector(0.2,0.0,0.1));
+  std::vector<Twist> v_flat;
+  for(unsigned int i=0; i<ikvelsolver.getEndpoints().size(); i++)
+    v_flat.push_back(v_in[ikvelsolver.getEndpoints()[i]]);
+  JntArray qdot_name(nt), qdot_index(nt);
+  CPPUNIT_ASSERT(ikvelsolver.CartToJnt(q, v_in, qdot_name) >= 0);
+  CPPUNIT_ASSERT(ikvelsolver.CartToJnt(q, v_flat, qdot_index) >= 0);
+  CPPUNIT_ASSERT_EQUAL(qdot_name, qdot_index);
+  v_flat.pop_back();
+  CPPUNIT_ASSERT_EQUAL(-2.0, ikvelsolver.CartToJnt(q, v_flat, qdot_index));
+
+  //The resolved names of the external wrenches follow changes of f_ext
+  TreeIdSolver_RNE idsolver(tree, Vector(0,0,-9.8));
+  JntArray qd(nt), qdd(nt), tau(nt), tau_ref(nt);
+  WrenchMap f_ext;
+  f_ext["Segment 17"] = Wrench(Vector(1.0,-2.0,3.0), Vector(0.3,-0.4,0.5));
+  idsolver.CartToJnt(q, qd, qdd, f_ext, tau);
+  f_ext.clear();
+  f_ext["Segment 23"] = Wrench(Vector(-1.0,0.5,0.0), Vector(0.0,0.2,0.1));
+  idsolver.CartToJnt(q, qd, qdd, f_ext, tau);
+  TreeIdSolver_RNE(tree, Vector(0,0,-9.8)).CartToJnt(q, qd, qdd, f_ext, tau_ref);
+  CPPUNIT_ASSERT_EQUAL(tau_ref, tau);
+}
@@ -15,6 +15,8 @@ class TreeInvDynTest : public CppUnit::TestFixture
     CPPUNIT_TEST(UpdateTreeTest);
     CPPUNIT_TEST(TwoChainsTest);
     CPPUNIT_TEST(YTreeTest);
+    CPPUNIT_TEST(FdABAConsistencyTest);
+    CPPUNIT_TEST(FlatTreeTest);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -24,6 +26,8 @@ public:
     void UpdateTreeTest();
     void TwoChainsTest();
     void YTreeTest();
+    void FdABAConsistencyTest();
+    void FlatTreeTest();
 
 private:
     Chain chain1,chain2;
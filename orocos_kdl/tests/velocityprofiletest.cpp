@@ -1,5 +1,21 @@
 #include "velocityprofiletest.hpp"
 #include <frames_io.hpp>
+#include <path_circle.hpp>
+#include <path_composite.hpp>
+#include <path_line.hpp>
+#include <rotational_interpolation_sa.hpp>
+#include <trajectory_baked.hpp>
+#include <trajectory_composite.hpp>
+#include <trajectory_jerklimited.hpp>
+#include <trajectory_segment.hpp>
+#include <velocityprofile_spline.hpp>
+#include <trajectory_stationary.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
 CPPUNIT_TEST_SUITE_REGISTRATION( VelocityProfileTest );
 
 using namespace KDL;
@@ -376,3 +392,280 @@ void VelocityProfileTest::TestDirac_SetProfileDuration()
     time = duration + 1.0;
     CPPUNIT_ASSERT_DOUBLES_EQUAL(pos2, v.Pos(time), epsilon);
 }
+
+void VelocityProfileTest::TestJerkLimited_SetProfile()
+{
+	const double maxvel = 1.0, maxacc = 2.0, maxjerk = 10.0;
+	VelocityProfile_JerkLimited v(maxvel, maxacc, maxjerk);
+
+	// long enough to reach all limits: d/maxvel + maxvel/maxacc + maxacc/maxjerk
+	v.SetProfile(1.0, 6.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.7, v.Duration(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, v.Pos(0.0), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(0.0), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(maxjerk, v.Jerk(0.0), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(maxacc, v.Acc(0.3), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(maxvel, v.Vel(2.85), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, v.Pos(2.85), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-maxacc, v.Acc(5.4), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, v.Pos(5.7), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, v.Pos(7.0), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(7.0), epsilon);
+
+	// too short for any limit but the jerk: 4*(d/(2*maxjerk))^(1/3), backwards
+	v.SetProfile(0.0, -0.01);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0*std::cbrt(0.01/(2*maxjerk)), v.Duration(), 1e-12);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.005, v.Pos(0.5*v.Duration()), 1e-12);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.01, v.Pos(v.Duration()*(1 - 1e-12)), 1e-12);
+
+	v.SetProfile(2.0, 2.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Duration(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, v.Pos(1.0), epsilon);
+}
+
+void VelocityProfileTest::TestJerkLimited_SetProfileDuration()
+{
+	const double maxvel = 1.0, maxacc = 2.0, maxjerk = 10.0;
+	VelocityProfile_JerkLimited v(maxvel, maxacc, maxjerk);
+
+	// stretched by a factor 2: half the velocity
+	v.SetProfileDuration(1.0, 6.0, 11.4);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(11.4, v.Duration(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5*maxvel, v.Vel(5.7), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, v.Pos(5.7), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, v.Pos(11.4), epsilon);
+
+	// cannot be faster than time-optimal
+	v.SetProfileDuration(1.0, 6.0, 1.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.7, v.Duration(), epsilon);
+
+	std::stringstream ss;
+	v.Write(ss);
+	VelocityProfile* read = VelocityProfile::Read(ss);
+	read->SetProfile(1.0, 6.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.7, read->Duration(), epsilon);
+	delete read;
+}
+
+void VelocityProfileTest::TestJerkLimited_FromState()
+{
+	const double maxvel = 1.0, maxacc = 2.0, maxjerk = 10.0;
+	VelocityProfile_JerkLimited v(maxvel, maxacc, maxjerk);
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	for (int n = 0; n < 500; ++n) {
+		const double pos = 2*uniform(gen), vel = maxvel*uniform(gen), acc = maxacc*uniform(gen);
+		const double target = 2*uniform(gen);
+		v.SetProfile(pos, vel, acc, target);
+		const double duration = v.Duration();
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pos, v.Pos(0.0), epsilon);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(vel, v.Vel(0.0), epsilon);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(acc, v.Acc(0.0), epsilon);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(target, v.Pos(duration*(1 - 1e-12)), 1e-10);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(duration*(1 - 1e-12)), 1e-10);
+
+		// within the limits, except for the velocity an initial
+		// acceleration away from zero cannot avoid, and differentiable
+		const double vel_stop = std::abs(vel + acc*std::abs(acc)/(2*maxjerk));
+		const double dt = 1e-6;
+		for (int i = 1; i < 200; ++i) {
+			const double time = duration*i/200;
+			CPPUNIT_ASSERT(std::abs(v.Vel(time)) <= std::max(maxvel, vel_stop) + 1e-12);
+			CPPUNIT_ASSERT(std::abs(v.Acc(time)) <= maxacc + 1e-12);
+			CPPUNIT_ASSERT(std::abs(v.Jerk(time)) <= maxjerk);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL((v.Pos(time + dt) - v.Pos(time - dt))/(2*dt), v.Vel(time), 1e-6);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL((v.Vel(time + dt) - v.Vel(time - dt))/(2*dt), v.Acc(time), 1e-4);
+		}
+	}
+}
+
+void VelocityProfileTest::TestBatchEvaluation()
+{
+	VelocityProfile_Trap trap(2.0, 1.0), trap_short(2.0, 1.0);
+	trap.SetProfile(1.0, 10.0);
+	trap_short.SetProfileDuration(1.0, -0.5, 3.0);
+	VelocityProfile_TrapHalf starting(2.0, 1.0, true), ending(2.0, 1.0, false);
+	starting.SetProfile(1.0, 10.0);
+	ending.SetProfile(10.0, 1.0);
+	VelocityProfile_Spline cubic, quintic;
+	cubic.SetProfileDuration(0.0, 1.0, 2.0, -1.0, 3.0);
+	quintic.SetProfileDuration(0.0, 1.0, 0.5, 2.0, -1.0, 0.0, 3.0);
+	// the default implementation
+	VelocityProfile_JerkLimited jerk(1.0, 2.0, 10.0);
+	jerk.SetProfile(0.0, 0.5, -1.0, 2.0);
+	const VelocityProfile* profiles[] = {&trap, &trap_short, &starting, &ending, &cubic, &quintic, &jerk};
+	const unsigned int nr_of_profiles = sizeof(profiles)/sizeof(profiles[0]);
+
+	// times before, during and after the motion, and the phase boundaries
+	// themselves, unordered and sorted
+	std::vector<double> times;
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> uniform(-1.0, 8.0);
+	for (int i = 0; i < 997; ++i)
+		times.push_back(uniform(gen));
+	times.push_back(0.0);
+	times.push_back(2.0);
+	times.push_back(trap.Duration());
+	const unsigned int n = times.size();
+	std::vector<double> sorted(times);
+	std::sort(sorted.begin(), sorted.end());
+
+	std::vector<double> pos(n), vel(n), acc(n), only(n);
+	for (unsigned int k = 0; k < 2*nr_of_profiles; ++k) {
+		if (k == nr_of_profiles)
+			times = sorted;
+		const VelocityProfile& profile = *profiles[k % nr_of_profiles];
+		profile.Evaluate(&times[0], n, &pos[0], &vel[0], &acc[0]);
+		for (unsigned int i = 0; i < n; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(profile.Pos(times[i]), pos[i], 1e-12);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(profile.Vel(times[i]), vel[i], 1e-12);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(profile.Acc(times[i]), acc[i], 1e-12);
+		}
+		profile.PosBatch(&times[0], n, &only[0]);
+		CPPUNIT_ASSERT(pos == only);
+		profile.VelBatch(&times[0], n, &only[0]);
+		CPPUNIT_ASSERT(vel == only);
+		profile.AccBatch(&times[0], n, &only[0]);
+		CPPUNIT_ASSERT(acc == only);
+	}
+}
+
+void VelocityProfileTest::TestComposite_Lookup()
+{
+	// n elements of unit duration/length, element i at x == i
+	const int n = 200;
+	Trajectory_Composite traj;
+	Path_Composite path;
+	for (int i = 0; i < n; ++i) {
+		traj.Add(new Trajectory_Stationary(1.0, Frame(Vector(i, 0, 0))));
+		path.Add(new Path_Line(Frame(Vector(i, 0, 0)), Frame(Vector(i + 1, 0, 0)),
+							   new RotationalInterpolation_SingleAxis(), 1.0));
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(n, traj.Duration(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(n, path.PathLength(), epsilon);
+
+	// an element starts at its start time, before and after the
+	// composite the first and last elements are used
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, traj.Pos(-1.0).p.x(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, traj.Pos(0.0).p.x(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, traj.Pos(3.0).p.x(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, traj.Pos(3.5).p.x(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(n - 1, traj.Pos(n + 1.0).p.x(), epsilon);
+
+	int segment;
+	double inner_s;
+	path.GetCurrentSegmentLocation(2.5, segment, inner_s);
+	CPPUNIT_ASSERT_EQUAL(2, segment);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, inner_s, epsilon);
+	// the end of a segment belongs to that segment
+	path.GetCurrentSegmentLocation(3.0, segment, inner_s);
+	CPPUNIT_ASSERT_EQUAL(2, segment);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, inner_s, epsilon);
+	path.GetCurrentSegmentLocation(0.0, segment, inner_s);
+	CPPUNIT_ASSERT_EQUAL(0, segment);
+	path.GetCurrentSegmentLocation(n, segment, inner_s);
+	CPPUNIT_ASSERT_EQUAL(n - 1, segment);
+
+	// concurrent evaluation at unrelated values of the same objects
+	const int nthreads = 4;
+	std::vector<int> failures(nthreads, 0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < nthreads; ++t) {
+		threads.push_back(std::thread([&, t]() {
+			for (int k = 0; k < 20000; ++k) {
+				const double s = std::fmod(k * 0.37 + t * 51.3, (double)n);
+				if (std::fabs(path.Pos(s).p.x() - s) > 1e-9)
+					failures[t]++;
+				if (std::fabs(traj.Pos(s).p.x() - std::floor(s)) > 1e-9)
+					failures[t]++;
+			}
+		}));
+	}
+	for (int t = 0; t < nthreads; ++t) {
+		threads[t].join();
+		CPPUNIT_ASSERT_EQUAL(0, failures[t]);
+	}
+}
+
+void VelocityProfileTest::TestTrajectoryBaked()
+{
+	// half a circle with a rotation about another axis, along a quintic
+	// spline of 2.05 s: the last interval is shorter than the period
+	Path_Circle* path = new Path_Circle(Frame(Rotation::RPY(0.1, 0.2, 0.3), Vector(0.5, 0.0, 0.3)),
+										Vector(0.5, 0.2, 0.3), Vector(0.5, 0.2, 0.5),
+										Rotation::RPY(0.5, -0.4, 1.0), M_PI,
+										new RotationalInterpolation_SingleAxis(), 0.2);
+	VelocityProfile_Spline* prof = new VelocityProfile_Spline();
+	prof->SetProfileDuration(0, 0, 0, path->PathLength(), 0, 0, 2.05);
+	Trajectory_Segment traj(path, prof);
+
+	const double period = 0.01;
+	Trajectory_Baked baked(traj, period);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(traj.Duration(), baked.Duration(), epsilon);
+	CPPUNIT_ASSERT_EQUAL(206u, baked.NrOfSamples());
+	CPPUNIT_ASSERT_EQUAL(baked.NrOfSamples()*baked.BytesPerSample(), baked.Bytes());
+	CPPUNIT_ASSERT(Trajectory_Baked::BytesPerSecond(period) >= 100*Trajectory_Baked::BytesPerSample());
+
+	// exact at the samples and at the end, clamped outside
+	const double times[] = {0.0, 0.5, 1.23, 2.0, 2.05};
+	for (unsigned int k = 0; k < sizeof(times)/sizeof(times[0]); ++k) {
+		CPPUNIT_ASSERT(Equal(traj.Pos(times[k]), baked.Pos(times[k]), 1e-9));
+		CPPUNIT_ASSERT(Equal(traj.Vel(times[k]), baked.Vel(times[k]), 1e-9));
+		CPPUNIT_ASSERT(Equal(traj.Acc(times[k]), baked.Acc(times[k]), 1e-9));
+	}
+	CPPUNIT_ASSERT(Equal(traj.Pos(0.0), baked.Pos(-1.0), 1e-9));
+	CPPUNIT_ASSERT(Equal(traj.Pos(2.05), baked.Pos(3.0), 1e-9));
+
+	// small errors between the samples
+	Trajectory_Baked::ErrorReport report = baked.Compare(traj);
+	CPPUNIT_ASSERT(report.pos < 1e-8);
+	CPPUNIT_ASSERT(report.rot < 1e-8);
+	CPPUNIT_ASSERT(report.vel < 1e-5);
+	CPPUNIT_ASSERT(report.acc < 1e-2);
+	CPPUNIT_ASSERT(report.time_pos >= 0 && report.time_pos <= traj.Duration());
+
+	Trajectory* clone = baked.Clone();
+	CPPUNIT_ASSERT(Equal(baked.Pos(1.234), clone->Pos(1.234), 1e-12));
+	delete clone;
+}
+
+void VelocityProfileTest::TestTrajectoryJerkLimited()
+{
+	Trajectory_JerkLimited traj(Frame(Rotation::RPY(0.1, 0.2, 0.3), Vector(0.4, 0.1, 0.5)),
+								0.5, 1.0, 10.0, 1.0, 2.0, 20.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, traj.Duration(), epsilon);
+
+	// a target that moves every 10 ms, for 0.5 s
+	Frame target(Rotation::RPY(0.8, -0.4, 1.0), Vector(0.6, -0.2, 0.4));
+	const double period = 0.01;
+	for (int i = 0; i < 50; ++i) {
+		const Frame pos = traj.Pos(period);
+		const Twist vel = traj.Vel(period);
+		const Twist acc = traj.Acc(period);
+		target = Frame(Rotation::RotZ(0.01), Vector(0.0, 0.002, 0.0))*target;
+		traj.Replan(i == 0 ? 0.0 : period, target);
+		if (i > 0) {
+			// continuous up to the acceleration
+			CPPUNIT_ASSERT(Equal(pos, traj.Pos(0.0), 1e-12));
+			CPPUNIT_ASSERT(Equal(vel, traj.Vel(0.0), 1e-12));
+			CPPUNIT_ASSERT(Equal(acc, traj.Acc(0.0), 1e-12));
+		}
+	}
+	CPPUNIT_ASSERT(Equal(target, traj.Target(), epsilon));
+	CPPUNIT_ASSERT(Equal(target, traj.Pos(traj.Duration()), 1e-10));
+	CPPUNIT_ASSERT(Equal(Twist::Zero(), traj.Vel(traj.Duration()), 1e-10));
+
+	// Vel and Acc are the derivatives of Pos and Vel, the angular velocity
+	// without diff(), which rounds small rotations to zero
+	const double dt = 1e-5;
+	for (int i = 1; i < 100; ++i) {
+		const double time = traj.Duration()*i/100;
+		const Frame f1 = traj.Pos(time - dt), f2 = traj.Pos(time + dt);
+		const Rotation dR = f2.M*f1.M.Inverse();
+		const Vector w = Vector(dR(2,1) - dR(1,2), dR(0,2) - dR(2,0), dR(1,0) - dR(0,1))/(4*dt);
+		const Twist vel = traj.Vel(time);
+		CPPUNIT_ASSERT(Equal((f2.p - f1.p)/(2*dt), vel.vel, 1e-6));
+		CPPUNIT_ASSERT(Equal(w, vel.rot, 1e-6));
+		CPPUNIT_ASSERT(Equal((traj.Vel(time + dt) - traj.Vel(time - dt))/(2*dt), traj.Acc(time), 1e-4));
+	}
+}
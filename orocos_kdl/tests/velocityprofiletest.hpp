@@ -5,6 +5,7 @@
 #include <velocityprofile_trap.hpp>
 #include <velocityprofile_traphalf.hpp>
 #include <velocityprofile_dirac.hpp>
+#include <velocityprofile_jerklimited.hpp>
 
 class VelocityProfileTest : public CppUnit::TestFixture
 {
@@ -22,6 +23,16 @@ class VelocityProfileTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestDirac_SetProfile);
     CPPUNIT_TEST(TestDirac_SetProfileDuration);
 
+    CPPUNIT_TEST(TestJerkLimited_SetProfile);
+    CPPUNIT_TEST(TestJerkLimited_SetProfileDuration);
+    CPPUNIT_TEST(TestJerkLimited_FromState);
+
+    CPPUNIT_TEST(TestBatchEvaluation);
+
+    CPPUNIT_TEST(TestComposite_Lookup);
+    CPPUNIT_TEST(TestTrajectoryBaked);
+    CPPUNIT_TEST(TestTrajectoryJerkLimited);
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -40,6 +51,16 @@ public:
 
     void TestDirac_SetProfile();
     void TestDirac_SetProfileDuration();
+
+    void TestJerkLimited_SetProfile();
+    void TestJerkLimited_SetProfileDuration();
+    void TestJerkLimited_FromState();
+
+    void TestBatchEvaluation();
+
+    void TestComposite_Lookup();
+    void TestTrajectoryBaked();
+    void TestTrajectoryJerkLimited();
 };
 
 #endif
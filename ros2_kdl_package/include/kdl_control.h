@@ -2,6 +2,7 @@
 #define KDLControl
 
 #include "Eigen/Dense"
+#include "Eigen/Cholesky"
 #include "kdl_robot.h"
 #include "utils.h"
 
@@ -35,10 +36,31 @@ public:
                            double _Kdp,
                            KDLRobot &_robot, double lam);
 
+    // real-time variants, no allocation once _tau has getNrJnts() entries
+    void idCntr(const KDL::JntArray &_qd,
+                const KDL::JntArray &_dqd,
+                const KDL::JntArray &_ddqd,
+                double _Kp, double _Kd,
+                KDLRobot &_robot, Eigen::VectorXd &_tau);
+
+    void idCntr(const KDL::Frame &_desPos,
+                const KDL::Twist &_desVel,
+                const KDL::Twist &_desAcc,
+                double _Kpp, double _Kdp,
+                KDLRobot &_robot, double lam, Eigen::VectorXd &_tau);
+
 private:
 
     KDLRobot* robot_;
 
+    // y = J'*(J*J' + lam^2*I)^-1*x, the same as the damped pseudoinverse times x
+    void dampedPinvTimes(const KDL::Jacobian &J, const Vector6d &x, double lambda, Eigen::VectorXd &y);
+
+    // workspaces
+    Eigen::VectorXd y_;
+    Eigen::Matrix<double,6,6> JJt_;
+    Eigen::LDLT<Eigen::Matrix<double,6,6> > ldlt_;
+
 };
 
 #endif
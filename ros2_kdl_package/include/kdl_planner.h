@@ -13,8 +13,11 @@
 #include <kdl/rotational_interpolation_sa.hpp>
 #include <kdl/utilities/error.h>
 #include <kdl/trajectory_composite.hpp>
+#include <kdl/trajectory_baked.hpp>
+#include <kdl/trajectory_jerklimited.hpp>
 #include "Eigen/Dense"
 #include <cmath>
+#include <memory>
 
 struct trajectory_point{
   Eigen::Vector3d pos = Eigen::Vector3d::Zero();
@@ -52,6 +55,15 @@ public:
     KDLPlanner(double _trajDuration, Eigen::Vector3d _trajInit, Eigen::Vector3d _trajEnd);
     trajectory_point compute_trajectory_linear(double time, double time_c=0);
 
+    // Sample compute_trajectory_linear/_circle once at the control period,
+    // compute_trajectory_baked() then only interpolates the samples.
+    // Returns the largest differences with the closed form trajectory.
+    // Any KDL::Trajectory, e.g. getTrajectory(), can be baked with
+    // KDL::Trajectory_Baked directly.
+    KDL::Trajectory_Baked::ErrorReport bake_trajectory_linear(double period, double time_c=0);
+    KDL::Trajectory_Baked::ErrorReport bake_trajectory_circle(double period, double time_c=0);
+    trajectory_point compute_trajectory_baked(double time) const;
+
 private:
 
     KDL::Path_RoundedComposite* path_;
@@ -64,6 +76,7 @@ private:
     Eigen::Vector3d trajInit_, trajEnd_;
     double trajRadius_;
     trajectory_point p;
+    std::shared_ptr<KDL::Trajectory_Baked> baked_;
 
 };
 
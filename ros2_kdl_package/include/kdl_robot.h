@@ -3,8 +3,9 @@
 
 #include <kdl/chain.hpp>
 #include <kdl/chaindynparam.hpp>
-#include <kdl/chainiksolverpos_nr_jl.hpp>
-#include <kdl/chainiksolvervel_pinv.hpp>
+#include <kdl/chainiksolverpos_multistart.hpp>
+#include <kdl/chainiksolverpos_srs.hpp>
+#include <kdl/chainikseedcache.hpp>
 #include <kdl/chainjnttojacsolver.hpp>
 #include <kdl/chainfksolverpos_recursive.hpp>
 #include <kdl/chainfksolvervel_recursive.hpp>
@@ -28,23 +29,28 @@ class KDLRobot
 
 public:
 
+    // terms evaluated on first access after update()
+    enum Term {JSIM, CORIOLIS, CORIOLIS_MATRIX, GRAVITY, FRAME, VELOCITY, JACOBIAN,
+               BODY_JACOBIAN, JAC_DOT_Q_DOT, NR_OF_TERMS};
+
     // robot
     KDLRobot();
     KDLRobot(KDL::Tree &robot_tree);
-    void update(std::vector<double> _jnt_values,std::vector<double> _jnt_vel);
+    void update(const std::vector<double> &_jnt_values, const std::vector<double> &_jnt_vel);
+    void update(const double *_jnt_values, const double *_jnt_vel); // getNrJnts() entries each, no allocation
     unsigned int getNrJnts();
     unsigned int getNrSgmts();
     void addEE(const KDL::Frame &_f_tip);
     void setJntLimits(KDL::JntArray &q_low, KDL::JntArray &q_high);
 
-    // joints
+    // joints, references stay valid until the next update()
     Eigen::MatrixXd getJntLimits();
-    Eigen::MatrixXd getJsim();
-    Eigen::MatrixXd getCoriolisMatrix();
-    Eigen::VectorXd getCoriolis();
-    Eigen::VectorXd getGravity();
-    Eigen::VectorXd getJntValues();
-    Eigen::VectorXd getJntVelocities();
+    const Eigen::MatrixXd &getJsim();
+    const Eigen::MatrixXd &getCoriolisMatrix();
+    const Eigen::VectorXd &getCoriolis();
+    const Eigen::VectorXd &getGravity();
+    const Eigen::VectorXd &getJntValues();
+    const Eigen::VectorXd &getJntVelocities();
     
     Eigen::VectorXd getID(const KDL::JntArray &q,
                           const KDL::JntArray &q_dot,
@@ -52,15 +58,20 @@ public:
                           const KDL::Wrenches &f_ext);
 
     // end-effector
-    KDL::Frame getEEFrame();
-    KDL::Twist getEEVelocity();
-    KDL::Twist getEEBodyVelocity();
-    KDL::Jacobian getEEJacobian();
-    KDL::Jacobian getEEBodyJacobian();
-    Eigen::VectorXd getEEJacDotqDot();
+    const KDL::Frame &getEEFrame();
+    const KDL::Twist &getEEVelocity();
+    const KDL::Twist &getEEBodyVelocity();
+    const KDL::Jacobian &getEEJacobian();
+    const KDL::Jacobian &getEEBodyJacobian();
+    Vector6d getEEJacDotqDot();
 
     // inverse kinematics
-    void getInverseKinematics(KDL::Frame &f, KDL::JntArray &q);                           
+    void getInverseKinematics(KDL::Frame &f, KDL::JntArray &q);
+    KDL::ChainIkSeedCache &getIkSeedCache();                           
+
+    // number of evaluations of each term since construction or reset
+    unsigned long getNrOfEvaluations(Term term) const;
+    void resetEvaluationCounters();
 
 private:
 
@@ -72,30 +83,42 @@ private:
     KDL::ChainJntToJacSolver* jacSol_;
     KDL::ChainFkSolverPos_recursive* fkSol_;
     KDL::ChainFkSolverVel_recursive* fkVelSol_;
-    KDL::ChainIkSolverVel_pinv* ikVelSol_;
-    KDL::ChainIkSolverPos_NR_JL* ikSol_;
+    KDL::ChainIkSolverPos_MultiStart* ikSol_;
+    KDL::ChainIkSolverPos_SRS* ikSrsSol_;
+    KDL::ChainIkSeedCache* ikCache_;
  
     KDL::ChainJntToJacDotSolver* jntJacDotSol_;
     KDL::ChainIdSolver_RNE* idSolver_;
 
     // joints
-    void updateJnts(std::vector<double> _jnt_values, std::vector<double> _jnt_vel);
+    void updateJnts(const double *_jnt_values, const double *_jnt_vel);
     KDL::JntSpaceInertiaMatrix jsim_;
     KDL::JntArray jntArray_;
     KDL::JntArray jntVel_;
+    KDL::JntArrayVel jntArrayVel_;  // copy of both for the velocity solvers
     KDL::JntArray coriol_;
+    Eigen::MatrixXd coriolMat_;
     KDL::JntArray grav_;
     KDL::JntArray q_min_;
     KDL::JntArray q_max_;
 
+    // lazy evaluation, bit i of valid_ is set when Term i is up to date
+    unsigned int valid_;
+    unsigned long evaluations_[NR_OF_TERMS];
+    bool evaluate(Term term);
+    void updateDynamics();
+    void updateFrame();
+    void updateVelocity();
+    void updateJacobian();
+
     // end-effector
     KDL::Frame f_F_ee_;             // end-effector frame in flange frame
+    KDL::Frame s_F_f_;              // flange frame in spatial frame
     KDL::Frame s_F_ee_;             // end-effector frame in spatial frame
     KDL::Twist s_V_ee_;             // end-effector twist in spatial frame
+    KDL::Jacobian s_J_f_;           // flange Jacobian in spatial frame
     KDL::Jacobian s_J_ee_;          // end-effector Jacobian in spatial frame
     KDL::Jacobian b_J_ee_;          // end-effector Jacobian in body frame
-    KDL::Jacobian s_J_dot_ee_;      // end-effector Jacobian dot in spatial frame
-    KDL::Jacobian b_J_dot_ee_;      // end-effector Jacobian dot in body frame
     KDL::Twist s_J_dot_q_dot_ee_;   // end-effector Jdot*qdot in spatial frame
 
     std::string strError(const int error);
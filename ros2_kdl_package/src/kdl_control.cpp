@@ -3,6 +3,7 @@
 KDLController::KDLController(KDLRobot &_robot)
 {
     robot_ = &_robot;
+    y_.resize(_robot.getNrJnts());
 }
 
 Eigen::VectorXd KDLController::idCntr(KDL::JntArray &_qd,
@@ -11,18 +12,24 @@ Eigen::VectorXd KDLController::idCntr(KDL::JntArray &_qd,
                                       double _Kp, double _Kd,
                                       KDLRobot &_robot)
 {   
+    Eigen::VectorXd tau(_robot.getNrJnts());
+    idCntr(_qd, _dqd, _ddqd, _Kp, _Kd, _robot, tau);
+    return tau;
+}
+
+void KDLController::idCntr(const KDL::JntArray &_qd,
+                           const KDL::JntArray &_dqd,
+                           const KDL::JntArray &_ddqd,
+                           double _Kp, double _Kd,
+                           KDLRobot &_robot, Eigen::VectorXd &_tau)
+{
     KDLRobot* rob = &_robot;
-    
-    // read current state
-    Eigen::VectorXd q = rob->getJntValues();
-    Eigen::VectorXd dq = rob->getJntVelocities();
 
-    // calculate errors
-    Eigen::VectorXd e = _qd.data - q;
-    Eigen::VectorXd de = _dqd.data - dq;
-    Eigen::VectorXd ddqd = _ddqd.data;
-    
-    return rob->getJsim() * (ddqd + _Kd*de + _Kp*e) + rob->getCoriolis() + rob->getGravity();
+    // y = ddqd + Kd*de + Kp*e
+    y_ = _ddqd.data + _Kd*(_dqd.data - rob->getJntVelocities()) + _Kp*(_qd.data - rob->getJntValues());
+
+    _tau.noalias() = rob->getJsim() * y_;
+    _tau += rob->getCoriolis() + rob->getGravity();
 }
 
 
@@ -34,6 +41,15 @@ Eigen::MatrixXd KDLController::computeDampedPseudoInverse(const Eigen::MatrixXd&
     return J_damped_pinv;
 }
 
+void KDLController::dampedPinvTimes(const KDL::Jacobian &J, const Vector6d &x, double lambda, Eigen::VectorXd &y)
+{
+    // (J'*J + lam^2*I)^-1*J' = J'*(J*J' + lam^2*I)^-1, so only a 6x6 system is solved
+    JJt_.noalias() = J.data * J.data.transpose();
+    JJt_.diagonal().array() += lambda * lambda;
+    ldlt_.compute(JJt_);
+    y.noalias() = J.data.transpose() * ldlt_.solve(x);
+}
+
 void KDLController::CLIK(KDL::Frame &_desPos,
                          KDL::Twist &_desVel,
                          KDL::Twist &_desAcc,
@@ -46,13 +62,10 @@ void KDLController::CLIK(KDL::Frame &_desPos,
     // calculate errors
     Vector6d err, derr;
     computeErrors(_desPos, rob->getEEFrame(), _desVel, rob->getEEVelocity(), err, derr);
-    KDL::Twist dxdd = _desAcc;
     
-    // calculate damped pseudoinverse
-    Eigen::MatrixXd Jdamp = this->computeDampedPseudoInverse(rob->getEEJacobian().data, lam);
-    
-    // calculate joint trajectories
-    _dqdd.data = Jdamp * (toEigen(dxdd) + _Kd*derr + _Kp*err - rob->getEEJacDotqDot());
+    // calculate joint trajectories with the damped pseudoinverse
+    Vector6d x = toEigen(_desAcc) + _Kd*derr + _Kp*err - rob->getEEJacDotqDot();
+    dampedPinvTimes(rob->getEEJacobian(), x, lam, _dqdd.data);
     _dqd.data += _dqdd.data*int_t;
     _dq.data += _dqd.data*int_t;
 }
@@ -64,19 +77,27 @@ Eigen::VectorXd KDLController::idCntr(KDL::Frame &_desPos,
                                       double _Kpp,
                                       double _Kdp, KDLRobot &_robot, double lam)
 {   
+    Eigen::VectorXd tau(_robot.getNrJnts());
+    idCntr(_desPos, _desVel, _desAcc, _Kpp, _Kdp, _robot, lam, tau);
+    return tau;
+}
+
+void KDLController::idCntr(const KDL::Frame &_desPos,
+                           const KDL::Twist &_desVel,
+                           const KDL::Twist &_desAcc,
+                           double _Kpp, double _Kdp,
+                           KDLRobot &_robot, double lam, Eigen::VectorXd &_tau)
+{
     KDLRobot* rob = &_robot;
     
     // calculate errors
     Vector6d err, derr;
     computeErrors(_desPos, rob->getEEFrame(), _desVel, rob->getEEVelocity(), err, derr);
-    KDL::Twist dxdd = _desAcc;
     
-    // calculate damped pseudoinverse
-    Eigen::MatrixXd Jdamp = this->computeDampedPseudoInverse(rob->getEEJacobian().data, lam);
+    // calculate y with the damped pseudoinverse and then tau
+    Vector6d x = toEigen(_desAcc) + _Kdp*derr + _Kpp*err - rob->getEEJacDotqDot();
+    dampedPinvTimes(rob->getEEJacobian(), x, lam, y_);
     
-    // calculate y and then tau
-    Eigen::VectorXd y = Jdamp * (toEigen(dxdd) + _Kdp*derr + _Kpp*err - rob->getEEJacDotqDot());
-    
-    return rob->getJsim() * y + rob->getCoriolis() + rob->getGravity();
+    _tau.noalias() = rob->getJsim() * y_;
+    _tau += rob->getCoriolis() + rob->getGravity();
 }
-
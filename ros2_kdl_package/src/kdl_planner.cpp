@@ -1,4 +1,33 @@
 #include "kdl_planner.h"
+#include <functional>
+
+namespace {
+  // KDL::Trajectory view of a closed form KDLPlanner trajectory, translation only
+  class PlannerTrajectory : public KDL::Trajectory
+  {
+  public:
+    PlannerTrajectory(std::function<trajectory_point(double)> f, double duration):
+      f_(f), duration_(duration) {}
+    double Duration() const override { return duration_; }
+    KDL::Frame Pos(double time) const override {
+      const trajectory_point tp = f_(time);
+      return KDL::Frame(KDL::Vector(tp.pos.x(), tp.pos.y(), tp.pos.z()));
+    }
+    KDL::Twist Vel(double time) const override {
+      const trajectory_point tp = f_(time);
+      return KDL::Twist(KDL::Vector(tp.vel.x(), tp.vel.y(), tp.vel.z()), KDL::Vector::Zero());
+    }
+    KDL::Twist Acc(double time) const override {
+      const trajectory_point tp = f_(time);
+      return KDL::Twist(KDL::Vector(tp.acc.x(), tp.acc.y(), tp.acc.z()), KDL::Vector::Zero());
+    }
+    KDL::Trajectory* Clone() const override { return new PlannerTrajectory(f_, duration_); }
+    void Write(std::ostream& os) const override { os << "PLANNER[ " << duration_ << " ]"; }
+  private:
+    std::function<trajectory_point(double)> f_;
+    double duration_;
+  };
+}
 
 
 KDLPlanner::KDLPlanner(){}
@@ -190,3 +219,29 @@ trajectory_point KDLPlanner::compute_trajectory_linear(double time, double time_
     
     return traj;
 }
+
+KDL::Trajectory_Baked::ErrorReport KDLPlanner::bake_trajectory_linear(double period, double time_c){
+    PlannerTrajectory traj([this, time_c](double time){ return compute_trajectory_linear(time, time_c); }, trajDuration_);
+    baked_ = std::make_shared<KDL::Trajectory_Baked>(traj, period);
+    return baked_->Compare(traj);
+}
+
+KDL::Trajectory_Baked::ErrorReport KDLPlanner::bake_trajectory_circle(double period, double time_c){
+    PlannerTrajectory traj([this, time_c](double time){ return compute_trajectory_circle(time, time_c); }, trajDuration_);
+    baked_ = std::make_shared<KDL::Trajectory_Baked>(traj, period);
+    return baked_->Compare(traj);
+}
+
+trajectory_point KDLPlanner::compute_trajectory_baked(double time) const{
+    trajectory_point traj;
+    if(!baked_){
+        return traj;
+    }
+    const KDL::Vector pos = baked_->Pos(time).p;
+    const KDL::Twist vel = baked_->Vel(time);
+    const KDL::Twist acc = baked_->Acc(time);
+    traj.pos << pos.x(), pos.y(), pos.z();
+    traj.vel << vel.vel.x(), vel.vel.y(), vel.vel.z();
+    traj.acc << acc.vel.x(), acc.vel.y(), acc.vel.z();
+    return traj;
+}
@@ -1,88 +1,134 @@
 #include "kdl_robot.h"
 
-KDLRobot::KDLRobot(){}
+KDLRobot::KDLRobot() : ikSol_(NULL), ikSrsSol_(NULL), ikCache_(NULL), valid_(0)
+{
+    resetEvaluationCounters();
+}
 
-KDLRobot::KDLRobot(KDL::Tree &robot_tree)
+KDLRobot::KDLRobot(KDL::Tree &robot_tree) : ikSol_(NULL), ikSrsSol_(NULL), ikCache_(NULL), valid_(0)
 {
+    resetEvaluationCounters();
     createChain(robot_tree);
     n_ = chain_.getNrOfJoints();
     grav_ = KDL::JntArray(n_);
+    s_J_f_ = KDL::Jacobian(n_);
     s_J_ee_ = KDL::Jacobian(n_);
     b_J_ee_ = KDL::Jacobian(n_);
-    s_J_dot_ee_ = KDL::Jacobian(n_);
-    b_J_dot_ee_ = KDL::Jacobian(n_);
     s_J_ee_.data.setZero();
     b_J_ee_.data.setZero();
-    s_J_dot_ee_.data.setZero();
-    b_J_dot_ee_.data.setZero();
     jntArray_ = KDL::JntArray(n_);
     jntVel_ = KDL::JntArray(n_);
+    jntArrayVel_ = KDL::JntArrayVel(n_);
     coriol_ = KDL::JntArray(n_);
+    coriolMat_.resize(n_,n_);
     dynParam_ = new KDL::ChainDynParam(chain_,KDL::Vector(0,0,-9.81));
     jacSol_ = new KDL::ChainJntToJacSolver(chain_);
     jntJacDotSol_ = new KDL::ChainJntToJacDotSolver(chain_);
     fkSol_ = new KDL::ChainFkSolverPos_recursive(chain_);
     fkVelSol_ = new KDL::ChainFkSolverVel_recursive(chain_);
     idSolver_ = new KDL::ChainIdSolver_RNE(chain_,KDL::Vector(0,0,-9.81));
+    ikCache_ = new KDL::ChainIkSeedCache(n_); // 5 cm voxels, seeds within 10 cm (1 rad = 10 cm)
     jsim_.resize(n_);
     grav_.resize(n_);
     q_min_.data.resize(n_);
     q_max_.data.resize(n_);
     // q_min_.data << -2.96,-2.09,-2.96,-2.09,-2.96,-2.09,-2.96; //-2*M_PI,-2*M_PI; // TODO: read from file
     // q_max_.data <<  2.96,2.09,2.96,2.09,2.96,2.09,2.96; //2*M_PI, 2*M_PI; // TODO: read from file          
-  
-    ikVelSol_ = new KDL::ChainIkSolverVel_pinv(chain_); //Inverse velocity solver 
 }
 
 void KDLRobot::getInverseKinematics(KDL::Frame &f, KDL::JntArray &q){
+    // closed form with an arm angle sweep on SRS arms (e.g. the iiwa), bounded time
+    if(ikSrsSol_->isSRS() && ikSrsSol_->CartToJnt(jntArray_,f,q) == 0) {ikCache_->insert(f,q); return;};
+    // the solution of the nearest pose solved before is tried right after the current joints
+    KDL::JntArray q_seed(n_);
+    ikSol_->clearSeeds();
+    if(ikCache_->nearest(f,q_seed)) {ikSol_->addSeed(q_seed);};
     int ret = ikSol_->CartToJnt(jntArray_,f,q);
-    if(ret != 0) {std::cout << ikSol_->strError(ret) << std::endl;};
+    if(ret != 0) {std::cout << ikSol_->strError(ret) << std::endl; return;};
+    ikCache_->insert(f,q);
+}
+
+KDL::ChainIkSeedCache &KDLRobot::getIkSeedCache()
+{
+    return *ikCache_;
 }
 
 void KDLRobot::setJntLimits(KDL::JntArray &q_low, KDL::JntArray &q_high)
 {
     q_min_ = q_low; q_max_ = q_high;
-    ikSol_ = new KDL::ChainIkSolverPos_NR_JL(chain_,
-                                            *fkSol_,
-                                            *ikVelSol_,
-                                            100,1e-6);//Maximum 100 iterations, stop at accuracy 1e-6
-    ikSol_->setJointLimits(q_min_,q_max_);
+    delete ikSol_;
+    // NR_JL from the current joints, the last solution and 32 random seeds on all cores,
+    // maximum 100 iterations per seed, stop at accuracy 1e-6
+    ikSol_ = new KDL::ChainIkSolverPos_MultiStart(chain_, q_min_, q_max_,
+                                                  KDL::ChainIkSolverPos_MultiStart::NR_JL,
+                                                  0, 32, 100, 1e-6);
+    ikSol_->setTimeBudget(0.005);   // give up after 5 ms
+    delete ikSrsSol_;
+    ikSrsSol_ = new KDL::ChainIkSolverPos_SRS(chain_, q_min_, q_max_); // 36 arm angles
 }
 
-void KDLRobot::update(std::vector<double> _jnt_values, std::vector<double> _jnt_vel)
+void KDLRobot::update(const std::vector<double> &_jnt_values, const std::vector<double> &_jnt_vel)
 {
-    int err;
+    update(_jnt_values.data(), _jnt_vel.data());
+}
+
+void KDLRobot::update(const double *_jnt_values, const double *_jnt_vel)
+{
+    // the terms are computed on first access, see evaluate()
     updateJnts(_jnt_values, _jnt_vel);
+    valid_ = 0;
+}
 
-    KDL::Twist s_T_f;
-    KDL::Frame s_F_f;
-    KDL::Jacobian s_J_f(7);
-    KDL::Jacobian s_J_dot_f(7);
+bool KDLRobot::evaluate(Term term)
+{
+    // true if term has to be computed now
+    if(valid_ & (1u << term)) {return false;};
+    valid_ |= (1u << term);
+    evaluations_[term]++;
+    return true;
+}
+
+void KDLRobot::updateDynamics()
+{
+    // mass matrix, Coriolis and gravity in one fused pass, gravity alone is a single RNE pass
+    if(!evaluate(JSIM)) {return;};
+    int err = dynParam_->JntToDynamics(jntArray_, jntVel_, jsim_, coriol_, grav_); if(err != 0) {std::cout << strError(err);};
+    evaluate(CORIOLIS);
+    evaluate(GRAVITY);
+}
+
+void KDLRobot::updateFrame()
+{
+    if(!evaluate(FRAME)) {return;};
+    int err = fkSol_->JntToCart(jntArray_, s_F_f_); if(err != 0) {std::cout << strError(err);};
+    s_F_ee_ = s_F_f_*f_F_ee_;
+}
+
+void KDLRobot::updateVelocity()
+{
+    if(!evaluate(VELOCITY)) {return;};
+    updateFrame();
     KDL::FrameVel s_Fv_f;
-    KDL::JntArrayVel jntVel(jntArray_,jntVel_);
-    KDL::Twist s_J_dot_q_dot_f;
+    int err = fkVelSol_->JntToCart(jntArrayVel_, s_Fv_f); if(err != 0) {std::cout << strError(err);};
+    s_V_ee_ = s_Fv_f.GetTwist().RefPoint(s_F_ee_.p - s_F_f_.p);
+}
 
-    // joints space
-    err = dynParam_->JntToMass(jntArray_, jsim_); if(err != 0) {std::cout << strError(err);};
-    err = dynParam_->JntToCoriolis(jntArray_, jntVel_, coriol_); if(err != 0) {std::cout << strError(err);};
-    err = dynParam_->JntToGravity(jntArray_, grav_); if(err != 0) {std::cout << strError(err);};
+void KDLRobot::updateJacobian()
+{
+    if(!evaluate(JACOBIAN)) {return;};
+    updateFrame();
+    int err = jacSol_->JntToJac(jntArray_, s_J_f_); if(err != 0) {std::cout << strError(err);};
+    KDL::changeRefPoint(s_J_f_, s_F_ee_.p - s_F_f_.p, s_J_ee_);
+}
 
-    // robot flange
-    err = fkVelSol_->JntToCart(jntVel, s_Fv_f); if(err != 0) {std::cout << strError(err);};
-    s_T_f = s_Fv_f.GetTwist();
-    s_F_f = s_Fv_f.GetFrame();
-    err = jacSol_->JntToJac(jntArray_, s_J_f); if(err != 0) {std::cout << strError(err);};
-    err = jntJacDotSol_->JntToJacDot(jntVel, s_J_dot_q_dot_f); if(err != 0) {std::cout << strError(err);};
-    err = jntJacDotSol_->JntToJacDot(jntVel, s_J_dot_f); if(err != 0) {std::cout << strError(err);};
+unsigned long KDLRobot::getNrOfEvaluations(Term term) const
+{
+    return evaluations_[term];
+}
 
-    // robot end-effector
-    s_F_ee_ = s_F_f*f_F_ee_;
-    KDL::Vector s_p_f_ee = s_F_ee_.p - s_F_f.p;
-    KDL::changeRefPoint(s_J_f, s_p_f_ee, s_J_ee_);
-    KDL::changeRefPoint(s_J_dot_f, s_p_f_ee, s_J_dot_ee_);
-    KDL::changeBase(s_J_ee_, s_F_ee_.M.Inverse(), b_J_ee_);
-    KDL::changeBase(s_J_dot_ee_, s_F_ee_.M.Inverse(), b_J_dot_ee_);
-    s_V_ee_ = s_T_f.RefPoint(s_p_f_ee);
+void KDLRobot::resetEvaluationCounters()
+{
+    for (unsigned int i = 0; i < NR_OF_TERMS; i++) {evaluations_[i] = 0;};
 }
 
 
@@ -118,20 +164,20 @@ unsigned int KDLRobot::getNrSgmts()
 //                                 JOINTS                                     //
 ////////////////////////////////////////////////////////////////////////////////
 
-void KDLRobot::updateJnts(std::vector<double> _jnt_pos, std::vector<double> _jnt_vel)
+void KDLRobot::updateJnts(const double *_jnt_pos, const double *_jnt_vel)
 {
     for (unsigned int i = 0; i < n_; i++)
     {
-        jntArray_(i) = _jnt_pos[i];
-        jntVel_(i) = _jnt_vel[i];
+        jntArray_(i) = jntArrayVel_.q(i) = _jnt_pos[i];
+        jntVel_(i) = jntArrayVel_.qdot(i) = _jnt_vel[i];
     }
 }
-Eigen::VectorXd KDLRobot::getJntValues()
+const Eigen::VectorXd &KDLRobot::getJntValues()
 {
     return jntArray_.data;
 }
 
-Eigen::VectorXd KDLRobot::getJntVelocities()
+const Eigen::VectorXd &KDLRobot::getJntVelocities()
 {
     return jntVel_.data;
 }
@@ -147,18 +193,32 @@ Eigen::MatrixXd KDLRobot::getJntLimits()
     return jntLim;
 }
 
-Eigen::MatrixXd KDLRobot::getJsim()
+const Eigen::MatrixXd &KDLRobot::getJsim()
 {
+    updateDynamics();
     return jsim_.data;
 }
 
-Eigen::VectorXd KDLRobot::getCoriolis()
+const Eigen::VectorXd &KDLRobot::getCoriolis()
 {
+    updateDynamics();
     return coriol_.data;
 }
 
-Eigen::VectorXd KDLRobot::getGravity()
+const Eigen::MatrixXd &KDLRobot::getCoriolisMatrix()
+{
+    // C(q,dq) with C*dq = getCoriolis() and dH/dt - 2*C skew-symmetric
+    if(evaluate(CORIOLIS_MATRIX)) {
+        int err = dynParam_->JntToCoriolisMatrix(jntArray_, jntVel_, coriolMat_); if(err != 0) {std::cout << strError(err);};
+    };
+    return coriolMat_;
+}
+
+const Eigen::VectorXd &KDLRobot::getGravity()
 {
+    if(evaluate(GRAVITY)) {
+        int err = dynParam_->JntToGravity(jntArray_, grav_); if(err != 0) {std::cout << strError(err);};
+    };
     return grav_.data;
 }
 
@@ -181,28 +241,32 @@ Eigen::VectorXd KDLRobot::getID(const KDL::JntArray &q,
 //                              END-EFFECTOR                                  //
 ////////////////////////////////////////////////////////////////////////////////
 
-KDL::Frame KDLRobot::getEEFrame()
+const KDL::Frame &KDLRobot::getEEFrame()
 {
+    updateFrame();
     return s_F_ee_;
 }
 
 
-KDL::Twist KDLRobot::getEEVelocity()
+const KDL::Twist &KDLRobot::getEEVelocity()
 {
+    updateVelocity();
     return s_V_ee_;
 }
 
-KDL::Twist KDLRobot::getEEBodyVelocity()
+const KDL::Twist &KDLRobot::getEEBodyVelocity()
 {
+    updateVelocity();
     return s_V_ee_;
 }
 
-KDL::Jacobian KDLRobot::getEEJacobian()
+const KDL::Jacobian &KDLRobot::getEEJacobian()
 {
+    updateJacobian();
     return s_J_ee_;
 }
 
-KDL::Jacobian KDLRobot::getEEBodyJacobian()
+const KDL::Jacobian &KDLRobot::getEEBodyJacobian()
 {
     //    KDL::Frame ee_F_s = this->getEEPose().Inverse();
     //    KDL::Vector pkdl = ee_F_s.p;
@@ -211,18 +275,28 @@ KDL::Jacobian KDLRobot::getEEBodyJacobian()
     //    s_J_ee_.changeRefFrame(ee_F_s);
     //    std::cout << s_J_ee_.data << std::endl;
     //    return adjoint(toEigen(pkdl),toEigen(M))*s_J_ee_.data;
+    if(evaluate(BODY_JACOBIAN)) {
+        updateJacobian();
+        KDL::changeBase(s_J_ee_, s_F_ee_.M.Inverse(), b_J_ee_);
+    };
     return b_J_ee_;
 }
 
-Eigen::VectorXd KDLRobot::getEEJacDotqDot()
+Vector6d KDLRobot::getEEJacDotqDot()
 {
-    return s_J_dot_ee_.data*jntVel_.data;
+    // Jdot*qdot directly, the full Jdot is never needed
+    if(evaluate(JAC_DOT_Q_DOT)) {
+        updateFrame();
+        int err = jntJacDotSol_->JntToJacDot(jntArrayVel_, s_J_dot_q_dot_ee_); if(err != 0) {std::cout << strError(err);};
+        s_J_dot_q_dot_ee_ = s_J_dot_q_dot_ee_.RefPoint(s_F_ee_.p - s_F_f_.p);
+    };
+    return toEigen(s_J_dot_q_dot_ee_);
 }
 
 void KDLRobot::addEE(const KDL::Frame &_f_F_ee)
 {
     f_F_ee_ = _f_F_ee;
-    this->update(toStdVector(this->jntArray_.data), toStdVector(this->jntVel_.data));
+    valid_ = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -107,10 +107,10 @@ class Iiwa_pub_sub : public rclcpp::Node
             }
 
             // Update KDLrobot object
-            robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+            robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
             KDL::Frame f_T_ee = KDL::Frame::Identity();
             robot_->addEE(f_T_ee);
-            robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+            robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
 
             // Compute EE frame
             init_cart_pose_ = robot_->getEEFrame();
@@ -287,7 +287,7 @@ class Iiwa_pub_sub : public rclcpp::Node
                 }   
 
                 // Update KDLrobot structure
-                robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+                robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
 
                 if(cmd_interface_ == "position"){
                     // Send joint position commands
@@ -322,7 +322,7 @@ class Iiwa_pub_sub : public rclcpp::Node
                 }} else if(cmd_interface_ == "effort"){
                     
                     // Ending pose reference
-                    robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+                    robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
                     dvel.data = Eigen::VectorXd::Zero(7);
                     dacc.data = Eigen::VectorXd::Zero(7);
                     
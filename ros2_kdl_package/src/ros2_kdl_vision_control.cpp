@@ -133,10 +133,10 @@ class Iiwa_pub_sub : public rclcpp::Node
             }
 
             // Update KDLrobot object
-            robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+            robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
             KDL::Frame f_T_ee = KDL::Frame::Identity();
             robot_->addEE(f_T_ee);
-            robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+            robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
 
             // Compute EE frame
             init_cart_pose_ = robot_->getEEFrame();
@@ -166,6 +166,10 @@ class Iiwa_pub_sub : public rclcpp::Node
             KDL::Frame inverse_rotation_frame(KDL::Rotation::RotX(-3.14), KDL::Vector::Zero());
             KDL::Frame inverse_translation_frame(KDL::Rotation::Identity(), KDL::Vector(0.0, 0.0, -positioning_offset));
             aruco_frame = init_cart_pose_ * inverse_rotation_frame2 * inverse_rotation_frame * inverse_translation_frame;
+
+            // Vision Task: the desired frame follows the aruco with a jerk-limited motion, replanned every cycle
+            desired_otg_ = std::make_shared<KDL::Trajectory_JerkLimited>(init_cart_pose_, otg_max_vel, otg_max_acc, otg_max_jerk,
+                                                                         otg_max_rot_vel, otg_max_rot_acc, otg_max_rot_jerk);
     
             // Plan trajectory
             double traj_duration = tj_dur, acc_duration = 0.5, t = 0.0, radius=0.15;
@@ -302,14 +306,20 @@ class Iiwa_pub_sub : public rclcpp::Node
                 KDL::Frame translation_frame(KDL::Rotation::Identity(), KDL::Vector(0.0, 0.0, positioning_offset));
                 KDL::Frame rotation_frame(KDL::Rotation::RotX(3.14), KDL::Vector::Zero());
                 KDL::Frame rotation_frame2(KDL::Rotation::RotZ(3.14), KDL::Vector::Zero());
-                KDL::Frame desired_frame = aruco_frame * translation_frame * rotation_frame * rotation_frame2;
+                KDL::Frame aruco_desired_frame = aruco_frame * translation_frame * rotation_frame * rotation_frame2;
+                
+                // Move towards it without jumps when the aruco moves: advance the motion by one cycle and retarget it
+                desired_otg_->Replan(dt, aruco_desired_frame);
+                KDL::Frame desired_frame = desired_otg_->Pos(0.0);
+                KDL::Twist desired_vel = desired_otg_->Vel(0.0);
+                KDL::Twist desired_acc = desired_otg_->Acc(0.0);
                 
                 // Regulation on the desired frame
                 if(cmd_interface_ == "velocity"){
                     Eigen::Vector3d error = computeLinearError(Eigen::Vector3d(desired_frame.p.data), Eigen::Vector3d(cartpos.p.data));
                     Eigen::Vector3d o_error = computeOrientationError(toEigen(desired_frame.M), toEigen(cartpos.M));
                     
-                    Vector6d cartvel; cartvel << 5*error, 3*o_error;
+                    Vector6d cartvel; cartvel << toEigen(desired_vel.vel) + 5*error, toEigen(desired_vel.rot) + 3*o_error;
                     joint_velocities_.data = pseudoinverse(robot_->getEEJacobian().data)*cartvel;
                     joint_positions_.data = joint_positions_.data + joint_velocities_.data*dt;
                     
@@ -325,8 +335,8 @@ class Iiwa_pub_sub : public rclcpp::Node
                     }else if(cont_type_ == "op"){
                         
                         KDL::Frame d_pos = desired_frame;
-                        KDL::Twist d_vel = toKDLTwist(Eigen::VectorXd::Zero(6));
-                        KDL::Twist d_acc = toKDLTwist(Eigen::VectorXd::Zero(6));
+                        KDL::Twist d_vel = desired_vel;
+                        KDL::Twist d_acc = desired_acc;
                         joint_efforts_.data = controller_->idCntr(d_pos, d_vel, d_acc, KP_o, KD_o, *robot_, lambda_op) - robot_->getGravity();
                     }
                 }
@@ -570,7 +580,7 @@ class Iiwa_pub_sub : public rclcpp::Node
             }
             
             // Update KDLrobot structure
-            robot_->update(toStdVector(joint_positions_.data),toStdVector(joint_velocities_.data));
+            robot_->update(joint_positions_.data.data(), joint_velocities_.data.data());
             if(cmd_interface_ == "velocity"){
                 // Send joint velocity commands
                 for (long int i = 0; i < joint_velocities_.data.size(); ++i) {
@@ -641,6 +651,9 @@ class Iiwa_pub_sub : public rclcpp::Node
         unsigned int freq_ms = 10;
         
         KDL::Frame aruco_frame;
+        std::shared_ptr<KDL::Trajectory_JerkLimited> desired_otg_;
+        double otg_max_vel = 0.2, otg_max_acc = 0.5, otg_max_jerk = 5.0;
+        double otg_max_rot_vel = 0.5, otg_max_rot_acc = 1.0, otg_max_rot_jerk = 10.0;
         KDL::Frame camera_frame;
         std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
         std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <kdl/tree.hpp>
+
+#include "kdl_control.h"
+#include "kdl_robot.h"
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+// count the heap allocations of the calling code, volatile since the
+// compiler assumes malloc does not read user globals
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+static volatile bool malloc_counting = false;
+static volatile unsigned long malloc_count = 0;
+extern "C" void* malloc(size_t size)
+{
+    if (malloc_counting)
+        malloc_count = malloc_count + 1;
+    return __libc_malloc(size);
+}
+extern "C" void* calloc(size_t n, size_t size)
+{
+    if (malloc_counting)
+        malloc_count = malloc_count + 1;
+    return __libc_calloc(n, size);
+}
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    if (malloc_counting)
+        malloc_count = malloc_count + 1;
+    return __libc_realloc(ptr, size);
+}
+
+// iiwa like arm, KDLRobot takes the chain from the root to the second to
+// last segment by name, link_7
+static KDL::Tree makeTree()
+{
+    const KDL::RigidBodyInertia inertia(2.0, KDL::Vector(0.0, 0.01, 0.1),
+                                        KDL::RotationalInertia(0.02, 0.02, 0.01));
+    const KDL::Joint::JointType types[7] = {KDL::Joint::RotZ, KDL::Joint::RotY, KDL::Joint::RotZ,
+                                            KDL::Joint::RotY, KDL::Joint::RotZ, KDL::Joint::RotY,
+                                            KDL::Joint::RotZ};
+    const double lengths[7] = {0.0, 0.42, 0.0, 0.4, 0.0, 0.0, 0.126};
+    KDL::Tree tree("root");
+    tree.addSegment(KDL::Segment("link_0", KDL::Joint(KDL::Joint::Fixed),
+                                 KDL::Frame(KDL::Vector(0.0, 0.0, 0.36))), "root");
+    std::string parent = "link_0";
+    for (unsigned int i = 0; i < 7; i++)
+    {
+        const std::string name = "link_" + std::to_string(i + 1);
+        tree.addSegment(KDL::Segment(name, KDL::Joint(types[i]),
+                                     KDL::Frame(KDL::Vector(0.0, 0.0, lengths[i])), inertia), parent);
+        parent = name;
+    }
+    return tree;
+}
+
+TEST(RealTimeAllocation, ControlCycle)
+{
+    KDL::Tree tree = makeTree();
+    KDLRobot robot(tree);
+    ASSERT_EQ(7u, robot.getNrJnts());
+    robot.addEE(KDL::Frame(KDL::Vector(0.0, 0.0, 0.05)));
+    KDLController controller(robot);
+
+    const unsigned int n = robot.getNrJnts();
+    double q[7], dq[7];
+    KDL::JntArray qd(n), dqd(n), ddqd(n), q_cmd(n), dq_cmd(n), ddq_cmd(n);
+    Eigen::VectorXd tau_jnt(n), tau_op(n);
+    KDL::Frame F_des(KDL::Rotation::RPY(0.1, 0.2, 0.3), KDL::Vector(0.4, 0.1, 0.6));
+    KDL::Twist V_des(KDL::Vector(0.01, 0.0, -0.02), KDL::Vector(0.0, 0.1, 0.0));
+    KDL::Twist A_des = KDL::Twist::Zero();
+
+    // the first cycle is the warm up, the next ones must not touch the heap
+    for (unsigned int k = 0; k < 11; k++)
+    {
+        for (unsigned int i = 0; i < n; i++)
+        {
+            q[i] = 0.3 * std::sin(0.1 * k + i);
+            dq[i] = 0.2 * std::cos(0.1 * k + i);
+            qd(i) = q[i] + 0.01;
+        }
+
+        malloc_count = 0;
+        malloc_counting = k > 0;
+        robot.update(q, dq);
+        controller.idCntr(qd, dqd, ddqd, 100.0, 20.0, robot, tau_jnt);
+        controller.idCntr(F_des, V_des, A_des, 100.0, 20.0, robot, 0.01, tau_op);
+        controller.CLIK(F_des, V_des, A_des, 10.0, 2.0, q_cmd, dq_cmd, ddq_cmd, 0.001, robot, 0.01);
+        malloc_counting = false;
+        EXPECT_EQ(0ul, (unsigned long)malloc_count) << "cycle " << k;
+    }
+
+    // the cycle computed something
+    EXPECT_GT(tau_jnt.norm(), 0.0);
+    EXPECT_GT(tau_op.norm(), 0.0);
+    EXPECT_GT(ddq_cmd.data.norm(), 0.0);
+}